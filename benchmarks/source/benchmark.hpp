@@ -0,0 +1,203 @@
+#pragma once
+
+#include "memory.hpp"
+
+import std;
+import chroma_gl;
+
+namespace bench
+{
+    struct parameter
+    {
+        std::string                             name;
+        std::variant<gl::uint64_t, std::string> value;
+    };
+    //Nanoseconds per iteration over all repetitions of a benchmark
+    struct statistics
+    {
+        gl::float64_t minimum            = 0.0;
+        gl::float64_t median             = 0.0;
+        gl::float64_t mean               = 0.0;
+        gl::float64_t maximum            = 0.0;
+        gl::float64_t standard_deviation = 0.0;
+    };
+    struct result
+    {
+        std::string                   name;
+        std::vector<bench::parameter> parameters;
+        gl::count_t                   iterations;
+        gl::size_t                    bytes_per_iteration;
+        bench::statistics             submission;
+        bench::statistics             completion;
+        std::vector<gl::float64_t>    submission_samples;
+        std::vector<gl::float64_t>    completion_samples;
+        std::optional<gl::size_t>     peak_memory;
+        std::string                   trace;
+    };
+
+    //Times a function that runs a given number of iterations, every repetition is measured twice:
+    //submission is the CPU time until the function returns, completion includes waiting on the GPU with finish
+    //The iteration count is calibrated once per benchmark so that a repetition runs for at least the minimum time
+    //During the first repetition the growth of resident memory is measured
+    //With the trace layer enabled one more run of a single iteration counts the calls, so the counters are per iteration like the times
+    class runner
+    {
+    public:
+        runner(gl::count_t repetitions, std::chrono::nanoseconds minimum_time, std::string filter)
+            : repetitions_{ repetitions }, minimum_time_{ minimum_time }, filter_{ std::move(filter) }, peak_memory_{}, results_{} {}
+
+        template<typename function_t>
+        void run(std::string name, std::vector<bench::parameter> parameters, gl::size_t bytes_per_iteration, function_t&& function)
+        {
+            auto const id = identify_(name, parameters);
+            if (!filter_.empty() && !id.contains(filter_)) return;
+
+            auto iterations = gl::count_t{ 1u };
+            while (gl::true_)
+            {
+                auto const elapsed = measure_(function, iterations).second;
+                if (elapsed >= minimum_time_ || iterations >= maximum_iterations_) break;
+
+                auto const scale = elapsed.count() == 0 ? 10.0 : std::min(10.0, 1.2 * static_cast<gl::float64_t>(minimum_time_.count()) / static_cast<gl::float64_t>(elapsed.count()));
+                iterations       = std::min(std::max(iterations + 1u, static_cast<gl::count_t>(static_cast<gl::float64_t>(iterations) * scale)), maximum_iterations_);
+            }
+
+            auto submission_samples = std::vector<gl::float64_t>{};
+            auto completion_samples = std::vector<gl::float64_t>{};
+            auto peak_memory        = std::optional<gl::size_t>{};
+            auto trace              = std::string{};
+            for (auto repetition = gl::index_t{ 0u }; repetition < repetitions_; ++repetition)
+            {
+                if (repetition == 0u) peak_memory_.reset();
+                auto const [submission, completion] = measure_(function, iterations);
+                if (repetition == 0u) peak_memory = peak_memory_.measure();
+                submission_samples.emplace_back(static_cast<gl::float64_t>(submission.count()) / static_cast<gl::float64_t>(iterations));
+                completion_samples.emplace_back(static_cast<gl::float64_t>(completion.count()) / static_cast<gl::float64_t>(iterations));
+            }
+            if constexpr (gl::trace::is_enabled)
+            {
+                measure_(function, gl::count_t{ 1u });
+                trace = gl::trace::to_json(gl::trace::last_frame());
+            }
+
+            auto const& result = results_.emplace_back(std::move(name), std::move(parameters), iterations, bytes_per_iteration, summarize_(submission_samples), summarize_(completion_samples), std::move(submission_samples), std::move(completion_samples), peak_memory, std::move(trace));
+            std::println(std::cerr, "{:<64} {:>12.1f} ns submission {:>12.1f} ns completion {:>6.2f}% deviation",
+                id, result.submission.median, result.completion.median, result.completion.mean == 0.0 ? 0.0 : 100.0 * result.completion.standard_deviation / result.completion.mean);
+        }
+
+        //Writes every result as one JSON document, throughput is derived from the median completion time
+        void write(std::ostream& stream) const
+        {
+            auto const write_statistics = [&](bench::statistics const& value)
+                {
+                    std::print(stream, R"({{ "minimum": {:.3f}, "median": {:.3f}, "mean": {:.3f}, "maximum": {:.3f}, "standard_deviation": {:.3f} }})",
+                        value.minimum, value.median, value.mean, value.maximum, value.standard_deviation);
+                };
+            auto const write_samples    = [&](std::vector<gl::float64_t> const& samples)
+                {
+                    std::print(stream, "[");
+                    for (auto index = gl::index_t{ 0u }; index < samples.size(); ++index) std::print(stream, "{}{:.3f}", index == 0u ? "" : ", ", samples[index]);
+                    std::print(stream, "]");
+                };
+
+            std::println(stream, "{{");
+            std::println(stream, R"(  "context": {{ "vendor": "{}", "renderer": "{}", "version": "{}" }},)",
+                escape_(gl::get_string<gl::context_property_e::vendor>()), escape_(gl::get_string<gl::context_property_e::renderer>()), escape_(gl::get_string<gl::context_property_e::version>()));
+            std::println(stream, R"(  "repetitions": {},)"        , repetitions_);
+            std::println(stream, R"(  "minimum_time_ns": {},)"    , minimum_time_.count());
+            std::println(stream, R"(  "benchmarks": [)");
+            for (auto index = gl::index_t{ 0u }; index < results_.size(); ++index)
+            {
+                auto const& result = results_[index];
+                std::print(stream, R"(    {{ "name": "{}", "parameters": {{ )", escape_(result.name));
+                for (auto parameter = gl::index_t{ 0u }; parameter < result.parameters.size(); ++parameter)
+                {
+                    auto const& [name, value] = result.parameters[parameter];
+                    std::print(stream, R"({}"{}": )", parameter == 0u ? "" : ", ", escape_(name));
+                    if   (auto const* number = std::get_if<gl::uint64_t>(&value)) std::print(stream, "{}"    , *number);
+                    else                                                          std::print(stream, R"("{}")", escape_(std::get<std::string>(value)));
+                }
+                std::print(stream, R"( }}, "iterations": {}, "bytes_per_iteration": {}, )", result.iterations, result.bytes_per_iteration);
+                std::print(stream, R"("bytes_per_second": {:.1f}, )", result.completion.median == 0.0 ? 0.0 : static_cast<gl::float64_t>(result.bytes_per_iteration) * 1.0e9 / result.completion.median);
+                std::print(stream, R"("submission_ns": )"        ); write_statistics(result.submission);
+                std::print(stream, R"(, "completion_ns": )"      ); write_statistics(result.completion);
+                std::print(stream, R"(, "submission_samples_ns": )"); write_samples(result.submission_samples);
+                std::print(stream, R"(, "completion_samples_ns": )"); write_samples(result.completion_samples);
+                if (result.peak_memory   ) std::print(stream, R"(, "peak_memory_bytes": {})", *result.peak_memory);
+                if (!result.trace.empty()) std::print(stream, R"(, "trace": {})", result.trace);
+                std::println(stream, " }}{}", index + 1u == results_.size() ? "" : ",");
+            }
+            std::println(stream, "  ]");
+            std::println(stream, "}}");
+        }
+
+    private:
+        static auto constexpr maximum_iterations_ = gl::count_t{ 1u } << 24u;
+
+        template<typename function_t>
+        static auto measure_   (function_t& function, gl::count_t iterations) -> std::pair<std::chrono::nanoseconds, std::chrono::nanoseconds>
+        {
+            gl::finish();
+            if constexpr (gl::trace::is_enabled) gl::trace::advance();
+            auto const start_time      = std::chrono::steady_clock::now();
+            function(iterations);
+            auto const submission_time = std::chrono::steady_clock::now();
+            if constexpr (gl::trace::is_enabled) gl::trace::advance();
+            gl::finish();
+            auto const completion_time = std::chrono::steady_clock::now();
+
+            return { submission_time - start_time, completion_time - start_time };
+        }
+        static auto summarize_ (std::vector<gl::float64_t> samples) -> bench::statistics
+        {
+            if (samples.empty()) return {};
+
+            std::ranges::sort(samples);
+            auto const count    = static_cast<gl::float64_t>(samples.size());
+            auto const mean     = std::ranges::fold_left(samples, 0.0, std::plus{}) / count;
+            auto const variance = std::ranges::fold_left(samples, 0.0, [&](gl::float64_t sum, gl::float64_t sample) { return sum + (sample - mean) * (sample - mean); }) / std::max(count - 1.0, 1.0);
+            auto const middle   = samples.size() / 2u;
+
+            return bench::statistics
+            {
+                .minimum            = samples.front(),
+                .median             = samples.size() % 2u == 0u ? (samples[middle - 1u] + samples[middle]) / 2.0 : samples[middle],
+                .mean               = mean,
+                .maximum            = samples.back(),
+                .standard_deviation = std::sqrt(variance),
+            };
+        }
+        static auto identify_  (std::string_view name, std::vector<bench::parameter> const& parameters) -> std::string
+        {
+            auto id = std::string{ name };
+            for (auto const& [parameter, value] : parameters)
+            {
+                id += std::visit([&](auto const& _) { return std::format("/{}={}", parameter, _); }, value);
+            }
+
+            return id;
+        }
+        static auto escape_    (std::string_view value) -> std::string
+        {
+            auto escaped = std::string{};
+            for (auto const character : value)
+            {
+                switch (character)
+                {
+                    case '"' : escaped += R"(\")"; break;
+                    case '\\': escaped += R"(\\)"; break;
+                    case '\n': escaped += R"(\n)"; break;
+                    default  : if (static_cast<gl::uint8_t>(character) >= 0x20u) escaped += character; break;
+                }
+            }
+
+            return escaped;
+        }
+
+        gl::count_t                 repetitions_;
+        std::chrono::nanoseconds    minimum_time_;
+        std::string                 filter_;
+        bench::peak_memory          peak_memory_;
+        std::vector<bench::result>  results_;
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#if defined(__linux__)
+    #include <EGL/egl.h>
+    #include <EGL/eglext.h>
+#endif
+
+import std;
+import glad;
+import chroma_gl;
+import rgfw;
+
+namespace bench
+{
+    //Offscreen OpenGL context for the benchmarks, there is no default frame buffer so every draw targets a frame buffer object
+    //On Linux this is an EGL context on the surfaceless Mesa platform, which runs on llvmpipe on machines without a GPU
+    //Elsewhere a hidden window provides the context, the trace layer is installed when the library is built with it
+    class context
+    {
+    public:
+#if defined(__linux__)
+        context()
+            : display_{ EGL_NO_DISPLAY }, context_{ EGL_NO_CONTEXT }
+        {
+            display_ = ::eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display_ == EGL_NO_DISPLAY || !::eglInitialize(display_, nullptr, nullptr)) throw std::runtime_error{ "failed to initialize surfaceless egl display" };
+            if (!::eglBindAPI(EGL_OPENGL_API)                                             ) throw std::runtime_error{ "failed to bind the opengl api" };
+
+            auto const config_attributes = std::array<EGLint, 5u>{ EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+            auto       config            = EGLConfig{};
+            auto       config_count      = EGLint{ 0 };
+            if (!::eglChooseConfig(display_, config_attributes.data(), &config, 1, &config_count) || config_count == 0) throw std::runtime_error{ "no egl config supports opengl" };
+
+            //llvmpipe of older Mesa releases stops at 4.5, which covers everything the benchmarks use
+            for (auto const minor_version : { EGLint{ 6 }, EGLint{ 5 } })
+            {
+                auto const context_attributes = std::array<EGLint, 7u>{ EGL_CONTEXT_MAJOR_VERSION, 4, EGL_CONTEXT_MINOR_VERSION, minor_version, EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE };
+                context_                      = ::eglCreateContext(display_, config, EGL_NO_CONTEXT, context_attributes.data());
+                if (context_ != EGL_NO_CONTEXT) break;
+            }
+            if (context_ == EGL_NO_CONTEXT                                                ) throw std::runtime_error{ "failed to create opengl 4.5 core context" };
+            if (!::eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_)     ) throw std::runtime_error{ "failed to make surfaceless context current" };
+            if (!glad::initialize(reinterpret_cast<glad::loader_function_t>(::eglGetProcAddress))) throw std::runtime_error{ "failed to initialize glad" };
+
+            gl::trace::install();
+        }
+       ~context()
+        {
+            ::eglMakeCurrent   (display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            ::eglDestroyContext(display_, context_);
+            ::eglTerminate     (display_);
+        }
+#else
+        context()
+            : window_{ "benchmarks", rgfw::vector_2u{ 1u, 1u }, rgfw::window::flags_e::none, rgfw::window::display_mode_e::windowed, rgfw::false_ }
+        {
+            gl::trace::install();
+        }
+#endif
+
+        context(context const&) = delete;
+        auto operator=(context const&) -> context& = delete;
+
+    private:
+#if defined(__linux__)
+        EGLDisplay   display_;
+        EGLContext   context_;
+#else
+        rgfw::window window_;
+#endif
+    };
+}
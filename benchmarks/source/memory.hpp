@@ -0,0 +1,62 @@
+#pragma once
+
+import std;
+import chroma_gl;
+
+namespace bench
+{
+    //Peak resident memory of the process, read from procfs on Linux where the peak can be reset between measurements
+    //Mapped file pages count as resident once they are touched, so mapped and copied loads are compared on equal terms
+    //Elsewhere the peak cannot be reset, no measurement is reported there
+    class peak_memory
+    {
+    public:
+        peak_memory()
+            : baseline_{} {}
+
+        //Resets the peak to the current resident size, which becomes the baseline of the next measurement
+        auto reset  () -> gl::bool_t
+        {
+            baseline_.reset();
+#if defined(__linux__)
+            auto stream = std::ofstream{ "/proc/self/clear_refs" };
+            if (!(stream << "5" << std::flush)) return gl::false_;
+
+            baseline_ = read_status_("VmRSS:");
+#endif
+            return baseline_.has_value();
+        }
+        //Bytes the resident size grew by at most since the last reset
+        auto measure() const -> std::optional<gl::size_t>
+        {
+            if (!baseline_) return std::nullopt;
+
+            auto const peak = read_status_("VmHWM:");
+            if (!peak) return std::nullopt;
+
+            return *peak > *baseline_ ? *peak - *baseline_ : gl::size_t{ 0u };
+        }
+
+    private:
+        static auto read_status_(std::string_view key) -> std::optional<gl::size_t>
+        {
+            auto stream = std::ifstream{ "/proc/self/status" };
+            auto line   = std::string{};
+            while (std::getline(stream, line))
+            {
+                if (!line.starts_with(key)) continue;
+
+                auto kilobytes = gl::size_t{ 0u };
+                auto value     = std::string_view{ line }.substr(key.size());
+                value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+                if (std::from_chars(value.data(), value.data() + value.size(), kilobytes).ec != std::errc{}) return std::nullopt;
+
+                return kilobytes * 1024u;
+            }
+
+            return std::nullopt;
+        }
+
+        std::optional<gl::size_t> baseline_;
+    };
+}
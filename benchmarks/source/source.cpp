@@ -0,0 +1,82 @@
+#include "context.hpp"
+#include "benchmark.hpp"
+
+import std;
+import chroma_gl;
+
+#include "suites/buffer.hpp"
+#include "suites/draw.hpp"
+#include "suites/fence.hpp"
+#include "suites/image.hpp"
+#include "suites/io.hpp"
+#include "suites/mesh.hpp"
+#include "suites/primitives.hpp"
+#include "suites/texture.hpp"
+#include "suites/transforms.hpp"
+#include "suites/transient_uniforms.hpp"
+#include "suites/vertex_array.hpp"
+
+//Usage: benchmarks [--output <file>] [--repetitions <count>] [--minimum-time <milliseconds>] [--filter <text>] [--backend <driver|null>]
+//Progress is written to stderr and the JSON results to stdout unless an output file is given
+//The null backend replaces the driver after context creation, the suites then measure the CPU cost of the library's functions alone
+//Its downloads return no data, so the primitives suite, which checks its results, only runs against the driver
+auto main(int argc, char* argv[]) -> int
+{
+    auto output       = std::optional<std::filesystem::path>{};
+    auto repetitions  = gl::count_t{ 10u };
+    auto minimum_time = std::chrono::milliseconds{ 20 };
+    auto filter       = std::string{};
+    auto backend      = std::string{ "driver" };
+
+    try
+    {
+        auto const arguments = std::vector<std::string_view>{ argv + 1, argv + argc };
+        for (auto index = gl::index_t{ 0u }; index < arguments.size(); ++index)
+        {
+            auto const argument = arguments[index];
+            if (index + 1u == arguments.size()) throw std::invalid_argument{ std::format("missing value for {}", argument) };
+
+            auto const value    = arguments[++index];
+            if      (argument == "--output"      ) output       = value;
+            else if (argument == "--repetitions" ) repetitions  = std::stoull(std::string{ value });
+            else if (argument == "--minimum-time") minimum_time = std::chrono::milliseconds{ std::stoll(std::string{ value }) };
+            else if (argument == "--filter"      ) filter       = value;
+            else if (argument == "--backend"     ) backend      = value;
+            else throw std::invalid_argument{ std::format("unknown argument {}", argument) };
+        }
+        if (repetitions == 0u) throw std::invalid_argument{ "repetition count has to be at least one" };
+        if (backend != "driver" && backend != "null") throw std::invalid_argument{ std::format("unknown backend {}", backend) };
+
+        auto const context = bench::context{};
+        auto       runner  = bench::runner{ repetitions, minimum_time, filter };
+        if (backend == "null") gl::trace::load_null_backend();
+
+        ::buffer_benchmarks            (runner);
+        ::draw_benchmarks              (runner);
+        ::fence_benchmarks             (runner);
+        ::image_benchmarks             (runner);
+        ::io_benchmarks                (runner);
+        ::mesh_benchmarks              (runner);
+        if (backend != "null") ::primitives_benchmarks(runner);
+        ::texture_benchmarks           (runner);
+        ::transforms_benchmarks        (runner);
+        ::transient_uniforms_benchmarks(runner);
+        ::vertex_array_benchmarks      (runner);
+
+        if (output)
+        {
+            auto stream = std::ofstream{ *output };
+            if (!stream) throw std::runtime_error{ std::format("failed to open {}", output->string()) };
+
+            runner.write(stream);
+        }
+        else runner.write(std::cout);
+    }
+    catch (std::exception const& exception)
+    {
+        std::println(std::cerr, "error: {}", exception.what());
+        return 1;
+    }
+
+    return 0;
+}
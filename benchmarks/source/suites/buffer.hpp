@@ -0,0 +1,42 @@
+#pragma once
+
+import std;
+import chroma_gl;
+
+//Uploads of the same data through each buffer type, persistent uploads rotate through three slots and commit after each one like a frame would
+static inline void buffer_benchmarks(bench::runner& runner)
+{
+    auto const slot_count = gl::count_t{ 3u };
+    for (auto const size : { gl::size_t{ 4u * 1024u }, gl::size_t{ 64u * 1024u }, gl::size_t{ 1024u * 1024u }, gl::size_t{ 16u * 1024u * 1024u } })
+    {
+        auto const memory = std::vector<gl::byte_t>(size, gl::byte_t{ 0x5Au });
+
+        {
+            auto buffer = gl::dynamic_buffer<gl::byte_t, gl::true_, gl::false_>{ size };
+            runner.run("buffer.upload", { { "buffer", "dynamic" }, { "size", size } }, size, [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) buffer.upload(memory);
+                });
+        }
+        {
+            auto buffer = gl::stream_buffer<gl::byte_t>{ size * slot_count };
+            auto slot   = gl::index_t{ 0u };
+            runner.run("buffer.upload", { { "buffer", "persistent" }, { "size", size } }, size, [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+                    {
+                        buffer.upload(memory, slot * size);
+                        buffer.commit();
+                        slot = (slot + 1u) % slot_count;
+                    }
+                });
+        }
+        {
+            auto buffer = gl::partition_buffer<gl::byte_t>{ slot_count, size };
+            runner.run("buffer.upload", { { "buffer", "partition" }, { "size", size } }, size, [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) buffer.upload(memory);
+                });
+        }
+    }
+}
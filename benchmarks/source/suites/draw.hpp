@@ -0,0 +1,79 @@
+#pragma once
+
+import std;
+import chroma_gl;
+
+//Draw call submission rates into a small frame buffer object, every iteration is one call so the submission time is the cost of a draw
+static inline void draw_benchmarks(bench::runner& runner)
+{
+    auto const dimensions             = gl::vector_2u{ 64u, 64u };
+    auto const color_specification    = gl::frame_buffer_specification<>{ "color", gl::frame_buffer_surface_e::render_buffer, gl::render_buffer_format_e::rgba_uint8_n };
+    auto       frame_buffer           = gl::frame_buffer{ gl::frame_buffer_attachment_map_t{ { gl::frame_buffer_attachment_e::color_0, color_specification } }, dimensions };
+
+    auto const vertex_source          = std::string{ R"(
+#version 450 core
+layout(location = 0) in vec3 a_Position;
+void main()
+{
+    gl_Position = vec4(a_Position * 0.01, 1.0);
+}
+)" };
+    auto const fragment_source        = std::string{ R"(
+#version 450 core
+layout(location = 0) out vec4 f_Color;
+void main()
+{
+    f_Color = vec4(1.0);
+}
+)" };
+    auto       pipeline               = gl::pipeline{};
+    pipeline.link(std::make_shared<gl::shader>(gl::shader::type_e::vertex  , vertex_source  ));
+    pipeline.link(std::make_shared<gl::shader>(gl::shader::type_e::fragment, fragment_source));
+
+    //The indirect buffer holds one command per draw of the multi draw, all of them draw the same triangle
+    auto const draw_count             = gl::count_t{ 1024u };
+    auto const vertex_data            = std::vector<gl::vector_3f>{ gl::vertex::triangle::positions.begin(), gl::vertex::triangle::positions.end() };
+    auto const index_data             = std::vector<gl::uint32_t> { gl::vertex::triangle::indices  .begin(), gl::vertex::triangle::indices  .end() };
+    auto const command_data           = std::vector<gl::draw_elements_indirect_command>(draw_count, gl::draw_elements_indirect_command{ .count = 3u, .instance_count = 1u });
+    auto       vertex_array           = gl::vertex_array{};
+    auto       vertex_buffer          = gl::vertex_buffer<gl::vector_3f>{ vertex_data };
+    auto       index_buffer           = gl::index_buffer                { index_data  };
+    auto       indirect_buffer        = gl::draw_indirect_buffer        { draw_count  };
+    vertex_array.attach<gl::separate_layout<gl::vertex_attribute<gl::vector_3f>>>(vertex_buffer);
+    vertex_array.attach                                                          (index_buffer );
+    indirect_buffer.upload(command_data);
+    indirect_buffer.commit();
+
+    gl::viewport(dimensions);
+    frame_buffer.bind(gl::frame_buffer::target_e::read_write);
+    pipeline    .bind();
+    vertex_array.bind();
+    indirect_buffer.bind();
+
+    runner.run("draw.submit", { { "call", "draw_arrays" } }, 0u, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) gl::draw_arrays(gl::draw_mode_e::triangles, gl::index_range{ 0u, 3u });
+        });
+    runner.run("draw.submit", { { "call", "draw_elements" } }, 0u, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) gl::draw_elements(gl::draw_mode_e::triangles, gl::draw_type_e::uint32, 3u, gl::index_t{ 0u });
+        });
+    runner.run("draw.submit", { { "call", "draw_elements_instanced" }, { "instances", 64u } }, 0u, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) gl::draw_elements_instanced(gl::draw_mode_e::triangles, gl::draw_type_e::uint32, 3u, gl::index_t{ 0u }, 64u);
+        });
+    runner.run("draw.submit", { { "call", "multi_draw_elements_indirect" }, { "draws", draw_count } }, 0u, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) gl::multi_draw_elements_indirect(gl::draw_mode_e::triangles, gl::draw_type_e::uint32, draw_count, gl::index_t{ 0u });
+        });
+    //Rebinding the pipeline and vertex array before every draw, which is what a renderer without state sorting submits
+    runner.run("draw.submit", { { "call", "bind_draw_elements" } }, 0u, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+            {
+                pipeline    .bind();
+                vertex_array.bind();
+                gl::draw_elements(gl::draw_mode_e::triangles, gl::draw_type_e::uint32, 3u, gl::index_t{ 0u });
+            }
+        });
+}
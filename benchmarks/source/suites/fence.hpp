@@ -0,0 +1,57 @@
+#pragma once
+
+import std;
+import chroma_gl;
+
+//Cost of placing and waiting on fences, and the range bookkeeping persistent buffers do on every upload
+static inline void fence_benchmarks(bench::runner& runner)
+{
+    runner.run("fence.place", {}, 0u, [](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+            {
+                auto fence = gl::fence{};
+                fence.place();
+            }
+        });
+    runner.run("fence.wait", {}, 0u, [](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+            {
+                auto fence = gl::fence{};
+                fence.place();
+                fence.wait ();
+            }
+        });
+
+    //Every iteration waits on, locks and commits the next of a ring of ranges, so the locker holds up to a ring worth of fences
+    for (auto const range_count : { gl::count_t{ 1u }, gl::count_t{ 3u }, gl::count_t{ 64u } })
+    {
+        auto memory_locker = gl::memory_locker{};
+        auto range_index   = gl::index_t{ 0u };
+        runner.run("memory_locker.cycle", { { "ranges", range_count } }, 0u, [&](gl::count_t iterations)
+            {
+                for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+                {
+                    auto const range = gl::index_range{ range_index * 256u, 256u };
+                    memory_locker.wait  (range);
+                    memory_locker.lock  (range);
+                    memory_locker.commit();
+                    range_index = (range_index + 1u) % range_count;
+                }
+            });
+        runner.run("memory_locker.try_wait", { { "ranges", range_count } }, 0u, [&](gl::count_t iterations)
+            {
+                for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+                {
+                    auto const range = gl::index_range{ range_index * 256u, 256u };
+                    if (memory_locker.try_wait(range))
+                    {
+                        memory_locker.lock  (range);
+                        memory_locker.commit();
+                    }
+                    range_index = (range_index + 1u) % range_count;
+                }
+            });
+    }
+}
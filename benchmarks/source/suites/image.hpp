@@ -0,0 +1,35 @@
+#pragma once
+
+import std;
+import chroma_gl;
+
+//Decoding of an in-memory image, a smooth gradient with noise so the encoders can neither skip nor trivially compress it
+static inline void image_benchmarks(bench::runner& runner)
+{
+    auto const dimensions = gl::vector_2u{ 1024u, 1024u };
+    auto       random     = std::mt19937{ 42u };
+    auto       noise      = std::uniform_int_distribution<gl::uint32_t>{ 0u, 15u };
+    auto       memory     = std::vector<gl::byte_t>(static_cast<gl::size_t>(dimensions.x) * dimensions.y * 4u);
+    for (auto index = gl::size_t{ 0u }; index < memory.size(); ++index)
+    {
+        auto const texel = index / 4u;
+        auto const x     = static_cast<gl::uint32_t>(texel % dimensions.x);
+        auto const y     = static_cast<gl::uint32_t>(texel / dimensions.x);
+        memory[index]    = static_cast<gl::byte_t>(((x + y * (index % 4u + 1u)) / 8u + noise(random)) & 0xFFu);
+    }
+    auto const image      = gl::image{ gl::image::format_e::rgba_uint8, dimensions, std::move(memory) };
+    auto const png        = gl::image::encode<gl::image::extension_e::png>(gl::image::format_e::rgba_uint8, image);
+    auto const jpg        = gl::image::encode<gl::image::extension_e::jpg>(gl::image::format_e::rgba_uint8, image);
+
+    for (auto const& [extension, encoded] : { std::pair{ "png", std::span<gl::byte_t const>{ png } }, std::pair{ "jpg", std::span<gl::byte_t const>{ jpg } } })
+    {
+        runner.run("image.decode", { { "extension", extension }, { "encoded_size", encoded.size() } }, image.data().size(), [&](gl::count_t iterations)
+            {
+                for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+                {
+                    auto const decoded = gl::image::decode(gl::image::format_e::rgba_uint8, encoded);
+                    static_cast<void>(decoded);
+                }
+            });
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+import std;
+import chroma_gl;
+
+//Loads of the same file through each io path, every iteration reads the whole file and sums its bytes so mapped pages are touched too
+//The file stays in the page cache between iterations, so this compares the cost of the paths rather than the storage device
+//The peak memory of a result shows what each path holds resident, a full copy for read, the touched pages for a mapping and a few chunks for the reader
+static inline void io_benchmarks(bench::runner& runner)
+{
+    auto       random = std::mt19937{ 42u };
+    auto const sum    = [](std::span<gl::byte_t const> memory, gl::uint64_t checksum)
+        {
+            return std::ranges::fold_left(memory, checksum, [](gl::uint64_t value, gl::byte_t byte) { return value + static_cast<gl::uint64_t>(byte); });
+        };
+
+    for (auto const size : { gl::size_t{ 1024u * 1024u }, gl::size_t{ 16u * 1024u * 1024u }, gl::size_t{ 128u * 1024u * 1024u } })
+    {
+        auto memory = std::vector<gl::byte_t>(size);
+        std::ranges::generate(memory, [&] { return static_cast<gl::byte_t>(random()); });
+
+        auto const path     = std::filesystem::temp_directory_path() / std::format("chroma-gl-benchmark-{}.bin", size);
+        auto const expected = sum(memory, 0u);
+        gl::io::write(path, memory);
+        memory = {};
+
+        //The sums of every iteration are compared against the file contents, a path that loads the wrong bytes fails the run
+        auto const load     = [&](std::string_view path_name, auto&& function)
+            {
+                runner.run("io.load", { { "path", std::string{ path_name } }, { "size", size } }, size, [&](gl::count_t iterations)
+                    {
+                        for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+                        {
+                            if (function() != expected) throw std::runtime_error{ std::format("io.load through {} does not match the file contents", path_name) };
+                        }
+                    });
+            };
+
+        try
+        {
+            load("read"       , [&]
+                {
+                    return sum(gl::io::read(path), 0u);
+                });
+            load("mapped_file", [&]
+                {
+                    auto const file = gl::io::mapped_file{ path };
+                    return sum(file.data(), 0u);
+                });
+            load("file_reader", [&]
+                {
+                    auto reader   = gl::io::file_reader{ path };
+                    auto checksum = gl::uint64_t{ 0u };
+                    for (auto chunk = reader.next(); !chunk.empty(); chunk = reader.next()) checksum = sum(chunk, checksum);
+
+                    return checksum;
+                });
+        }
+        catch (...)
+        {
+            std::filesystem::remove(path);
+            throw;
+        }
+
+        std::filesystem::remove(path);
+    }
+}
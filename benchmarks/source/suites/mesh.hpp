@@ -0,0 +1,112 @@
+#pragma once
+
+import std;
+import glm;
+import chroma_gl;
+
+//Mesh optimisation of a UV sphere with shuffled triangles, the worst case for the post-transform cache
+//Before timing, the cache and overdraw passes are checked to not raise the ACMR of the input, a regression throws
+//The ACMR and ATVR of every stage are written to stderr with the progress, the timed passes run on a copy of their input
+static inline void mesh_benchmarks(bench::runner& runner)
+{
+    auto       random              = std::mt19937{ 42u };
+    auto const rings               = gl::uint32_t{ 128u };
+    auto const segments            = gl::uint32_t{ 256u };
+    auto       positions           = std::vector<gl::vector_3f>{};
+    for (auto ring = gl::uint32_t{ 0u }; ring <= rings; ++ring)
+    {
+        for (auto segment = gl::uint32_t{ 0u }; segment <= segments; ++segment)
+        {
+            auto const uv     = gl::vector_2f{ static_cast<gl::float32_t>(segment) / segments, static_cast<gl::float32_t>(ring) / rings };
+            auto const theta  = uv.y * std::numbers::pi_v<gl::float32_t>;
+            auto const phi    = uv.x * std::numbers::pi_v<gl::float32_t> * 2.0f;
+            auto const normal = gl::vector_3f{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+
+            positions.emplace_back(normal * 10.0f);
+        }
+    }
+
+    auto       triangles           = std::vector<std::array<gl::uint32_t, 3u>>{};
+    for (auto ring = gl::uint32_t{ 0u }; ring < rings; ++ring)
+    {
+        for (auto segment = gl::uint32_t{ 0u }; segment < segments; ++segment)
+        {
+            auto const first = ring * (segments + 1u) + segment;
+            auto const below = first + segments + 1u;
+            triangles.push_back({ first, below    , first + 1u });
+            triangles.push_back({ first + 1u, below, below + 1u });
+        }
+    }
+    std::ranges::shuffle(triangles, random);
+
+    auto       source              = std::vector<gl::uint32_t>{};
+    std::ranges::for_each(triangles, [&](auto const& triangle) { source.append_range(triangle); });
+
+    //Only the positions are generated, the layouts give the vertex sizes of a full vertex with normals, coordinates and tangents
+    using      source_layout       = gl::interleaved_layout<gl::vertex_attribute<gl::vector_3f>, gl::vertex_attribute<gl::vector_3f>, gl::vertex_attribute<gl::vector_2f>, gl::vertex_attribute<gl::vector_4f>>;
+    using      quantized_layout    = gl::mesh::quantized_layout<gl::mesh::half_position, gl::mesh::octahedral_normal, gl::mesh::half_coordinate, gl::mesh::packed_tangent>;
+
+    auto const vertex_count        = positions.size();
+    auto const triangle_count      = gl::count_t{ triangles.size() };
+    auto const index_bytes         = source.size() * sizeof(gl::uint32_t);
+    auto const report              = [](std::string_view name, gl::mesh::statistics const& statistics)
+        {
+            std::println(std::cerr, "mesh.{:<15} acmr {:>5.3f} atvr {:>5.3f} vertices {:>9} bytes indices {:>9} bytes", name, statistics.acmr, statistics.atvr, statistics.vertex_bytes, statistics.index_bytes);
+        };
+    auto const check               = [&](std::string_view name, std::span<gl::uint32_t const> indices, gl::mesh::statistics const& input, gl::mesh::statistics const& output)
+        {
+            if (indices.size() != source.size()) throw std::runtime_error{ std::format("mesh.{} does not keep the index count of its input", name) };
+            if (output.acmr > input.acmr       ) throw std::runtime_error{ std::format("mesh.{} raises the acmr from {:.3f} to {:.3f}", name, input.acmr, output.acmr) };
+        };
+
+    auto const source_statistics   = gl::mesh::analyze<source_layout>(source, vertex_count);
+    auto const cache_indices       = gl::mesh::optimize_vertex_cache(source, vertex_count);
+    auto const cache_statistics    = gl::mesh::analyze<source_layout>(cache_indices, vertex_count);
+    auto const overdraw_indices    = gl::mesh::optimize_overdraw(cache_indices, positions);
+    auto const overdraw_statistics = gl::mesh::analyze<source_layout>(overdraw_indices, vertex_count);
+    check ("optimize_vertex_cache", cache_indices   , source_statistics, cache_statistics   );
+    check ("optimize_overdraw"    , overdraw_indices, source_statistics, overdraw_statistics);
+    report("source"               , source_statistics  );
+    report("vertex_cache"         , cache_statistics   );
+    report("overdraw"             , overdraw_statistics);
+
+    //The fetch pass only renumbers the vertices, the triangle order and with it the ACMR stay the same
+    auto       indices             = overdraw_indices;
+    auto const remap               = gl::mesh::optimize_vertex_fetch(indices, vertex_count);
+    auto const fetch_positions     = gl::mesh::remap_vertices<gl::vector_3f>(positions, remap);
+    auto const fetch_statistics    = gl::mesh::analyze<source_layout>(indices, fetch_positions.size());
+    check ("optimize_vertex_fetch", indices, source_statistics, fetch_statistics);
+    report("vertex_fetch"         , fetch_statistics);
+    report("quantized"            , gl::mesh::analyze<quantized_layout>(indices, fetch_positions.size()));
+
+    auto const lod_chain           = gl::mesh::generate_lod_chain(indices, fetch_positions, 5u);
+    for (auto level = gl::size_t{ 0u }; level < lod_chain.size(); ++level)
+    {
+        report(std::format("lod_{}", level), gl::mesh::analyze<quantized_layout>(lod_chain[level], fetch_positions.size()));
+    }
+
+    runner.run("mesh.analyze"              , { { "triangles", triangle_count } }, index_bytes, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) gl::mesh::analyze<source_layout>(source, vertex_count);
+        });
+    runner.run("mesh.optimize_vertex_cache", { { "triangles", triangle_count } }, index_bytes, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) gl::mesh::optimize_vertex_cache(source, vertex_count);
+        });
+    runner.run("mesh.optimize_overdraw"    , { { "triangles", triangle_count } }, index_bytes, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) gl::mesh::optimize_overdraw(cache_indices, positions);
+        });
+    runner.run("mesh.optimize_vertex_fetch", { { "triangles", triangle_count } }, index_bytes, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+            {
+                auto copy = overdraw_indices;
+                gl::mesh::optimize_vertex_fetch(copy, vertex_count);
+            }
+        });
+    runner.run("mesh.generate_lod_chain"   , { { "triangles", triangle_count }, { "levels", gl::count_t{ 5u } } }, index_bytes, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) gl::mesh::generate_lod_chain(indices, fetch_positions, 5u);
+        });
+}
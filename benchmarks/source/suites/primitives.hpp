@@ -0,0 +1,202 @@
+#pragma once
+
+import std;
+import chroma_gl;
+
+//Counts above this are only timed, reading them back and running the CPU reference would take longer than the benchmarks themselves
+static auto constexpr primitives_check_limit = gl::count_t{ 1u } << 22u;
+
+static inline void primitives_check(std::string_view name, gl::count_t count, auto const& expected, auto const& actual)
+{
+    if (!std::ranges::equal(expected, actual)) throw std::runtime_error{ std::format("primitives.{} with {} elements does not match the reference", name, count) };
+}
+static inline void primitives_read (auto& buffer, auto& data)
+{
+    buffer.commit  ();
+    buffer.download(data);
+}
+
+//Scans and reductions of one element type, float inputs are small integers so every partial sum of a checked count is exact in any order
+//Signed inputs are centered on zero, so no partial sum of a checked count overflows
+template<typename element_t>
+static inline void primitives_typed_benchmarks(bench::runner& runner, gl::compute::primitives& primitives, std::mt19937& random, gl::count_t count, std::string_view type)
+{
+    auto const size       = static_cast<gl::size_t>(count) * sizeof(element_t);
+    auto const is_checked = count <= primitives_check_limit;
+    auto       input_data = std::vector<element_t>(count);
+    std::ranges::generate(input_data, [&]
+        {
+                 if constexpr (std::is_same_v<element_t, gl::uint32_t >) return static_cast<element_t>(random() % 1024u);
+            else if constexpr (std::is_same_v<element_t, gl::int32_t  >) return static_cast<element_t>(random() % 1024u) - 512;
+            else if constexpr (std::is_same_v<element_t, gl::float32_t>) return static_cast<element_t>(random() % 4u   );
+        });
+
+    auto       input      = gl::shader_storage_buffer<element_t>{ count };
+    auto       output     = gl::shader_storage_buffer<element_t>{ count };
+    auto       result     = gl::shader_storage_buffer<element_t>{ 1u    };
+    input.upload(input_data);
+
+    auto const scan       = [&](std::string_view name, auto&& function, auto&& reference)
+        {
+            function();
+            if (is_checked)
+            {
+                auto output_data = std::vector<element_t>(count);
+                primitives_read (output, output_data);
+                primitives_check(std::format("{} {}", name, type), count, reference(std::span<element_t const>{ input_data }), output_data);
+            }
+
+            runner.run(std::format("primitives.{}", name), { { "count", count }, { "type", std::string{ type } } }, size, [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) function();
+                });
+        };
+    scan("exclusive_scan", [&] { primitives.exclusive_scan(input, output); }, gl::compute::reference::exclusive_scan<element_t>);
+    scan("inclusive_scan", [&] { primitives.inclusive_scan(input, output); }, gl::compute::reference::inclusive_scan<element_t>);
+
+    for (auto const [operation, operation_name] : { std::pair{ gl::compute::operation_e::sum, "sum" }, std::pair{ gl::compute::operation_e::minimum, "minimum" }, std::pair{ gl::compute::operation_e::maximum, "maximum" } })
+    {
+        primitives.reduce(input, result, operation);
+        if (is_checked)
+        {
+            auto result_data = std::vector<element_t>(1u);
+            primitives_read (result, result_data);
+            primitives_check(std::format("reduce {} {}", operation_name, type), count, std::vector{ gl::compute::reference::reduce<element_t>(input_data, operation) }, result_data);
+        }
+
+        runner.run("primitives.reduce", { { "count", count }, { "type", std::string{ type } }, { "operation", std::string{ operation_name } } }, size, [&](gl::count_t iterations)
+            {
+                for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) primitives.reduce(input, result, operation);
+            });
+    }
+}
+
+//Throughput of the compute primitives, every primitive is checked against its CPU reference before it is timed
+//A mismatch throws, which fails the whole run instead of reporting the timings of a wrong result
+static inline void primitives_benchmarks(bench::runner& runner)
+{
+    auto       primitives       = gl::compute::primitives{};
+    auto       random           = std::mt19937{ 42u };
+
+    //Consumer of the compacted elements, dispatched indirectly with the work groups the compaction wrote
+    auto const increment_source = std::string{ R"(
+#version 460 core
+layout(local_size_x = 256) in;
+layout(std430, binding = 0) buffer values_block { uint values    []; };
+layout(std430, binding = 1) buffer count_block  { uint kept_count[]; };
+void main()
+{
+    uint index = (gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x) * 256u + gl_LocalInvocationID.x;
+    if (index < kept_count[0]) values[index] += 1u;
+}
+)" };
+    auto       increment        = gl::pipeline{};
+    increment.link(std::make_shared<gl::shader>(gl::shader::type_e::compute, increment_source));
+
+    for (auto const count : { gl::count_t{ 1u } << 10u, gl::count_t{ 1u } << 14u, gl::count_t{ 1u } << 18u, gl::count_t{ 1u } << 22u, gl::count_t{ 1u } << 26u })
+    {
+        primitives_typed_benchmarks<gl::uint32_t >(runner, primitives, random, count, "uint32" );
+        primitives_typed_benchmarks<gl::int32_t  >(runner, primitives, random, count, "int32"  );
+        primitives_typed_benchmarks<gl::float32_t>(runner, primitives, random, count, "float32");
+
+        auto const size        = static_cast<gl::size_t>(count) * sizeof(gl::uint32_t);
+        auto const is_checked  = count <= primitives_check_limit;
+        auto       input_data  = std::vector<gl::uint32_t>(count);
+        auto       flag_data   = std::vector<gl::uint32_t>(count);
+        auto       value_data  = std::vector<gl::uint32_t>(count);
+        std::ranges::generate(input_data, [&] { return random() % 1024u; });
+        std::ranges::generate(flag_data , [&] { return random() % 2u   ; });
+        std::iota(value_data.begin(), value_data.end(), 0u);
+
+        auto       input       = gl::shader_storage_buffer<gl::uint32_t>{ count };
+        auto       flags       = gl::shader_storage_buffer<gl::uint32_t>{ count };
+        auto       values      = gl::shader_storage_buffer<gl::uint32_t>{ count };
+        auto       output      = gl::shader_storage_buffer<gl::uint32_t>{ count };
+        auto       result      = gl::shader_storage_buffer<gl::uint32_t>{ 1u    };
+        auto       bins        = gl::shader_storage_buffer<gl::uint32_t>{ 256u  };
+        auto       indirect    = gl::dispatch_indirect_buffer{ 1u };
+        input .upload(input_data);
+        flags .upload(flag_data );
+        values.upload(value_data);
+
+        auto       output_data = std::vector<gl::uint32_t>(is_checked ? count : 0u);
+        auto       result_data = std::vector<gl::uint32_t>(1u  );
+        auto       bin_data    = std::vector<gl::uint32_t>(256u);
+
+        {
+            //The compaction writes the work groups of the next dispatch, which is issued without reading the count back
+            auto const compact = [&]
+                {
+                    primitives.compact(input, flags, output, result, indirect);
+                    increment.bind();
+                    output   .bind(gl::binding_t{ 0u }, gl::image_access_e::read_write);
+                    result   .bind(gl::binding_t{ 1u }, gl::image_access_e::read_only);
+                    indirect .bind();
+                    gl::dispatch_compute_indirect(0u);
+                };
+
+            compact();
+            if (is_checked)
+            {
+                auto kept = gl::compute::reference::compact<gl::uint32_t>(input_data, flag_data);
+                std::ranges::for_each(kept, [](gl::uint32_t& value) { ++value; });
+                primitives_read (result, result_data);
+                primitives_read (output, output_data);
+                primitives_check("compact", count, kept, std::span{ output_data }.first(result_data.front()));
+            }
+
+            runner.run("primitives.compact", { { "count", count } }, size, [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) compact();
+                });
+        }
+        {
+            primitives.histogram(input, bins, 0.0f, 1024.0f);
+            if (is_checked)
+            {
+                primitives_read (bins, bin_data);
+                primitives_check("histogram", count, gl::compute::reference::histogram<gl::uint32_t>(input_data, 256u, 0.0f, 1024.0f), bin_data);
+            }
+
+            runner.run("primitives.histogram", { { "count", count } }, size, [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) primitives.histogram(input, bins, 0.0f, 1024.0f);
+                });
+        }
+        {
+            //The sorts run in place, repeated iterations sort already sorted keys which costs the radix passes the same
+            //The keys only sort runs on a copy of the input, the pair sort below still needs the unsorted keys
+            auto keys = gl::shader_storage_buffer<gl::uint32_t>{ count };
+            keys.upload(input_data);
+            primitives.sort(keys);
+            if (is_checked)
+            {
+                auto sorted = input_data;
+                std::ranges::sort(sorted);
+                primitives_read (keys, output_data);
+                primitives_check("sort", count, sorted, output_data);
+            }
+
+            runner.run("primitives.sort", { { "count", count } }, size, [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) primitives.sort(keys);
+                });
+        }
+        {
+            primitives.sort_pairs(input, values);
+            if (is_checked)
+            {
+                gl::compute::reference::sort_pairs<gl::uint32_t>(input_data, value_data);
+                primitives_read (input , output_data);
+                primitives_check("sort_pairs keys"  , count, input_data, output_data);
+                primitives_read (values, output_data);
+                primitives_check("sort_pairs values", count, value_data, output_data);
+            }
+
+            runner.run("primitives.sort_pairs", { { "count", count } }, 2u * size, [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) primitives.sort_pairs(input, values);
+                });
+        }
+    }
+}
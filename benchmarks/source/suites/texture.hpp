@@ -0,0 +1,31 @@
+#pragma once
+
+import std;
+import chroma_gl;
+
+//Full uploads of the base level and mipmap generation on the GPU, both in the format textures loaded from files use
+static inline void texture_benchmarks(bench::runner& runner)
+{
+    auto const texture_data_descriptor = gl::texture_data_descriptor{ gl::texture_base_format_e::rgba, gl::pixel_data_type_e::byte };
+    for (auto const size : { gl::uint32_t{ 256u }, gl::uint32_t{ 1024u }, gl::uint32_t{ 2048u } })
+    {
+        auto const dimensions = gl::vector_2u{ size };
+        auto const memory     = std::vector<gl::byte_t>(static_cast<gl::size_t>(size) * size * 4u, gl::byte_t{ 0x5Au });
+
+        {
+            auto texture = gl::texture_2d{ gl::texture_2d::format_e::rgba_uint8_n, dimensions, gl::false_ };
+            runner.run("texture.upload", { { "dimensions", size } }, memory.size(), [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) texture.upload(texture_data_descriptor, memory);
+                });
+        }
+        {
+            auto texture = gl::texture_2d{ gl::texture_2d::format_e::rgba_uint8_n, dimensions };
+            texture.upload(texture_data_descriptor, memory);
+            runner.run("texture.generate_mipmaps", { { "dimensions", size } }, memory.size(), [&](gl::count_t iterations)
+                {
+                    for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) texture.generate_mipmaps();
+                });
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+import std;
+import glm;
+import chroma_gl;
+
+//Hierarchy updates and frustum culling of the transform system on 1, 4 and 16 threads
+//Every root carries one child, half of the roots move every iteration and the rest stay static
+//Before timing, the world matrices and the culled instances are compared against a serial run of one chunk on one thread
+//A mismatch throws, the culled instances are compared as a set since chunks claim their output in any order
+static inline void transforms_benchmarks(bench::runner& runner)
+{
+    auto const root_count     = gl::count_t{ 1u } << 17u;
+    auto const instance_count = root_count * 2u;
+    auto       camera         = gl::camera{ .aspect_ratio = 16.0f / 9.0f, .field_of_view = glm::radians(75.0f) };
+    camera.projection         = gl::projection::perspective(camera.field_of_view, camera.aspect_ratio, 0.1f, 500.0f);
+    camera.view               = gl::matrix_4f{ glm::lookAt(glm::vec3{ 0.0f, 50.0f, 0.0f }, glm::vec3{ 0.0f, 0.0f, -200.0f }, glm::vec3{ 0.0f, 1.0f, 0.0f }) };
+    auto const frustum        = gl::extract_frustum(camera.view_projection());
+
+    auto const create         = [&]
+        {
+            auto transform_system = gl::transform_system{ instance_count };
+            for (auto index = gl::count_t{ 0u }; index < root_count; ++index)
+            {
+                auto const position = gl::vector_4f{ static_cast<gl::float32_t>(index % 512u) - 256.0f, 0.0f, -static_cast<gl::float32_t>(index / 512u), 1.0f };
+                auto const root     = transform_system.create(gl::transform{ .position = position });
+                transform_system.create(gl::transform{ .position = gl::vector_4f{ 0.0f, 1.0f, 0.0f, 1.0f }, .scale = gl::vector_4f{ 0.5f } }, gl::bounds{}, root);
+            }
+
+            return transform_system;
+        };
+    //Only the moving half is marked dirty, the static roots and their children are skipped by the update
+    auto const move           = [&](gl::transform_system& transform_system, gl::index_t iteration)
+        {
+            auto const angle = static_cast<gl::float32_t>(iteration % 64u) * 0.1f;
+            for (auto root = gl::uint32_t{ 0u }; root < instance_count; root += 4u) transform_system.set_rotation(root, glm::angleAxis(angle, glm::vec3{ 0.0f, 1.0f, 0.0f }));
+        };
+    auto const sorted         = [](std::span<gl::matrix_4f const> matrices)
+        {
+            auto values = std::vector<std::array<gl::float32_t, 16u>>{};
+            values.reserve(matrices.size());
+            for (auto const& matrix : matrices) values.emplace_back(std::bit_cast<std::array<gl::float32_t, 16u>>(matrix));
+            std::ranges::sort(values);
+
+            return values;
+        };
+
+    auto       serial_pool    = gl::thread_pool{ 1u };
+    auto       reference      = create();
+    auto       expected       = std::vector<gl::matrix_4f>(instance_count);
+    move(reference, 1u);
+    reference.update(serial_pool, instance_count);
+    expected.resize(reference.cull(frustum, expected, serial_pool, instance_count));
+    auto const expected_set   = sorted(expected);
+
+    for (auto const thread_count : { gl::count_t{ 1u }, gl::count_t{ 4u }, gl::count_t{ 16u } })
+    {
+        auto thread_pool      = gl::thread_pool{ thread_count };
+        auto transform_system = create();
+        auto instances        = std::vector<gl::matrix_4f>(instance_count);
+        move(transform_system, 1u);
+        transform_system.update(thread_pool);
+
+        for (auto id = gl::transform_system::id_t{ 0u }; id < instance_count; ++id)
+        {
+            if (transform_system.world_matrix(id) != reference.world_matrix(id)) throw std::runtime_error{ std::format("transforms.update on {} threads does not match the serial reference", thread_count) };
+        }
+        auto const visible    = transform_system.cull(frustum, instances, thread_pool);
+        if (sorted(std::span{ instances }.first(visible)) != expected_set) throw std::runtime_error{ std::format("transforms.cull on {} threads does not match the serial reference", thread_count) };
+
+        runner.run("transforms.update", { { "threads", thread_count }, { "instances", instance_count }, { "changed", "half" } }, 0u, [&](gl::count_t iterations)
+            {
+                for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+                {
+                    move(transform_system, iteration);
+                    transform_system.update(thread_pool);
+                }
+            });
+        runner.run("transforms.update", { { "threads", thread_count }, { "instances", instance_count }, { "changed", "none" } }, 0u, [&](gl::count_t iterations)
+            {
+                for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) transform_system.update(thread_pool);
+            });
+        runner.run("transforms.cull"  , { { "threads", thread_count }, { "instances", instance_count } }, 0u, [&](gl::count_t iterations)
+            {
+                for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration) transform_system.cull(frustum, instances, thread_pool);
+            });
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+import std;
+import glm;
+import chroma_gl;
+
+//Per-draw uniform uploads into a small frame buffer object, every iteration is one frame of draws that each read their own matrices
+//The uniform buffer path maps and unmaps one buffer per draw, the transient buffer bump-allocates from persistently mapped memory and fences once per frame
+static inline void transient_uniforms_benchmarks(bench::runner& runner)
+{
+    auto const dimensions             = gl::vector_2u{ 64u, 64u };
+    auto const color_specification    = gl::frame_buffer_specification<>{ "color", gl::frame_buffer_surface_e::render_buffer, gl::render_buffer_format_e::rgba_uint8_n };
+    auto       frame_buffer           = gl::frame_buffer{ gl::frame_buffer_attachment_map_t{ { gl::frame_buffer_attachment_e::color_0, color_specification } }, dimensions };
+
+    auto const vertex_source          = std::string{ R"(
+#version 450 core
+layout(location = 0) in vec3 a_Position;
+layout(std140, binding = 0) uniform mvp_block
+{
+    mat4 u_Model;
+    mat4 u_View;
+    mat4 u_Projection;
+};
+void main()
+{
+    gl_Position = u_Projection * u_View * u_Model * vec4(a_Position, 1.0);
+}
+)" };
+    auto const fragment_source        = std::string{ R"(
+#version 450 core
+layout(location = 0) out vec4 f_Color;
+void main()
+{
+    f_Color = vec4(1.0);
+}
+)" };
+    auto       pipeline               = gl::pipeline{};
+    pipeline.link(std::make_shared<gl::shader>(gl::shader::type_e::vertex  , vertex_source  ));
+    pipeline.link(std::make_shared<gl::shader>(gl::shader::type_e::fragment, fragment_source));
+
+    struct mvp
+    {
+        gl::matrix_4f model;
+        gl::matrix_4f view;
+        gl::matrix_4f projection;
+    };
+    auto const draw_count             = gl::count_t{ 1024u };
+    auto const view                   = gl::matrix_4f{ glm::lookAt(gl::vector_3f{ 0.0f, 0.0f, 10.0f }, gl::vector_3f{ 0.0f }, gl::vector_3f{ 0.0f, 1.0f, 0.0f }) };
+    auto const projection             = gl::projection::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+    auto       matrices               = std::vector<mvp>{};
+    matrices.reserve(draw_count);
+    for (auto index = gl::index_t{ 0u }; index < draw_count; ++index)
+    {
+        auto const position = gl::vector_3f{ static_cast<gl::float32_t>(index % 32u) / 4.0f - 4.0f, static_cast<gl::float32_t>(index / 32u) / 4.0f - 4.0f, 0.0f };
+        matrices.emplace_back(mvp{ glm::translate(gl::matrix_4f{ 1.0f }, position), view, projection });
+    }
+
+    auto const vertex_data            = std::vector<gl::vector_3f>{ gl::vertex::triangle::positions.begin(), gl::vertex::triangle::positions.end() };
+    auto       vertex_array           = gl::vertex_array{};
+    auto       vertex_buffer          = gl::vertex_buffer<gl::vector_3f>{ vertex_data };
+    auto       uniform_buffers        = std::vector<gl::uniform_buffer<mvp>>{};
+    auto       transient_buffer       = gl::transient_buffer{ draw_count * gl::align_up(sizeof(mvp), gl::get<gl::data_e::uniform_buffer_offset_alignment>()) };
+    vertex_array.attach<gl::separate_layout<gl::vertex_attribute<gl::vector_3f>>>(vertex_buffer);
+    uniform_buffers.reserve(draw_count);
+    for (auto index = gl::index_t{ 0u }; index < draw_count; ++index) uniform_buffers.emplace_back(gl::count_t{ 1u });
+
+    gl::viewport(dimensions);
+    frame_buffer.bind(gl::frame_buffer::target_e::read_write);
+    pipeline    .bind();
+    vertex_array.bind();
+
+    runner.run("transient_uniforms.frame", { { "path", "uniform_buffer" }, { "draws", draw_count } }, draw_count * sizeof(mvp), [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+            {
+                for (auto index = gl::index_t{ 0u }; index < draw_count; ++index)
+                {
+                    uniform_buffers[index].upload(matrices[index]);
+                    uniform_buffers[index].bind  (gl::binding_t{ 0u });
+                    gl::draw_arrays(gl::draw_mode_e::triangles, gl::index_range{ 0u, 3u });
+                }
+            }
+        });
+    runner.run("transient_uniforms.frame", { { "path", "transient_buffer" }, { "draws", draw_count } }, draw_count * sizeof(mvp), [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+            {
+                for (auto index = gl::index_t{ 0u }; index < draw_count; ++index)
+                {
+                    auto const range = transient_buffer.push(gl::buffer_base_target_e::uniform_buffer, matrices[index]);
+                    transient_buffer.bind(gl::buffer_base_target_e::uniform_buffer, gl::binding_t{ 0u }, range);
+                    gl::draw_arrays(gl::draw_mode_e::triangles, gl::index_range{ 0u, 3u });
+                }
+                transient_buffer.next_frame();
+            }
+        });
+}
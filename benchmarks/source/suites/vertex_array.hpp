@@ -0,0 +1,49 @@
+#pragma once
+
+import std;
+import chroma_gl;
+
+//Every iteration creates a vertex array and attaches its buffers, attaching to the same vertex array again would use up its binding points
+static inline void vertex_array_benchmarks(bench::runner& runner)
+{
+    struct     vertex
+    {
+        gl::vector_3f position;
+        gl::vector_3f normal;
+        gl::vector_2f coordinate;
+    };
+    using      position_attribute   = gl::vertex_attribute<gl::vector_3f>;
+    using      normal_attribute     = gl::vertex_attribute<gl::vector_3f>;
+    using      coordinate_attribute = gl::vertex_attribute<gl::vector_2f>;
+    using      model_attribute      = gl::vertex_attribute<gl::matrix_4f, 4u, 4u, 1u>;
+
+    auto const vertex_count         = gl::count_t{ 1024u };
+    auto       vertex_buffer        = gl::vertex_buffer<vertex>        { vertex_count };
+    auto       position_buffer      = gl::vertex_buffer<gl::vector_3f> { vertex_count };
+    auto       normal_buffer        = gl::vertex_buffer<gl::vector_3f> { vertex_count };
+    auto       coordinate_buffer    = gl::vertex_buffer<gl::vector_2f> { vertex_count };
+    auto       instance_buffer      = gl::vertex_buffer<gl::matrix_4f> { vertex_count };
+    auto       index_buffer         = gl::index_buffer                 { vertex_count };
+
+    runner.run("vertex_array.attach", { { "layout", "interleaved" } }, 0u, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+            {
+                auto vertex_array = gl::vertex_array{};
+                vertex_array.attach<gl::interleaved_layout<position_attribute, normal_attribute, coordinate_attribute>>(vertex_buffer);
+                vertex_array.attach(index_buffer);
+            }
+        });
+    runner.run("vertex_array.attach", { { "layout", "separate" } }, 0u, [&](gl::count_t iterations)
+        {
+            for (auto iteration = gl::index_t{ 0u }; iteration < iterations; ++iteration)
+            {
+                auto vertex_array = gl::vertex_array{};
+                vertex_array.attach<gl::separate_layout<position_attribute  >>(position_buffer  );
+                vertex_array.attach<gl::separate_layout<normal_attribute    >>(normal_buffer    );
+                vertex_array.attach<gl::separate_layout<coordinate_attribute>>(coordinate_buffer);
+                vertex_array.attach<gl::separate_layout<model_attribute     >>(instance_buffer  );
+                vertex_array.attach(index_buffer);
+            }
+        });
+}
@@ -13,12 +13,20 @@ project "chroma-gl"
 	usage "PUBLIC"
 		uses        { "glad", "glm", "rgfw", "stb" }
 		includedirs { "source" }
-		links       { "opengl32.lib" }
+
+		filter "system:windows"
+			links { "opengl32.lib" }
+		filter "system:linux"
+			links { "GL" }
+		filter {}
 
 		filter "configurations:Debug"
 			defines { "BUILD_CONFIGURATION=debug" }
 		filter "configurations:Release"
 			defines { "BUILD_CONFIGURATION=release" }
 		filter {}
+		if _OPTIONS["trace"] then
+			defines { "GL_TRACE" }
+		end
 	usage "INTERFACE"
 		links { "chroma-gl" }
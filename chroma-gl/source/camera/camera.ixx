@@ -11,6 +11,35 @@ export namespace gl
     {
         gl::float32_t aspect_ratio  = 1.0f;
         gl::float32_t field_of_view = glm::radians(90.0f);
-        gl::matrix_4f projection    = projection::perspective(aspect_ratio, field_of_view, 0.01f, 100.0f);
+        gl::matrix_4f projection    = projection::perspective(field_of_view, aspect_ratio, 0.01f, 100.0f);
+        gl::matrix_4f view          = gl::matrix_4f{ 1.0f };
+
+        auto view_projection() const -> gl::matrix_4f
+        {
+            return projection * view;
+        }
+    };
+
+    //Planes in the order left, right, bottom, top, near and far, normals are normalized and point into the volume
+    struct frustum
+    {
+        std::array<gl::vector_4f, 6u> planes;
     };
+    //Gribb and Hartmann's plane extraction, the planes are in the space the matrix transforms from
+    auto extract_frustum(gl::matrix_4f const& view_projection) -> gl::frustum
+    {
+        auto const row    = [&](gl::index_t index) { return gl::vector_4f{ view_projection[0][index], view_projection[1][index], view_projection[2][index], view_projection[3][index] }; };
+        auto       result = gl::frustum
+        {
+            .planes =
+            {
+                row(3u) + row(0u), row(3u) - row(0u), 
+                row(3u) + row(1u), row(3u) - row(1u), 
+                row(3u) + row(2u), row(3u) - row(2u), 
+            },
+        };
+        for (auto& plane : result.planes) plane /= glm::length(gl::vector_3f{ plane });
+
+        return result;
+    }
 }
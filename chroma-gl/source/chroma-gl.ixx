@@ -1,21 +1,44 @@
 export module chroma_gl;
 export import opengl;
+export import :camera;
 export import :color;
+export import :compute.primitives;
+export import :io.file_reader;
 export import :io.image;
+export import :io.mapped_file;
+export import :io.pixel;
+export import :io.texture_container;
 export import :io;
+export import :mesh;
 export import :object.buffer;
 export import :object.cubemap;
+export import :object.draw_batch;
+export import :object.fence;
 export import :object.frame_buffer;
+export import :object.frame_graph;
+export import :object.geometry_heap;
+export import :object.memory_lock;
 export import :object.pipeline;
+export import :object.profiler;
 export import :object.query;
+export import :object.range_allocator;
+export import :object.readback_queue;
 export import :object.render_buffer;
 export import :object.sampler;
+export import :object.shader.program_cache;
+export import :object.shader.shader_block;
 export import :object.shader.uniform_cache;
 export import :object.shader;
 export import :object.texture;
+export import :object.texture_atlas;
+export import :object.texture_streamer;
+export import :object.transient_buffer;
 export import :object.vertex_array;
 export import :object;
 export import :projection;
+export import :thread.thread_pool;
+export import :transform.transform_system;
+export import :transform;
 export import :vertex;
 
 import std;
@@ -24,8 +47,8 @@ export namespace gl
 {
     auto create_texture_from_file  (std::filesystem::path const& path) -> gl::texture_2d
     {
-        auto       image_data              = gl::io::read(path);
-        auto       image                   = gl::image::decode(gl::image::format_e::rgba_uint8, image_data);
+        auto const file                    = gl::io::mapped_file{ path };
+        auto       image                   = gl::image::decode(gl::image::format_e::rgba_uint8, file.data());
         auto       texture                 = gl::texture_2d{ gl::texture_2d::format_e::rgba_uint8_n, image.dimensions() };
         auto const texture_data_descriptor = gl::texture_data_descriptor{ gl::texture_base_format_e::rgba, gl::pixel_data_type_e::byte };
         texture.upload          (texture_data_descriptor, image.data());
@@ -33,13 +56,83 @@ export namespace gl
 
         return texture;
     }
+    //Creates the texture with exactly the stored mip chain and uploads every level, the blocks are passed to the driver straight from the container
+    auto create_texture_from_container      (gl::io::texture_container const& container) -> gl::compressed_texture_2d
+    {
+        if (container.is_array() || container.is_cubemap()) throw std::invalid_argument{ "texture container holds more than one image per level" };
+
+        auto texture = gl::compressed_texture_2d{ container.format(), container.dimensions(), container.level_count() };
+        for (auto level = gl::uint32_t{ 0u }; level < container.level_count(); ++level)
+        {
+            texture.upload(level, container.level_dimensions(level), container.image(level));
+        }
+
+        return texture;
+    }
+    auto create_texture_array_from_container(gl::io::texture_container const& container) -> gl::texture_2d_array
+    {
+        if (container.is_cubemap()) throw std::invalid_argument{ "texture container holds a cubemap" };
+
+        auto texture = gl::texture_2d_array{ container.layer_count(), static_cast<gl::texture_format_e>(container.format()), container.dimensions(), container.level_count() };
+        for (auto level = gl::uint32_t{ 0u }; level < container.level_count(); ++level)
+        {
+            for (auto layer = gl::uint32_t{ 0u }; layer < container.layer_count(); ++layer)
+            {
+                texture.upload(layer, level, container.level_dimensions(level), container.format(), container.image(level, layer));
+            }
+        }
+
+        return texture;
+    }
+    auto create_cubemap_from_container      (gl::io::texture_container const& container) -> gl::cubemap
+    {
+        if (!container.is_cubemap() || container.is_array()) throw std::invalid_argument{ "texture container does not hold a single cubemap" };
+
+        auto cubemap = gl::cubemap{ static_cast<gl::texture_format_e>(container.format()), gl::vector_1u{ container.dimensions().x }, container.level_count() };
+        for (auto level = gl::uint32_t{ 0u }; level < container.level_count(); ++level)
+        {
+            for (auto face = gl::uint32_t{ 0u }; face < container.face_count(); ++face)
+            {
+                cubemap.upload(gl::cubemap::face_e::positive_x + face, level, container.level_dimensions(level), container.format(), container.image(level, 0u, face));
+            }
+        }
+
+        return cubemap;
+    }
+    auto create_texture_from_container      (std::filesystem::path const& path) -> gl::compressed_texture_2d
+    {
+        auto const file = gl::io::mapped_file{ path };
+        return gl::create_texture_from_container      (gl::io::texture_container{ file.data() });
+    }
+    auto create_texture_array_from_container(std::filesystem::path const& path) -> gl::texture_2d_array
+    {
+        auto const file = gl::io::mapped_file{ path };
+        return gl::create_texture_array_from_container(gl::io::texture_container{ file.data() });
+    }
+    auto create_cubemap_from_container      (std::filesystem::path const& path) -> gl::cubemap
+    {
+        auto const file = gl::io::mapped_file{ path };
+        return gl::create_cubemap_from_container      (gl::io::texture_container{ file.data() });
+    }
     auto create_pipeline_from_files(std::unordered_map<gl::shader::type_e, std::filesystem::path> const& file_names) -> gl::pipeline
     {
         auto shaders = std::vector<std::shared_ptr<gl::shader>>{};
         std::ranges::for_each(file_names, [&](auto const iterator)
             {
-                auto const binary = gl::io::read(iterator.second);
-                shaders.emplace_back(std::make_shared<gl::shader>(iterator.first, "main", binary));
+                auto const file = gl::io::mapped_file{ iterator.second };
+                shaders.emplace_back(std::make_shared<gl::shader>(iterator.first, "main", file.data()));
+            });
+
+        return gl::pipeline{ shaders };
+    }
+    //Every compile is started before the first status query, poll the pipeline for readiness and save the cache once it is resolved
+    auto create_pipeline_from_files(std::unordered_map<gl::shader::type_e, std::filesystem::path> const& file_names, gl::program_cache& cache) -> gl::pipeline
+    {
+        auto shaders = std::vector<std::shared_ptr<gl::shader>>{};
+        std::ranges::for_each(file_names, [&](auto const iterator)
+            {
+                auto const file = gl::io::mapped_file{ iterator.second };
+                shaders.emplace_back(std::make_shared<gl::shader>(iterator.first, "main", file.data(), cache));
             });
 
         return gl::pipeline{ shaders };
@@ -0,0 +1,703 @@
+export module chroma_gl:compute.primitives;
+
+import std;
+import opengl;
+import :object.buffer;
+import :object.pipeline;
+import :object.shader;
+import :object.shader.program_cache;
+
+export namespace gl::compute
+{
+    enum class operation_e
+    {
+        sum    ,
+        minimum,
+        maximum,
+    };
+
+    //Element types are taken from the shader storage buffers the primitives operate on
+    template<typename buffer_t> struct storage_traits : std::false_type {};
+    template<typename element_t, gl::bool_t upload_v, gl::bool_t download_v>
+    struct storage_traits<gl::shader_storage_buffer<element_t, upload_v, download_v>> : std::true_type { using type = element_t; };
+    template<typename buffer_t> using storage_element_t = typename gl::compute::storage_traits<std::remove_cvref_t<buffer_t>>::type;
+
+
+
+    //Scan, reduction, stream compaction, radix sort and histogram kernels over shader storage buffers
+    //Kernels are generated per element type and compiled on first use, pass a program cache to keep their binaries between runs
+    //Every primitive records its dispatches without waiting, shader writes are made visible through the barrier tracker when buffers are bound
+    class primitives
+    {
+    public:
+        static auto constexpr group_size                = gl::count_t{ 256u  };
+        static auto constexpr histogram_bin_limit       = gl::count_t{ 4096u };
+        static auto constexpr maximum_work_group_count  = gl::count_t{ 65535u };
+
+        primitives()
+            : cache_{ nullptr }, kernels_{}, levels_{}, indices_{}, histogram_{}, keys_{}, values_{} {}
+        explicit
+        primitives(gl::program_cache& cache)
+            : cache_{ &cache }, kernels_{}, levels_{}, indices_{}, histogram_{}, keys_{}, values_{} {}
+
+        template<typename input_t, typename output_t>
+        void exclusive_scan(input_t& input, output_t& output)
+        {
+            using element_t = gl::compute::storage_element_t<input_t>;
+            static_assert(std::is_same_v<element_t, gl::compute::storage_element_t<output_t>>, "input and output must have the same element type");
+            if (output.count() < input.count()) throw std::invalid_argument{ "output is smaller than input" };
+
+            scan_<element_t>(input, output, input.count(), gl::false_, gl::false_);
+        }
+        template<typename input_t, typename output_t>
+        void inclusive_scan(input_t& input, output_t& output)
+        {
+            using element_t = gl::compute::storage_element_t<input_t>;
+            static_assert(std::is_same_v<element_t, gl::compute::storage_element_t<output_t>>, "input and output must have the same element type");
+            if (output.count() < input.count()) throw std::invalid_argument{ "output is smaller than input" };
+
+            scan_<element_t>(input, output, input.count(), gl::true_, gl::false_);
+        }
+
+        //Writes the result to the first element of the result buffer
+        template<typename input_t, typename result_t>
+        void reduce(input_t& input, result_t& result, gl::compute::operation_e operation = gl::compute::operation_e::sum)
+        {
+            using element_t = gl::compute::storage_element_t<input_t>;
+            static_assert(std::is_same_v<element_t, gl::compute::storage_element_t<result_t>>, "input and result must have the same element type");
+            if (input .count() == 0u) throw std::invalid_argument{ "cannot reduce an empty buffer" };
+            if (result.count() == 0u) throw std::invalid_argument{ "result buffer is empty"        };
+
+            auto* source = static_cast<gl::buffer*>(&input);
+            auto  count  = input.count();
+            auto  level  = gl::index_t{ 0u };
+            while (count > group_size)
+            {
+                auto const group_count = groups_(count);
+                auto&      partials    = level_(level++, group_count);
+                reduce_pass_<element_t>(*source, partials, count, operation);
+
+                source = &partials;
+                count  = group_count;
+            }
+
+            reduce_pass_<element_t>(*source, result, count, operation);
+        }
+
+        //Keeps the elements whose flag is not zero in their original order and writes how many were kept to the count buffer
+        //The overload with an indirect buffer also writes the work groups a kernel of the given local size needs for the kept elements
+        //Dispatching from that buffer chains the next kernel to the compaction without reading the count back
+        template<typename input_t, typename flags_t, typename output_t, typename counter_t>
+        void compact(input_t& input, flags_t& flags, output_t& output, counter_t& count)
+        {
+            compact_(input, flags, output, count, nullptr, group_size);
+        }
+        template<typename input_t, typename flags_t, typename output_t, typename counter_t>
+        void compact(input_t& input, flags_t& flags, output_t& output, counter_t& count, gl::dispatch_indirect_buffer& indirect, gl::count_t local_size = group_size)
+        {
+            if (local_size == 0u) throw std::invalid_argument{ "local size must be greater than zero" };
+            if (indirect.count() == 0u) throw std::invalid_argument{ "indirect buffer is empty" };
+
+            compact_(input, flags, output, count, &indirect, local_size);
+        }
+
+        //Stable least significant digit radix sort on unsigned keys, four bits per pass
+        //Sorting on fewer key bits skips the passes of the high digits
+        template<typename keys_t>
+        void sort      (keys_t& keys, gl::count_t key_bits = 32u)
+        {
+            static_assert(std::is_same_v<gl::compute::storage_element_t<keys_t>, gl::uint32_t>, "keys must be unsigned 32-bit integers");
+
+            sort_(keys, nullptr, key_bits);
+        }
+        template<typename keys_t, typename values_t>
+        void sort_pairs(keys_t& keys, values_t& values, gl::count_t key_bits = 32u)
+        {
+            static_assert(std::is_same_v<gl::compute::storage_element_t<keys_t>, gl::uint32_t>, "keys must be unsigned 32-bit integers");
+            static_assert(sizeof(gl::compute::storage_element_t<values_t>) == sizeof(gl::uint32_t), "values must be 32 bits wide");
+            if (values.count() < keys.count()) throw std::invalid_argument{ "values buffer is smaller than keys buffer" };
+
+            sort_(keys, &values, key_bits);
+        }
+
+        //Counts the elements in [minimum, maximum) into equally wide bins, every bin of the buffer is used
+        template<typename input_t, typename bins_t>
+        void histogram (input_t& input, bins_t& bins, gl::float32_t minimum, gl::float32_t maximum)
+        {
+            using element_t = gl::compute::storage_element_t<input_t>;
+            static_assert(std::is_same_v<gl::compute::storage_element_t<bins_t>, gl::uint32_t>, "bins must be unsigned 32-bit integers");
+            if (bins.count() == 0u || bins.count() > histogram_bin_limit) throw std::invalid_argument{ "bin count is out of range"             };
+            if (!(minimum < maximum))                                     throw std::invalid_argument{ "minimum must be smaller than maximum" };
+
+            clear_(bins);
+            if (input.count() == 0u) return;
+
+            auto& shader = use_(source_<element_t>(histogram_source_));
+            bind_(input, 0u, gl::image_access_e::read_only);
+            bind_(bins , 1u);
+            shader.upload(gl::index_t{ 0u }, static_cast<gl::uint32_t>(input.count()));
+            shader.upload(gl::index_t{ 1u }, static_cast<gl::uint32_t>(bins .count()));
+            shader.upload(gl::index_t{ 2u }, minimum);
+            shader.upload(gl::index_t{ 3u }, maximum);
+            shader.upload(gl::index_t{ 4u }, static_cast<gl::float32_t>(bins.count()) / (maximum - minimum));
+            gl::dispatch_compute(work_groups_(groups_(input.count())));
+        }
+
+    private:
+        static auto constexpr radix_bits_ = gl::count_t{ 4u  };
+        static auto constexpr radix_size_ = gl::count_t{ 16u };
+
+        //Work groups are laid out in two dimensions once their count exceeds the guaranteed limit of one dimension
+        static auto constexpr common_source_ = std::string_view{ R"(
+layout(local_size_x = GROUP_SIZE) in;
+
+uint group_index()
+{
+    return gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x;
+}
+)" };
+        static auto constexpr scan_source_ = std::string_view{ R"(
+layout(std430, binding = 0) buffer input_block  { VALUE_T input_values [];   };
+layout(std430, binding = 1) buffer output_block { VALUE_T output_values[];   };
+layout(std430, binding = 2) buffer sums_block   { VALUE_T block_sums   [];   };
+
+layout(location = 0) uniform uint count;
+layout(location = 1) uniform uint inclusive;
+
+shared VALUE_T values[GROUP_SIZE];
+
+void main()
+{
+    uint group = group_index();
+    uint local = gl_LocalInvocationID.x;
+    uint index = group * GROUP_SIZE + local;
+    if (group * GROUP_SIZE >= count) return;
+
+    values[local] = index < count ? LOAD(index) : VALUE_T(0);
+    barrier();
+
+    for (uint offset = 1u; offset < GROUP_SIZE; offset <<= 1u)
+    {
+        VALUE_T addend = local >= offset ? values[local - offset] : VALUE_T(0);
+        barrier();
+        values[local] += addend;
+        barrier();
+    }
+
+    VALUE_T exclusive_value = local > 0u ? values[local - 1u] : VALUE_T(0);
+    if (index < count)                  output_values[index] = inclusive != 0u ? values[local] : exclusive_value;
+    if (local == GROUP_SIZE - 1u)       block_sums   [group] = values[local];
+}
+)" };
+        static auto constexpr add_source_ = std::string_view{ R"(
+layout(std430, binding = 1) buffer output_block { VALUE_T output_values[]; };
+layout(std430, binding = 2) buffer sums_block   { VALUE_T block_sums   []; };
+
+layout(location = 0) uniform uint count;
+
+void main()
+{
+    uint group = group_index();
+    uint index = group * GROUP_SIZE + gl_LocalInvocationID.x;
+    if (index < count) output_values[index] += block_sums[group];
+}
+)" };
+        static auto constexpr reduce_source_ = std::string_view{ R"(
+layout(std430, binding = 0) buffer input_block  { VALUE_T input_values [];   };
+layout(std430, binding = 1) buffer output_block { VALUE_T output_values[];   };
+
+layout(location = 0) uniform uint count;
+
+shared VALUE_T values[GROUP_SIZE];
+
+void main()
+{
+    uint group = group_index();
+    uint local = gl_LocalInvocationID.x;
+    uint index = group * GROUP_SIZE + local;
+    if (group * GROUP_SIZE >= count) return;
+
+    values[local] = index < count ? input_values[index] : IDENTITY;
+    for (uint stride = GROUP_SIZE / 2u; stride > 0u; stride >>= 1u)
+    {
+        barrier();
+        if (local < stride) values[local] = COMBINE(values[local], values[local + stride]);
+    }
+
+    if (local == 0u) output_values[group] = values[0];
+}
+)" };
+        static auto constexpr compact_source_ = std::string_view{ R"(
+layout(std430, binding = 0) buffer input_block    { VALUE_T input_values [];   };
+layout(std430, binding = 1) buffer flags_block    { uint    flags        [];   };
+layout(std430, binding = 2) buffer indices_block  { uint    indices      [];   };
+layout(std430, binding = 3) buffer output_block   { VALUE_T output_values[];   };
+layout(std430, binding = 4) buffer count_block    { uint    kept_count   [];   };
+layout(std430, binding = 5) buffer indirect_block { uint    work_groups  [];   };
+
+layout(location = 0) uniform uint count;
+layout(location = 1) uniform uint local_size;
+layout(location = 2) uniform uint has_indirect;
+
+void main()
+{
+    uint index = group_index() * GROUP_SIZE + gl_LocalInvocationID.x;
+    if (index >= count) return;
+
+    uint flag = flags[index] != 0u ? 1u : 0u;
+    if (flag != 0u) output_values[indices[index]] = input_values[index];
+    if (index != count - 1u) return;
+
+    uint total = indices[index] + flag;
+    kept_count[0] = total;
+    if (has_indirect == 0u) return;
+
+    uint groups    = (total  + local_size - 1u) / local_size;
+    work_groups[0] = min(groups, MAXIMUM_WORK_GROUP_COUNT);
+    work_groups[1] = (groups + MAXIMUM_WORK_GROUP_COUNT - 1u) / MAXIMUM_WORK_GROUP_COUNT;
+    work_groups[2] = 1u;
+}
+)" };
+        static auto constexpr radix_count_source_ = std::string_view{ R"(
+layout(std430, binding = 0) buffer keys_block      { uint keys     []; };
+layout(std430, binding = 1) buffer histogram_block { uint histogram[]; };
+
+layout(location = 0) uniform uint count;
+layout(location = 1) uniform uint shift;
+layout(location = 2) uniform uint group_count;
+
+shared uint digit_counts[RADIX_SIZE];
+
+void main()
+{
+    uint group = group_index();
+    uint local = gl_LocalInvocationID.x;
+    uint index = group * GROUP_SIZE + local;
+    if (group >= group_count) return;
+
+    if (local < RADIX_SIZE) digit_counts[local] = 0u;
+    barrier();
+
+    if (index < count) atomicAdd(digit_counts[(keys[index] >> shift) & (RADIX_SIZE - 1u)], 1u);
+    barrier();
+
+    if (local < RADIX_SIZE) histogram[local * group_count + group] = digit_counts[local];
+}
+)" };
+        //The rank of a key among equal digits of its work group comes from one scan of sixteen packed 16-bit counters
+        static auto constexpr radix_scatter_source_ = std::string_view{ R"(
+layout(std430, binding = 0) buffer keys_in_block    { uint keys_in   []; };
+layout(std430, binding = 1) buffer values_in_block  { uint values_in []; };
+layout(std430, binding = 2) buffer offsets_block    { uint offsets   []; };
+layout(std430, binding = 3) buffer keys_out_block   { uint keys_out  []; };
+layout(std430, binding = 4) buffer values_out_block { uint values_out[]; };
+
+layout(location = 0) uniform uint count;
+layout(location = 1) uniform uint shift;
+layout(location = 2) uniform uint group_count;
+
+shared uvec4 low_counters [GROUP_SIZE];
+shared uvec4 high_counters[GROUP_SIZE];
+
+void main()
+{
+    uint group = group_index();
+    uint local = gl_LocalInvocationID.x;
+    uint index = group * GROUP_SIZE + local;
+    if (group >= group_count) return;
+
+    uint  key        = index < count ? keys_in[index] : 0xffffffffu;
+    uint  digit      = (key >> shift) & (RADIX_SIZE - 1u);
+    uint  word       = digit >> 1u;
+    uint  half_shift = (digit & 1u) * 16u;
+    uvec4 one_hot    = uvec4(0u);
+    one_hot[word & 3u]   = 1u << half_shift;
+    low_counters [local] = word <  4u ? one_hot : uvec4(0u);
+    high_counters[local] = word >= 4u ? one_hot : uvec4(0u);
+    barrier();
+
+    for (uint offset = 1u; offset < GROUP_SIZE; offset <<= 1u)
+    {
+        uvec4 low  = local >= offset ? low_counters [local - offset] : uvec4(0u);
+        uvec4 high = local >= offset ? high_counters[local - offset] : uvec4(0u);
+        barrier();
+        low_counters [local] += low;
+        high_counters[local] += high;
+        barrier();
+    }
+    if (index >= count) return;
+
+    uvec4 counters    = word < 4u ? low_counters[local] : high_counters[local];
+    uint  rank        = ((counters[word & 3u] >> half_shift) & 0xffffu) - 1u;
+    uint  destination = offsets[digit * group_count + group] + rank;
+    keys_out[destination] = key;
+#ifdef HAS_VALUES
+    values_out[destination] = values_in[index];
+#endif
+}
+)" };
+        static auto constexpr histogram_source_ = std::string_view{ R"(
+layout(std430, binding = 0) buffer input_block { VALUE_T input_values[]; };
+layout(std430, binding = 1) buffer bins_block  { uint    bins        []; };
+
+layout(location = 0) uniform uint  count;
+layout(location = 1) uniform uint  bin_count;
+layout(location = 2) uniform float minimum;
+layout(location = 3) uniform float maximum;
+layout(location = 4) uniform float scale;
+
+shared uint bin_counts[HISTOGRAM_BIN_LIMIT];
+
+void main()
+{
+    uint group = group_index();
+    uint local = gl_LocalInvocationID.x;
+    uint index = group * GROUP_SIZE + local;
+    if (group * GROUP_SIZE >= count) return;
+
+    for (uint bin = local; bin < bin_count; bin += GROUP_SIZE) bin_counts[bin] = 0u;
+    barrier();
+
+    if (index < count)
+    {
+        float value = float(input_values[index]);
+        if (value >= minimum && value < maximum) atomicAdd(bin_counts[min(uint((value - minimum) * scale), bin_count - 1u)], 1u);
+    }
+    barrier();
+
+    for (uint bin = local; bin < bin_count; bin += GROUP_SIZE)
+    {
+        if (bin_counts[bin] != 0u) atomicAdd(bins[bin], bin_counts[bin]);
+    }
+}
+)" };
+
+        struct kernel_
+        {
+            std::shared_ptr<gl::shader> shader;
+            gl::pipeline                pipeline;
+        };
+
+        template<typename element_t>
+        static auto type_name_() -> std::string_view
+        {
+                 if constexpr (std::is_same_v<element_t, gl::uint32_t >) return "uint" ;
+            else if constexpr (std::is_same_v<element_t, gl::int32_t  >) return "int"  ;
+            else if constexpr (std::is_same_v<element_t, gl::float32_t>) return "float";
+            else static_assert(gl::false_ && sizeof(element_t), "element type must be a 32-bit integer or float");
+        }
+        template<typename element_t>
+        static auto identity_(gl::compute::operation_e operation) -> std::string_view
+        {
+            using enum gl::compute::operation_e;
+            switch (operation)
+            {
+                case sum    : return "VALUE_T(0)";
+                case minimum:
+                         if constexpr (std::is_same_v<element_t, gl::uint32_t >) return "0xffffffffu"                ;
+                    else if constexpr (std::is_same_v<element_t, gl::int32_t  >) return "0x7fffffff"                 ;
+                    else if constexpr (std::is_same_v<element_t, gl::float32_t>) return "uintBitsToFloat(0x7f800000u)";
+                case maximum:
+                         if constexpr (std::is_same_v<element_t, gl::uint32_t >) return "0u"                         ;
+                    else if constexpr (std::is_same_v<element_t, gl::int32_t  >) return "(-0x7fffffff - 1)"          ;
+                    else if constexpr (std::is_same_v<element_t, gl::float32_t>) return "uintBitsToFloat(0xff800000u)";
+
+                default: throw std::invalid_argument{ "invalid operation" };
+            }
+        }
+        static auto combine_(gl::compute::operation_e operation) -> std::string_view
+        {
+            using enum gl::compute::operation_e;
+            switch (operation)
+            {
+                case sum    : return "((a) + (b))"  ;
+                case minimum: return "min((a), (b))";
+                case maximum: return "max((a), (b))";
+
+                default: throw std::invalid_argument{ "invalid operation" };
+            }
+        }
+        //Prepends the definitions every kernel shares, the generated source also identifies the kernel
+        template<typename element_t>
+        static auto source_(std::string_view body, std::string_view definitions = {}) -> std::string
+        {
+            return std::format(
+                "#version 460 core\n"
+                "#define VALUE_T {}\n"
+                "#define LOAD(index) input_values[index]\n"
+                "#define GROUP_SIZE {}u\n"
+                "#define RADIX_SIZE {}u\n"
+                "#define HISTOGRAM_BIN_LIMIT {}u\n"
+                "#define MAXIMUM_WORK_GROUP_COUNT {}u\n"
+                "{}{}{}",
+                type_name_<element_t>(), group_size, radix_size_, histogram_bin_limit, maximum_work_group_count, definitions, common_source_, body);
+        }
+
+        static auto groups_     (gl::count_t count) -> gl::count_t
+        {
+            return (count + group_size - 1u) / group_size;
+        }
+        static auto work_groups_(gl::count_t group_count) -> gl::vector_3u
+        {
+            auto const x = std::clamp<gl::count_t>(group_count, 1u, maximum_work_group_count);
+            return gl::vector_3u{ x, (group_count + x - 1u) / x, 1u };
+        }
+
+        //Writes of the previous dispatch are made visible by the next dispatch that reads the binding
+        static void bind_ (gl::buffer& buffer, gl::binding_t binding, gl::image_access_e access = gl::image_access_e::read_write)
+        {
+            gl::bind_buffer_base(buffer.handle(), gl::buffer_base_target_e::shader_storage_buffer, binding, access);
+        }
+        static void clear_(gl::buffer& buffer)
+        {
+            buffer.require_barrier(gl::memory_barrier_e::buffer_update);
+            gl::clear_buffer_data<gl::uint32_t>(buffer.handle(), gl::buffer_base_format_e::r_int, gl::buffer_format_e::r_uint32, gl::data_type_e::uint32, 0u);
+        }
+
+        auto use_   (std::string const& source) -> gl::shader&
+        {
+            auto iterator = kernels_.find(source);
+            if (iterator == kernels_.end())
+            {
+                auto shader = cache_ ? std::make_shared<gl::shader>(gl::shader::type_e::compute, source, *cache_)
+                                     : std::make_shared<gl::shader>(gl::shader::type_e::compute, source         );
+                auto kernel = kernel_{ shader, gl::pipeline{} };
+                kernel.pipeline.link(shader);
+
+                iterator = kernels_.emplace(source, std::move(kernel)).first;
+            }
+
+            iterator->second.pipeline.bind();
+            return *iterator->second.shader;
+        }
+        //Levels are kept in a deque, growing it does not move the buffers that are still in use by an outer level
+        auto level_ (gl::index_t level, gl::count_t count) -> gl::static_buffer<gl::uint32_t>&
+        {
+            if (level == levels_.size())          levels_.emplace_back(count);
+            if (levels_.at(level).count() < count) levels_.at(level) = gl::static_buffer<gl::uint32_t>{ count };
+
+            return levels_.at(level);
+        }
+        auto reserve_(std::optional<gl::static_buffer<gl::uint32_t>>& buffer, gl::count_t count) -> gl::static_buffer<gl::uint32_t>&
+        {
+            if (!buffer || buffer->count() < count) buffer.emplace(count);
+
+            return *buffer;
+        }
+
+        //Scans every work group, scans the sums of the groups one level up and adds them back
+        template<typename element_t>
+        void scan_(gl::buffer& input, gl::buffer& output, gl::count_t count, gl::bool_t is_inclusive, gl::bool_t is_predicate, gl::index_t level = 0u)
+        {
+            if (count == 0u) return;
+
+            auto const group_count = groups_(count);
+            auto&      sums        = level_(level, group_count);
+            auto&      scan        = use_(source_<element_t>(scan_source_, is_predicate ? "#undef LOAD\n#define LOAD(index) (input_values[index] != 0u ? 1u : 0u)\n" : ""));
+            bind_(input , 0u, gl::image_access_e::read_only);
+            bind_(output, 1u);
+            bind_(sums  , 2u);
+            scan.upload(gl::index_t{ 0u }, static_cast<gl::uint32_t>(count       ));
+            scan.upload(gl::index_t{ 1u }, static_cast<gl::uint32_t>(is_inclusive));
+            gl::dispatch_compute(work_groups_(group_count));
+            if (group_count == 1u) return;
+
+            scan_<element_t>(sums, sums, group_count, gl::false_, gl::false_, level + 1u);
+
+            auto&      add         = use_(source_<element_t>(add_source_));
+            bind_(output, 1u);
+            bind_(sums  , 2u, gl::image_access_e::read_only);
+            add.upload(gl::index_t{ 0u }, static_cast<gl::uint32_t>(count));
+            gl::dispatch_compute(work_groups_(group_count));
+        }
+        template<typename element_t>
+        void reduce_pass_(gl::buffer& input, gl::buffer& output, gl::count_t count, gl::compute::operation_e operation)
+        {
+            auto const definitions = std::format("#define IDENTITY {}\n#define COMBINE(a, b) {}\n", identity_<element_t>(operation), combine_(operation));
+            auto&      reduce      = use_(source_<element_t>(reduce_source_, definitions));
+            bind_(input , 0u, gl::image_access_e::read_only);
+            bind_(output, 1u);
+            reduce.upload(gl::index_t{ 0u }, static_cast<gl::uint32_t>(count));
+            gl::dispatch_compute(work_groups_(groups_(count)));
+        }
+        template<typename input_t, typename flags_t, typename output_t, typename counter_t>
+        void compact_(input_t& input, flags_t& flags, output_t& output, counter_t& count, gl::dispatch_indirect_buffer* indirect, gl::count_t local_size)
+        {
+            using element_t = gl::compute::storage_element_t<input_t>;
+            static_assert(std::is_same_v<element_t, gl::compute::storage_element_t<output_t>>, "input and output must have the same element type"  );
+            static_assert(std::is_same_v<gl::compute::storage_element_t<flags_t>, gl::uint32_t>, "flags must be unsigned 32-bit integers"         );
+            static_assert(std::is_same_v<gl::compute::storage_element_t<counter_t>, gl::uint32_t>, "count must be an unsigned 32-bit integer"        );
+            if (flags .count() < input.count()) throw std::invalid_argument{ "flags buffer is smaller than input" };
+            if (output.count() < input.count()) throw std::invalid_argument{ "output is smaller than input"       };
+            if (count .count() == 0u          ) throw std::invalid_argument{ "count buffer is empty"              };
+
+            if (input.count() == 0u)
+            {
+                clear_(count);
+                if (indirect) clear_(*indirect);
+                return;
+            }
+
+            auto& indices = reserve_(indices_, input.count());
+            scan_<gl::uint32_t>(flags, indices, input.count(), gl::false_, gl::true_);
+
+            auto& scatter = use_(source_<element_t>(compact_source_));
+            bind_(input  , 0u, gl::image_access_e::read_only);
+            bind_(flags  , 1u, gl::image_access_e::read_only);
+            bind_(indices, 2u, gl::image_access_e::read_only);
+            bind_(output , 3u);
+            bind_(count  , 4u);
+            if (indirect) bind_(*indirect, 5u);
+            scatter.upload(gl::index_t{ 0u }, static_cast<gl::uint32_t>(input.count()));
+            scatter.upload(gl::index_t{ 1u }, static_cast<gl::uint32_t>(local_size   ));
+            scatter.upload(gl::index_t{ 2u }, static_cast<gl::uint32_t>(indirect != nullptr));
+            gl::dispatch_compute(work_groups_(groups_(input.count())));
+        }
+        //Every pass counts the digits of each work group, scans the counts digit major and scatters the keys stably
+        //An odd number of passes leaves the result in the scratch buffers, it is copied back once at the end
+        void sort_(gl::buffer& keys, gl::buffer* values, gl::count_t key_bits)
+        {
+            if (key_bits == 0u || key_bits > 32u) throw std::invalid_argument{ "key bits must be between 1 and 32" };
+
+            auto const count       = keys.count();
+            if (count <= 1u) return;
+
+            auto const group_count = groups_(count);
+            auto const pass_count  = (key_bits + radix_bits_ - 1u) / radix_bits_;
+            auto&      histogram   = reserve_(histogram_, radix_size_ * group_count);
+            auto*      keys_in     = &keys;
+            auto*      keys_out    = static_cast<gl::buffer*>(&reserve_(keys_, count));
+            auto*      values_in   = values;
+            auto*      values_out  = values ? static_cast<gl::buffer*>(&reserve_(values_, count)) : nullptr;
+            auto const definitions = values ? std::string_view{ "#define HAS_VALUES\n" } : std::string_view{};
+
+            for (auto pass = gl::index_t{ 0u }; pass < pass_count; ++pass)
+            {
+                auto const shift = static_cast<gl::uint32_t>(pass * radix_bits_);
+
+                auto& digits = use_(source_<gl::uint32_t>(radix_count_source_));
+                bind_(*keys_in , 0u, gl::image_access_e::read_only);
+                bind_(histogram, 1u);
+                digits.upload(gl::index_t{ 0u }, static_cast<gl::uint32_t>(count      ));
+                digits.upload(gl::index_t{ 1u }, shift                                  );
+                digits.upload(gl::index_t{ 2u }, static_cast<gl::uint32_t>(group_count));
+                gl::dispatch_compute(work_groups_(group_count));
+
+                scan_<gl::uint32_t>(histogram, histogram, radix_size_ * group_count, gl::false_, gl::false_);
+
+                auto& scatter = use_(source_<gl::uint32_t>(radix_scatter_source_, definitions));
+                bind_(*keys_in  , 0u, gl::image_access_e::read_only);
+                if (values) bind_(*values_in, 1u, gl::image_access_e::read_only);
+                bind_(histogram , 2u, gl::image_access_e::read_only);
+                bind_(*keys_out , 3u);
+                if (values) bind_(*values_out, 4u);
+                scatter.upload(gl::index_t{ 0u }, static_cast<gl::uint32_t>(count      ));
+                scatter.upload(gl::index_t{ 1u }, shift                                  );
+                scatter.upload(gl::index_t{ 2u }, static_cast<gl::uint32_t>(group_count));
+                gl::dispatch_compute(work_groups_(group_count));
+
+                std::swap(keys_in  , keys_out  );
+                std::swap(values_in, values_out);
+            }
+            if (keys_in == &keys) return;
+
+            keys_in->require_barrier(gl::memory_barrier_e::buffer_update);
+            gl::copy_buffer_sub_data<gl::uint32_t>(keys_in->handle(), keys.handle(), gl::index_range{ 0u, count }, 0u);
+            if (!values) return;
+
+            values_in->require_barrier(gl::memory_barrier_e::buffer_update);
+            gl::copy_buffer_sub_data<gl::uint32_t>(values_in->handle(), values->handle(), gl::index_range{ 0u, count }, 0u);
+        }
+
+        gl::program_cache*                                     cache_;
+        std::unordered_map<std::string, kernel_>               kernels_;
+        std::deque<gl::static_buffer<gl::uint32_t>>            levels_;
+        std::optional<gl::static_buffer<gl::uint32_t>>         indices_;
+        std::optional<gl::static_buffer<gl::uint32_t>>         histogram_;
+        std::optional<gl::static_buffer<gl::uint32_t>>         keys_;
+        std::optional<gl::static_buffer<gl::uint32_t>>         values_;
+    };
+}
+export namespace gl::compute::reference
+{
+    //CPU versions of the primitives for checking their results, they follow the same rules as the kernels
+    //Floating point sums are accumulated in a different order on the GPU and only match within a tolerance
+    template<typename element_t>
+    auto exclusive_scan(std::span<element_t const> input) -> std::vector<element_t>
+    {
+        auto output = std::vector<element_t>(input.size());
+        std::exclusive_scan(input.begin(), input.end(), output.begin(), element_t{});
+
+        return output;
+    }
+    template<typename element_t>
+    auto inclusive_scan(std::span<element_t const> input) -> std::vector<element_t>
+    {
+        auto output = std::vector<element_t>(input.size());
+        std::inclusive_scan(input.begin(), input.end(), output.begin());
+
+        return output;
+    }
+    template<typename element_t>
+    auto reduce        (std::span<element_t const> input, gl::compute::operation_e operation = gl::compute::operation_e::sum) -> element_t
+    {
+        if (input.empty()) throw std::invalid_argument{ "cannot reduce an empty range" };
+
+        using enum gl::compute::operation_e;
+        switch (operation)
+        {
+            case sum    : return std::accumulate(input.begin(), input.end(), element_t{});
+            case minimum: return std::ranges::min(input);
+            case maximum: return std::ranges::max(input);
+
+            default: throw std::invalid_argument{ "invalid operation" };
+        }
+    }
+    template<typename element_t>
+    auto compact       (std::span<element_t const> input, std::span<gl::uint32_t const> flags) -> std::vector<element_t>
+    {
+        if (flags.size() < input.size()) throw std::invalid_argument{ "flags are smaller than input" };
+
+        auto output = std::vector<element_t>{};
+        for (auto index = gl::index_t{ 0u }; index < input.size(); ++index)
+        {
+            if (flags[index] != 0u) output.emplace_back(input[index]);
+        }
+
+        return output;
+    }
+    //Sorts stably on the low key bits only, like the radix sort with the same number of bits
+    template<typename value_t = gl::uint32_t>
+    void sort_pairs    (std::span<gl::uint32_t> keys, std::span<value_t> values, gl::count_t key_bits = 32u)
+    {
+        if (values.size() < keys.size()) throw std::invalid_argument{ "values are smaller than keys" };
+
+        auto const mask  = key_bits >= 32u ? ~gl::uint32_t{ 0u } : (gl::uint32_t{ 1u } << key_bits) - 1u;
+        auto       order = std::vector<gl::index_t>(keys.size());
+        std::iota(order.begin(), order.end(), gl::index_t{ 0u });
+        std::ranges::stable_sort(order, {}, [&](gl::index_t index) { return keys[index] & mask; });
+
+        auto const sorted_keys   = std::vector<gl::uint32_t>{ keys.begin(), keys.end() };
+        auto const sorted_values = std::vector<value_t     >{ values.begin(), values.begin() + static_cast<std::ptrdiff_t>(keys.size()) };
+        for (auto index = gl::index_t{ 0u }; index < order.size(); ++index)
+        {
+            keys  [index] = sorted_keys  [order[index]];
+            values[index] = sorted_values[order[index]];
+        }
+    }
+    template<typename element_t>
+    auto histogram     (std::span<element_t const> input, gl::count_t bin_count, gl::float32_t minimum, gl::float32_t maximum) -> std::vector<gl::uint32_t>
+    {
+        if (bin_count == 0u || !(minimum < maximum)) throw std::invalid_argument{ "invalid histogram range" };
+
+        auto const scale = static_cast<gl::float32_t>(bin_count) / (maximum - minimum);
+        auto       bins  = std::vector<gl::uint32_t>(bin_count);
+        for (auto const element : input)
+        {
+            auto const value = static_cast<gl::float32_t>(element);
+            if (value >= minimum && value < maximum) ++bins[std::min<gl::count_t>(static_cast<gl::count_t>((value - minimum) * scale), bin_count - 1u)];
+        }
+
+        return bins;
+    }
+}
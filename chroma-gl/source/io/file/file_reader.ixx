@@ -0,0 +1,174 @@
+export module chroma_gl:io.file_reader;
+
+import std;
+import opengl;
+
+export namespace gl::io
+{
+    //Reads a file front to back in fixed size chunks without holding more than a few of them in memory
+    //With read ahead a worker fills the next chunks while the current one is consumed, at the cost of copying out of the chunk
+    //Without read ahead, read places the file contents straight into the destination, e.g. a mapped stream or pixel unpack buffer
+    class file_reader
+    {
+    public:
+        explicit
+        file_reader(std::filesystem::path const& path, gl::size_t chunk_size = 4u * 1024u * 1024u, gl::count_t read_ahead = 2u)
+            : file_{ path, std::ios::binary }, size_{ 0u }, offset_{ 0u }, buffers_{}, sizes_{}, free_{}, filled_{}, current_{}, pending_{}
+            , is_finished_{ gl::false_ }, exception_{}, mutex_{}, condition_{}, worker_{}
+        {
+            if (!file_)            throw std::runtime_error    { "failed to open file"                 };
+            if (chunk_size == 0u) throw std::invalid_argument{ "chunk size must be greater than zero" };
+
+            size_ = std::filesystem::file_size(path);
+
+            auto const buffer_count = read_ahead == 0u ? gl::count_t{ 1u } : read_ahead + 1u;
+            buffers_.resize(buffer_count, std::vector<gl::byte_t>(chunk_size));
+            sizes_  .resize(buffer_count);
+            if (read_ahead == 0u) return;
+
+            for (auto index = gl::index_t{ 0u }; index < buffer_count; ++index) free_.emplace_back(index);
+            worker_ = std::jthread{ [this](std::stop_token stop_token) { read_ahead_(stop_token); } };
+        }
+
+        //Returns the rest of the current chunk or the next one, it stays valid until the reader is used again
+        //An empty span marks the end of the file
+        auto next() -> std::span<gl::byte_t const>
+        {
+            if (pending_.empty()) fetch_();
+
+            offset_ += pending_.size();
+            return std::exchange(pending_, {});
+        }
+        //Fills the destination and returns how many bytes were read, fewer than requested only at the end of the file
+        auto read(std::span<gl::byte_t> destination) -> gl::size_t
+        {
+            auto read_size = gl::size_t{ 0u };
+            while (read_size < destination.size())
+            {
+                if (pending_.empty() && !worker_.joinable())
+                {
+                    read_size += read_file_(destination.subspan(read_size));
+                    break;
+                }
+
+                if (pending_.empty()) fetch_();
+                if (pending_.empty()) break;
+
+                auto const count = std::min(pending_.size(), destination.size() - read_size);
+                std::memcpy(destination.data() + read_size, pending_.data(), count);
+                pending_   = pending_.subspan(count);
+                read_size += count;
+            }
+
+            offset_ += read_size;
+            return read_size;
+        }
+
+        auto size          () const -> gl::size_t
+        {
+            return size_;
+        }
+        auto offset        () const -> gl::size_t
+        {
+            return offset_;
+        }
+        auto is_end_of_file() const -> gl::bool_t
+        {
+            return offset_ >= size_;
+        }
+
+    private:
+        auto read_file_ (std::span<gl::byte_t> destination) -> gl::size_t
+        {
+            file_.read(reinterpret_cast<gl::char_t*>(destination.data()), static_cast<std::streamsize>(destination.size()));
+            if (file_.bad()) throw std::runtime_error{ "failed to read file" };
+
+            return static_cast<gl::size_t>(file_.gcount());
+        }
+        //Hands the current chunk back to the worker and waits for the next one, errors of the worker are rethrown here
+        void fetch_     ()
+        {
+            if (!worker_.joinable())
+            {
+                auto& buffer = buffers_.front();
+                pending_     = std::span<gl::byte_t const>{ buffer.data(), read_file_(buffer) };
+                return;
+            }
+
+            auto lock = std::unique_lock{ mutex_ };
+            if (current_)
+            {
+                free_.emplace_back(*std::exchange(current_, std::nullopt));
+                condition_.notify_all();
+            }
+
+            condition_.wait(lock, [this] { return !filled_.empty() || is_finished_; });
+            if (filled_.empty())
+            {
+                if (exception_) std::rethrow_exception(exception_);
+                return;
+            }
+
+            current_ = filled_.front();
+            filled_.pop_front();
+            pending_ = std::span<gl::byte_t const>{ buffers_.at(*current_).data(), sizes_.at(*current_) };
+        }
+        void read_ahead_(std::stop_token stop_token)
+        {
+            while (!stop_token.stop_requested())
+            {
+                auto index = gl::index_t{ 0u };
+                {
+                    auto lock = std::unique_lock{ mutex_ };
+                    if (!condition_.wait(lock, stop_token, [this] { return !free_.empty(); })) return;
+
+                    index = free_.front();
+                    free_.pop_front();
+                }
+
+                auto read_size = gl::size_t{ 0u };
+                auto exception = std::exception_ptr{};
+                try
+                {
+                    read_size = read_file_(buffers_.at(index));
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+
+                {
+                    auto const lock = std::scoped_lock{ mutex_ };
+                    if (read_size != 0u)
+                    {
+                        sizes_.at(index) = read_size;
+                        filled_.emplace_back(index);
+                    }
+                    else
+                    {
+                        is_finished_ = gl::true_;
+                        exception_   = exception;
+                    }
+                }
+                condition_.notify_all();
+
+                if (read_size == 0u) return;
+            }
+        }
+
+        std::ifstream                        file_;
+        gl::size_t                           size_;
+        gl::size_t                           offset_;
+        std::vector<std::vector<gl::byte_t>> buffers_;
+        std::vector<gl::size_t>              sizes_;
+        std::deque<gl::index_t>              free_;
+        std::deque<gl::index_t>              filled_;
+        std::optional<gl::index_t>           current_;
+        std::span<gl::byte_t const>          pending_;
+        gl::bool_t                           is_finished_;
+        std::exception_ptr                   exception_;
+        std::mutex                           mutex_;
+        std::condition_variable_any          condition_;
+        std::jthread                         worker_;
+    };
+}
@@ -0,0 +1,108 @@
+module;
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+export module chroma_gl:io.mapped_file;
+
+import std;
+import opengl;
+
+export namespace gl::io
+{
+    //Read-only view of a whole file mapped into the address space, pages are loaded by the kernel as they are touched
+    //The file is not copied into process memory, the view can be passed to uploads, decoders and shaders as is
+    //Handles are closed once the view is created, the view itself stays valid until the mapping is destroyed
+    class mapped_file
+    {
+    public:
+        explicit
+        mapped_file(std::filesystem::path const& path)
+            : memory_{}
+        {
+            auto const size = std::filesystem::file_size(path);
+            if (size == 0u) return;
+
+#if defined(_WIN32)
+            auto const file    = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file == INVALID_HANDLE_VALUE) throw std::runtime_error{ "failed to open file" };
+
+            auto const mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+            ::CloseHandle(file);
+            if (!mapping) throw std::runtime_error{ "failed to map file" };
+
+            auto const* view   = ::MapViewOfFile(mapping, FILE_MAP_READ, 0u, 0u, 0u);
+            ::CloseHandle(mapping);
+            if (!view) throw std::runtime_error{ "failed to map file" };
+#else
+            auto const file    = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (file == -1) throw std::runtime_error{ "failed to open file" };
+
+            auto* view         = ::mmap(nullptr, static_cast<::size_t>(size), PROT_READ, MAP_PRIVATE, file, 0);
+            ::close(file);
+            if (view == MAP_FAILED) throw std::runtime_error{ "failed to map file" };
+
+            ::madvise(view, static_cast<::size_t>(size), MADV_SEQUENTIAL);
+#endif
+
+            memory_ = std::span{ static_cast<gl::byte_t const*>(view), static_cast<gl::size_t>(size) };
+        }
+        mapped_file(mapped_file&& other) noexcept
+            : memory_{ std::exchange(other.memory_, {}) } {}
+       ~mapped_file()
+        {
+            release_();
+        }
+
+        auto data() const -> std::span<gl::byte_t const>
+        {
+            return memory_;
+        }
+        //Views the file as an array of elements, e.g. to create a static_buffer from it
+        template<typename element_t>
+        auto as  () const -> std::span<element_t const>
+        {
+            static_assert(std::is_trivially_copyable_v<element_t>, "element type must be trivially copyable");
+            if (memory_.size() % sizeof(element_t) != 0u) throw std::runtime_error{ "file size is not a multiple of the element size" };
+
+            return std::span{ reinterpret_cast<element_t const*>(memory_.data()), memory_.size() / sizeof(element_t) };
+        }
+        auto size() const -> gl::size_t
+        {
+            return memory_.size();
+        }
+
+        auto operator=(mapped_file&& other) noexcept -> mapped_file&
+        {
+            if (this != &other)
+            {
+                release_();
+                memory_ = std::exchange(other.memory_, {});
+            }
+
+            return *this;
+        }
+
+    private:
+        void release_()
+        {
+            if (memory_.empty()) return;
+
+#if defined(_WIN32)
+            ::UnmapViewOfFile(memory_.data());
+#else
+            ::munmap(const_cast<gl::byte_t*>(memory_.data()), memory_.size());
+#endif
+        }
+
+        std::span<gl::byte_t const> memory_;
+    };
+}
@@ -4,12 +4,26 @@ import std;
 import stb;
 import opengl;
 import :config;
+import :io.pixel;
 
 export namespace gl
 {
+    //Color spaces apply to the color channels, alpha is always linear
+    //Premultiplication happens in linear space, after the swizzle
+    struct image_conversion
+    {
+        gl::pixel::color_space_e source_color_space = gl::pixel::color_space_e::linear;
+        gl::pixel::color_space_e target_color_space = gl::pixel::color_space_e::linear;
+        gl::vector_4u            swizzle            = gl::vector_4u{ 0u, 1u, 2u, 3u };
+        gl::bool_t               premultiply_alpha  = gl::false_;
+    };
+
+    //Images own their pixels and hold no global state, decoding and processing may run on any number of threads without a context
     class image
     {
     public:
+        using color_space_e = gl::pixel::color_space_e;
+
         enum class format_e
         {
             r_uint8     , 
@@ -35,19 +49,30 @@ export namespace gl
             jpg, 
             png, 
         };
+        enum class filter_e
+        {
+            box   , 
+            kaiser, 
+        };
 
         template<std::ranges::range range_t>
         explicit image(format_e format, gl::vector_2u dimensions, range_t&& range)
             : format_{ format }, dimensions_{ dimensions }, data_{ std::from_range, std::forward<range_t>(range) } {}
 
+        //The flip is applied to a copy instead of through the process wide flag of stb
         template<extension_e extension_v>
         static auto encode(format_e format, gl::image const& image) -> auto
         {
-            stb::set_flip_vertically_on_write(config::flip_images_vertically);
-
             auto const channels   = map_channels(format);
             auto const dimensions = std::bit_cast<stb::vector_2u>(image.dimensions());
-            auto const memory     = image.data();
+            auto       flipped    = std::optional<gl::image>{};
+            auto       memory     = image.data();
+            if constexpr (config::flip_images_vertically)
+            {
+                flipped.emplace(image);
+                flipped->flip_vertically();
+                memory = flipped->data();
+            }
             
             using enum extension_e;
             if constexpr (extension_v == bmp) return stb::write_bmp(dimensions, channels, memory);
@@ -55,10 +80,9 @@ export namespace gl
             if constexpr (extension_v == jpg) return stb::write_jpg(dimensions, channels, memory);
             if constexpr (extension_v == png) return stb::write_png(dimensions, channels, memory);
         }
-        static auto decode(format_e format, std::span<gl::byte_t const> data) -> gl::image
+        //Half float formats are decoded to single precision and converted, the flip is applied per image
+        static auto decode(format_e format, std::span<gl::byte_t const> data, gl::bool_t vertical_flip = gl::config::flip_images_vertically) -> gl::image
         {
-            stb::set_flip_vertically_on_load(gl::config::flip_images_vertically);
-            
             auto const channels   = map_channels(format);
             auto const stb_image  = std::invoke([&](format_e format)
                 {
@@ -82,8 +106,67 @@ export namespace gl
                     };
                 }, format);
             auto const dimensions = std::bit_cast<gl::vector_2u>(stb_image.dimensions);
+            if (stb_image.memory.empty()) throw std::runtime_error{ "failed to decode image" };
+
+            auto image = gl::image{ format, dimensions, std::move(stb_image.memory) };
+            if      (format == format_e::rgb_float16 ) image = gl::image{ format_e::rgb_float32 , dimensions, std::move(image.data_) }.convert(format);
+            else if (format == format_e::rgba_float16) image = gl::image{ format_e::rgba_float32, dimensions, std::move(image.data_) }.convert(format);
+            if (vertical_flip) image.flip_vertically();
+
+            return image;
+        }
+
+        //Converts between any two formats row by row, missing color channels become zero and missing alpha becomes one
+        auto convert         (format_e format, gl::image_conversion const& conversion = {}) const -> gl::image
+        {
+            auto const is_transformed = conversion.source_color_space != conversion.target_color_space || conversion.premultiply_alpha;
+            auto const source_space   = is_transformed ? conversion.source_color_space : color_space_e::linear;
+            auto const target_space   = is_transformed ? conversion.target_color_space : color_space_e::linear;
+            auto const is_swizzled    = conversion.swizzle != gl::vector_4u{ 0u, 1u, 2u, 3u };
+
+            auto result = gl::image{ format, dimensions_, std::vector<gl::byte_t>(static_cast<gl::size_t>(dimensions_.y) * row_size_(format, dimensions_.x)) };
+            auto texels = std::vector<gl::float32_t>(static_cast<gl::size_t>(dimensions_.x) * 4u);
+            for (auto row = gl::size_t{ 0u }; row < dimensions_.y; ++row)
+            {
+                gl::pixel::expand(std::span{ data_ }.subspan(row * row_size(), row_size()), map_component_(format_), map_channels(format_), source_space, texels);
+                if (is_swizzled                 ) gl::pixel::swizzle          (texels, conversion.swizzle);
+                if (conversion.premultiply_alpha) gl::pixel::premultiply_alpha(texels);
+                gl::pixel::contract(texels, map_component_(format), map_channels(format), target_space, std::span{ result.data_ }.subspan(row * result.row_size(), result.row_size()));
+            }
+
+            return result;
+        }
+        void flip_vertically ()
+        {
+            gl::pixel::flip_vertically(data_, row_size());
+        }
+        //Returns the levels below this image down to 1x1 in its format, filtered in linear space
+        //sRGB images are decoded before and encoded after filtering so the levels keep their brightness
+        auto generate_mipmaps(filter_e filter = filter_e::box, color_space_e color_space = color_space_e::linear) const -> std::vector<gl::image>
+        {
+            auto const level_count = gl::mipmap_levels(dimensions_);
+            auto       source      = std::vector<gl::float32_t>(static_cast<gl::size_t>(dimensions_.x) * dimensions_.y * 4u);
+            auto       levels      = std::vector<gl::image>{};
+            levels.reserve(level_count - 1u);
+
+            gl::pixel::expand(data_, map_component_(format_), map_channels(format_), color_space, source);
+
+            auto source_dimensions = dimensions_;
+            for (auto level = gl::uint32_t{ 1u }; level < level_count; ++level)
+            {
+                auto const dimensions  = gl::vector_2u{ std::max(source_dimensions.x >> 1u, 1u), std::max(source_dimensions.y >> 1u, 1u) };
+                auto       destination = std::vector<gl::float32_t>(static_cast<gl::size_t>(dimensions.x) * dimensions.y * 4u);
+                if (filter == filter_e::box) gl::pixel::downsample_box   (source, source_dimensions, destination);
+                else                         gl::pixel::downsample_kaiser(source, source_dimensions, destination);
+
+                auto& image = levels.emplace_back(format_, dimensions, std::vector<gl::byte_t>(static_cast<gl::size_t>(dimensions.y) * row_size_(format_, dimensions.x)));
+                gl::pixel::contract(destination, map_component_(format_), map_channels(format_), color_space, image.data_);
 
-            return gl::image{ format, dimensions, std::move(stb_image.memory) };
+                source            = std::move(destination);
+                source_dimensions = dimensions;
+            }
+
+            return levels;
         }
 
         auto format    () const -> format_e
@@ -98,9 +181,32 @@ export namespace gl
         {
             return data_;
         }
+        auto row_size  () const -> gl::size_t
+        {
+            return row_size_(format_, dimensions_.x);
+        }
+        //Describes the pixels for texture uploads, e.g. upload(level, image.dimensions(), image.descriptor(), image.data())
+        auto descriptor() const -> gl::texture_data_descriptor
+        {
+            return descriptor(format_);
+        }
+        static auto descriptor(format_e format) -> gl::texture_data_descriptor
+        {
+            auto const base_format = std::array{ gl::texture_base_format_e::r, gl::texture_base_format_e::rg, gl::texture_base_format_e::rgb, gl::texture_base_format_e::rgba }.at(map_channels(format) - 1u);
+            switch (map_component_(format))
+            {
+                using enum gl::pixel::component_e;
+                case uint8  : return gl::texture_data_descriptor{ base_format, gl::pixel_data_type_e::uint8   };
+                case uint16 : return gl::texture_data_descriptor{ base_format, gl::pixel_data_type_e::uint16  };
+                case float16: return gl::texture_data_descriptor{ base_format, gl::pixel_data_type_e::float16 };
+                case float32: return gl::texture_data_descriptor{ base_format, gl::pixel_data_type_e::float32 };
+
+                default: throw std::invalid_argument{ "invalid format" };
+            }
+        }
 
     private:
-        static auto map_channels(format_e format) -> gl::uint32_t
+        static auto map_channels  (format_e format) -> gl::uint32_t
         {
             switch (format)
             {
@@ -121,6 +227,31 @@ export namespace gl
                 default: throw std::invalid_argument{ "invalid format" };
             }
         }
+        static auto map_component_(format_e format) -> gl::pixel::component_e
+        {
+            switch (format)
+            {
+                using enum format_e;
+                case r_uint8     : 
+                case rg_uint8    : 
+                case rgb_uint8   : 
+                case rgba_uint8  : return gl::pixel::component_e::uint8  ;
+                case r_uint16    : 
+                case rg_uint16   : 
+                case rgb_uint16  : 
+                case rgba_uint16 : return gl::pixel::component_e::uint16 ;
+                case rgb_float16 : 
+                case rgba_float16: return gl::pixel::component_e::float16;
+                case rgb_float32 : 
+                case rgba_float32: return gl::pixel::component_e::float32;
+
+                default: throw std::invalid_argument{ "invalid format" };
+            }
+        }
+        static auto row_size_     (format_e format, gl::uint32_t width) -> gl::size_t
+        {
+            return static_cast<gl::size_t>(width) * map_channels(format) * gl::pixel::component_size(map_component_(format));
+        }
 
         format_e                format_;
         gl::vector_2u           dimensions_;
@@ -0,0 +1,562 @@
+module;
+
+#if defined(__AVX2__)
+    #define PIXEL_AVX2
+    #include <immintrin.h>
+#endif
+#if defined(__AVX2__) && (defined(__F16C__) || defined(_MSC_VER))
+    #define PIXEL_F16C
+#endif
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    #define PIXEL_SSE2
+    #include <emmintrin.h>
+#endif
+
+export module chroma_gl:io.pixel;
+
+import std;
+import glm;
+import opengl;
+
+export namespace gl::pixel
+{
+    //Row kernels of the image pipeline, rows are expanded to RGBA float32 texels, processed, and contracted to their storage format
+    //Kernels use AVX2 or SSE2 when the target enables them and fall back to scalar code otherwise
+    //Kernels only touch the memory they are given, any number of threads may run them at once
+    enum class component_e
+    {
+        uint8  ,
+        uint16 ,
+        float16,
+        float32,
+    };
+    enum class color_space_e
+    {
+        linear,
+        srgb  ,
+    };
+
+    auto component_size(gl::pixel::component_e component) -> gl::size_t
+    {
+        switch (component)
+        {
+            using enum gl::pixel::component_e;
+            case uint8  : return gl::size_t{ 1u };
+            case uint16 :
+            case float16: return gl::size_t{ 2u };
+            case float32: return gl::size_t{ 4u };
+
+            default: throw std::invalid_argument{ "invalid component" };
+        }
+    }
+    auto srgb_to_linear(gl::float32_t value) -> gl::float32_t
+    {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+    auto linear_to_srgb(gl::float32_t value) -> gl::float32_t
+    {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+}
+namespace gl::pixel
+{
+    //Linear values of every 8-bit sRGB code
+    auto srgb_decode_table() -> std::array<gl::float32_t, 256u> const&
+    {
+        static auto const table = []
+            {
+                auto result = std::array<gl::float32_t, 256u>{};
+                for (auto index = gl::size_t{ 0u }; index < result.size(); ++index) result[index] = gl::pixel::srgb_to_linear(static_cast<gl::float32_t>(index) / 255.0f);
+                return result;
+            }();
+
+        return table;
+    }
+    //8-bit sRGB codes of linear values quantized to 16 bits, the quantization is finer than the smallest step between codes
+    auto srgb_encode_table() -> std::array<gl::uint8_t, 65536u> const&
+    {
+        static auto const table = []
+            {
+                auto result = std::array<gl::uint8_t, 65536u>{};
+                for (auto index = gl::size_t{ 0u }; index < result.size(); ++index) result[index] = static_cast<gl::uint8_t>(gl::pixel::linear_to_srgb(static_cast<gl::float32_t>(index) / 65535.0f) * 255.0f + 0.5f);
+                return result;
+            }();
+
+        return table;
+    }
+
+    auto load (std::span<gl::byte_t const> source, gl::pixel::component_e component, gl::size_t index) -> gl::float32_t
+    {
+        switch (component)
+        {
+            using enum gl::pixel::component_e;
+            case uint8  : return static_cast<gl::float32_t>(source[index]) / 255.0f;
+            case uint16 :
+            {
+                auto value = gl::uint16_t{};
+                std::memcpy(&value, source.data() + index * sizeof(value), sizeof(value));
+                return static_cast<gl::float32_t>(value) / 65535.0f;
+            }
+            case float16:
+            {
+                auto value = gl::uint16_t{};
+                std::memcpy(&value, source.data() + index * sizeof(value), sizeof(value));
+                return glm::unpackHalf1x16(value);
+            }
+            case float32:
+            {
+                auto value = gl::float32_t{};
+                std::memcpy(&value, source.data() + index * sizeof(value), sizeof(value));
+                return value;
+            }
+
+            default: throw std::invalid_argument{ "invalid component" };
+        }
+    }
+    void store(std::span<gl::byte_t> destination, gl::pixel::component_e component, gl::size_t index, gl::float32_t value)
+    {
+        switch (component)
+        {
+            using enum gl::pixel::component_e;
+            case uint8  : destination[index] = static_cast<gl::uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); break;
+            case uint16 :
+            {
+                auto const result = static_cast<gl::uint16_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+                std::memcpy(destination.data() + index * sizeof(result), &result, sizeof(result));
+                break;
+            }
+            case float16:
+            {
+                auto const result = static_cast<gl::uint16_t>(glm::packHalf1x16(value));
+                std::memcpy(destination.data() + index * sizeof(result), &result, sizeof(result));
+                break;
+            }
+            case float32: std::memcpy(destination.data() + index * sizeof(value), &value, sizeof(value)); break;
+
+            default: throw std::invalid_argument{ "invalid component" };
+        }
+    }
+
+    //Converts the leading four channel texels of a linear row, returns the number of components converted
+    auto expand_simd  (std::span<gl::byte_t const> source, gl::pixel::component_e component, std::span<gl::float32_t> texels) -> gl::size_t
+    {
+        auto index = gl::size_t{ 0u };
+
+        if (component == gl::pixel::component_e::float32)
+        {
+            std::memcpy(texels.data(), source.data(), texels.size_bytes());
+            return texels.size();
+        }
+
+#if defined(PIXEL_AVX2)
+        auto const* memory = source.data();
+        auto*       result = texels.data();
+        switch (component)
+        {
+            case gl::pixel::component_e::uint8  :
+            {
+                auto const scale = _mm256_set1_ps(1.0f / 255.0f);
+                for (; index + 8u <= texels.size(); index += 8u)
+                {
+                    auto const values = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(memory + index)));
+                    _mm256_storeu_ps(result + index, _mm256_mul_ps(_mm256_cvtepi32_ps(values), scale));
+                }
+                break;
+            }
+            case gl::pixel::component_e::uint16 :
+            {
+                auto const scale = _mm256_set1_ps(1.0f / 65535.0f);
+                for (; index + 8u <= texels.size(); index += 8u)
+                {
+                    auto const values = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(memory + index * 2u)));
+                    _mm256_storeu_ps(result + index, _mm256_mul_ps(_mm256_cvtepi32_ps(values), scale));
+                }
+                break;
+            }
+#if defined(PIXEL_F16C)
+            case gl::pixel::component_e::float16:
+            {
+                for (; index + 8u <= texels.size(); index += 8u)
+                {
+                    _mm256_storeu_ps(result + index, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(memory + index * 2u))));
+                }
+                break;
+            }
+#endif
+
+            default: break;
+        }
+#elif defined(PIXEL_SSE2)
+        auto const* memory = source.data();
+        auto*       result = texels.data();
+        auto const  zero   = _mm_setzero_si128();
+        switch (component)
+        {
+            case gl::pixel::component_e::uint8  :
+            {
+                auto const scale = _mm_set1_ps(1.0f / 255.0f);
+                for (; index + 4u <= texels.size(); index += 4u)
+                {
+                    auto bytes = gl::int32_t{};
+                    std::memcpy(&bytes, memory + index, sizeof(bytes));
+
+                    auto const values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+                    _mm_storeu_ps(result + index, _mm_mul_ps(_mm_cvtepi32_ps(values), scale));
+                }
+                break;
+            }
+            case gl::pixel::component_e::uint16 :
+            {
+                auto const scale = _mm_set1_ps(1.0f / 65535.0f);
+                for (; index + 4u <= texels.size(); index += 4u)
+                {
+                    auto const values = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(memory + index * 2u)), zero);
+                    _mm_storeu_ps(result + index, _mm_mul_ps(_mm_cvtepi32_ps(values), scale));
+                }
+                break;
+            }
+
+            default: break;
+        }
+#endif
+
+        return index;
+    }
+    auto contract_simd(std::span<gl::float32_t const> texels, gl::pixel::component_e component, std::span<gl::byte_t> destination) -> gl::size_t
+    {
+        auto index = gl::size_t{ 0u };
+
+        if (component == gl::pixel::component_e::float32)
+        {
+            std::memcpy(destination.data(), texels.data(), texels.size_bytes());
+            return texels.size();
+        }
+
+#if defined(PIXEL_AVX2)
+        auto const* memory = texels.data();
+        auto*       result = destination.data();
+        auto const  zero   = _mm256_setzero_ps();
+        auto const  one    = _mm256_set1_ps(1.0f);
+        auto const  half   = _mm256_set1_ps(0.5f);
+        switch (component)
+        {
+            case gl::pixel::component_e::uint8  :
+            {
+                auto const scale = _mm256_set1_ps(255.0f);
+                for (; index + 8u <= texels.size(); index += 8u)
+                {
+                    auto const values = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(memory + index), zero), one), scale), half));
+                    auto const words  = _mm_packs_epi32 (_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(result + index), _mm_packus_epi16(words, words));
+                }
+                break;
+            }
+            case gl::pixel::component_e::uint16 :
+            {
+                auto const scale = _mm256_set1_ps(65535.0f);
+                for (; index + 8u <= texels.size(); index += 8u)
+                {
+                    auto const values = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(memory + index), zero), one), scale), half));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(result + index * 2u), _mm_packus_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1)));
+                }
+                break;
+            }
+#if defined(PIXEL_F16C)
+            case gl::pixel::component_e::float16:
+            {
+                for (; index + 8u <= texels.size(); index += 8u)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(result + index * 2u), _mm256_cvtps_ph(_mm256_loadu_ps(memory + index), _MM_FROUND_TO_NEAREST_INT));
+                }
+                break;
+            }
+#endif
+
+            default: break;
+        }
+#elif defined(PIXEL_SSE2)
+        auto const* memory = texels.data();
+        auto*       result = destination.data();
+        auto const  zero   = _mm_setzero_ps();
+        auto const  one    = _mm_set1_ps(1.0f);
+        auto const  half   = _mm_set1_ps(0.5f);
+        switch (component)
+        {
+            case gl::pixel::component_e::uint8  :
+            {
+                auto const scale = _mm_set1_ps(255.0f);
+                for (; index + 4u <= texels.size(); index += 4u)
+                {
+                    auto const values = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(memory + index), zero), one), scale), half));
+                    auto const words  = _mm_packs_epi32(values, values);
+                    auto const bytes  = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+                    std::memcpy(result + index, &bytes, sizeof(bytes));
+                }
+                break;
+            }
+            case gl::pixel::component_e::uint16 :
+            {
+                //SSE2 has no unsigned 32 to 16 bit pack, the values are biased into the signed range and back
+                auto const scale = _mm_set1_ps(65535.0f);
+                auto const bias  = _mm_set1_epi32(32768);
+                auto const flip  = _mm_set1_epi16(static_cast<gl::int16_t>(0x8000));
+                for (; index + 4u <= texels.size(); index += 4u)
+                {
+                    auto const values = _mm_sub_epi32(_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(memory + index), zero), one), scale), half)), bias);
+                    _mm_storel_epi64(reinterpret_cast<__m128i*>(result + index * 2u), _mm_xor_si128(_mm_packs_epi32(values, values), flip));
+                }
+                break;
+            }
+
+            default: break;
+        }
+#endif
+
+        return index;
+    }
+
+    //Windowed sinc taps of one axis, each destination texel weighs taps_per_texel source texels starting at its first index
+    struct filter_taps
+    {
+        std::vector<gl::int64_t>   first          = {};
+        std::vector<gl::float32_t> weights        = {};
+        gl::size_t                 taps_per_texel = 0u;
+    };
+    auto kaiser_taps(gl::uint32_t source_size, gl::uint32_t destination_size) -> gl::pixel::filter_taps
+    {
+        auto constexpr radius = 3.0;
+        auto constexpr beta   = 4.0;
+        auto const     bessel = [](gl::float64_t value)
+            {
+                auto sum  = 1.0;
+                auto term = 1.0;
+                for (auto index = 1; index < 32; ++index)
+                {
+                    term *= (value / (2.0 * index)) * (value / (2.0 * index));
+                    sum  += term;
+                }
+
+                return sum;
+            };
+        auto const     weight = [&](gl::float64_t distance)
+            {
+                if (std::abs(distance) >= radius) return 0.0;
+
+                auto const sinc   = distance == 0.0 ? 1.0 : std::sin(std::numbers::pi * distance) / (std::numbers::pi * distance);
+                auto const window = bessel(beta * std::sqrt(1.0 - (distance / radius) * (distance / radius))) / bessel(beta);
+                return sinc * window;
+            };
+
+        auto const scale   = static_cast<gl::float64_t>(source_size) / static_cast<gl::float64_t>(destination_size);
+        auto const support = radius * scale;
+        auto       taps    = gl::pixel::filter_taps{};
+        taps.taps_per_texel = static_cast<gl::size_t>(std::ceil(support * 2.0)) + 1u;
+        taps.first  .resize(destination_size);
+        taps.weights.resize(destination_size * taps.taps_per_texel);
+
+        for (auto texel = gl::size_t{ 0u }; texel < destination_size; ++texel)
+        {
+            auto const center  = (static_cast<gl::float64_t>(texel) + 0.5) * scale;
+            auto const first   = static_cast<gl::int64_t>(std::floor(center - support));
+            auto const weights = std::span{ taps.weights }.subspan(texel * taps.taps_per_texel, taps.taps_per_texel);
+            auto       sum     = 0.0;
+            for (auto tap = gl::size_t{ 0u }; tap < taps.taps_per_texel; ++tap)
+            {
+                auto const value = weight((static_cast<gl::float64_t>(first + static_cast<gl::int64_t>(tap)) + 0.5 - center) / scale);
+                weights[tap] = static_cast<gl::float32_t>(value);
+                sum         += value;
+            }
+
+            std::ranges::for_each(weights, [&](gl::float32_t& value) { value = static_cast<gl::float32_t>(value / sum); });
+            taps.first[texel] = first;
+        }
+
+        return taps;
+    }
+    //Adds the weighted texel to the accumulated texel
+    void accumulate(gl::float32_t* accumulator, gl::float32_t const* texel, gl::float32_t weight)
+    {
+#if defined(PIXEL_SSE2)
+        _mm_storeu_ps(accumulator, _mm_add_ps(_mm_loadu_ps(accumulator), _mm_mul_ps(_mm_loadu_ps(texel), _mm_set1_ps(weight))));
+#else
+        for (auto channel = gl::size_t{ 0u }; channel < 4u; ++channel) accumulator[channel] += texel[channel] * weight;
+#endif
+    }
+}
+export namespace gl::pixel
+{
+    //Expands a row of texels with the given number of channels to RGBA, missing color channels are zero and missing alpha is one
+    //sRGB color channels are decoded to linear, alpha is always linear
+    void expand           (std::span<gl::byte_t const> source, gl::pixel::component_e component, gl::uint32_t channels, gl::pixel::color_space_e color_space, std::span<gl::float32_t> texels)
+    {
+        auto const count = texels.size() / 4u;
+        if (channels == 0u || channels > 4u)                                      throw std::invalid_argument{ "invalid channel count"                  };
+        if (source.size() < count * channels * gl::pixel::component_size(component)) throw std::invalid_argument{ "source row is smaller than the texel row" };
+
+        auto index = gl::size_t{ 0u };
+        if (channels == 4u && color_space == gl::pixel::color_space_e::linear) index = gl::pixel::expand_simd(source, component, texels.first(count * 4u)) / 4u;
+
+        auto const  is_srgb = color_space == gl::pixel::color_space_e::srgb;
+        auto const& table   = gl::pixel::srgb_decode_table();
+        for (; index < count; ++index)
+        {
+            for (auto channel = gl::uint32_t{ 0u }; channel < 4u; ++channel)
+            {
+                auto& texel = texels[index * 4u + channel];
+                if (channel >= channels)
+                {
+                    texel = channel == 3u ? 1.0f : 0.0f;
+                    continue;
+                }
+
+                auto const offset = index * channels + channel;
+                if      (!is_srgb || channel == 3u)                       texel = gl::pixel::load(source, component, offset);
+                else if (component == gl::pixel::component_e::uint8)      texel = table[source[offset]];
+                else                                                      texel = gl::pixel::srgb_to_linear(gl::pixel::load(source, component, offset));
+            }
+        }
+    }
+    //Contracts a row of RGBA texels to the given number of channels, normalized components are clamped and rounded
+    void contract         (std::span<gl::float32_t const> texels, gl::pixel::component_e component, gl::uint32_t channels, gl::pixel::color_space_e color_space, std::span<gl::byte_t> destination)
+    {
+        auto const count = texels.size() / 4u;
+        if (channels == 0u || channels > 4u)                                           throw std::invalid_argument{ "invalid channel count"                       };
+        if (destination.size() < count * channels * gl::pixel::component_size(component)) throw std::invalid_argument{ "destination row is smaller than the texel row" };
+
+        auto index = gl::size_t{ 0u };
+        if (channels == 4u && color_space == gl::pixel::color_space_e::linear) index = gl::pixel::contract_simd(texels.first(count * 4u), component, destination) / 4u;
+
+        auto const  is_srgb = color_space == gl::pixel::color_space_e::srgb;
+        auto const& table   = gl::pixel::srgb_encode_table();
+        for (; index < count; ++index)
+        {
+            for (auto channel = gl::uint32_t{ 0u }; channel < channels; ++channel)
+            {
+                auto const texel  = texels[index * 4u + channel];
+                auto const offset = index * channels + channel;
+                if      (!is_srgb || channel == 3u)                       gl::pixel::store(destination, component, offset, texel);
+                else if (component == gl::pixel::component_e::uint8)      destination[offset] = table[static_cast<gl::size_t>(std::clamp(texel, 0.0f, 1.0f) * 65535.0f + 0.5f)];
+                else                                                      gl::pixel::store(destination, component, offset, gl::pixel::linear_to_srgb(std::max(texel, 0.0f)));
+            }
+        }
+    }
+
+    //Each channel of the result selects a channel of the texel, e.g. { 2, 1, 0, 3 } swaps red and blue
+    void swizzle          (std::span<gl::float32_t> texels, gl::vector_4u swizzle)
+    {
+        if (swizzle.x > 3u || swizzle.y > 3u || swizzle.z > 3u || swizzle.w > 3u) throw std::invalid_argument{ "invalid swizzle channel" };
+
+        for (auto index = gl::size_t{ 0u }; index + 4u <= texels.size(); index += 4u)
+        {
+            auto const texel = std::array{ texels[index], texels[index + 1u], texels[index + 2u], texels[index + 3u] };
+            texels[index     ] = texel[swizzle.x];
+            texels[index + 1u] = texel[swizzle.y];
+            texels[index + 2u] = texel[swizzle.z];
+            texels[index + 3u] = texel[swizzle.w];
+        }
+    }
+    //Expects linear texels
+    void premultiply_alpha(std::span<gl::float32_t> texels)
+    {
+        auto index = gl::size_t{ 0u };
+
+#if defined(PIXEL_SSE2)
+        auto const color_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        for (; index + 4u <= texels.size(); index += 4u)
+        {
+            auto const texel = _mm_loadu_ps(texels.data() + index);
+            auto const alpha = _mm_shuffle_ps(texel, texel, _MM_SHUFFLE(3, 3, 3, 3));
+            _mm_storeu_ps(texels.data() + index, _mm_or_ps(_mm_and_ps(color_mask, _mm_mul_ps(texel, alpha)), _mm_andnot_ps(color_mask, texel)));
+        }
+#endif
+
+        for (; index + 4u <= texels.size(); index += 4u)
+        {
+            auto const alpha = texels[index + 3u];
+            texels[index     ] *= alpha;
+            texels[index + 1u] *= alpha;
+            texels[index + 2u] *= alpha;
+        }
+    }
+    void flip_vertically  (std::span<gl::byte_t> memory, gl::size_t row_size)
+    {
+        if (row_size == 0u || memory.size() % row_size != 0u) throw std::invalid_argument{ "memory is not a whole number of rows" };
+        if (memory.empty()) return;
+
+        auto const row_count = memory.size() / row_size;
+        for (auto top = gl::size_t{ 0u }, bottom = row_count - 1u; top < bottom; ++top, --bottom)
+        {
+            std::swap_ranges(memory.begin() + top * row_size, memory.begin() + (top + 1u) * row_size, memory.begin() + bottom * row_size);
+        }
+    }
+
+    //2x2 box filter of RGBA texels, odd edges repeat their last texel
+    void downsample_box   (std::span<gl::float32_t const> source, gl::vector_2u source_dimensions, std::span<gl::float32_t> destination)
+    {
+        auto const dimensions = gl::vector_2u{ std::max(source_dimensions.x >> 1u, 1u), std::max(source_dimensions.y >> 1u, 1u) };
+        if (source.size() < static_cast<gl::size_t>(source_dimensions.x) * source_dimensions.y * 4u || destination.size() < static_cast<gl::size_t>(dimensions.x) * dimensions.y * 4u) throw std::invalid_argument{ "texel memory is smaller than the dimensions" };
+
+        auto const texel = [&](gl::uint32_t x, gl::uint32_t y)
+            {
+                return source.data() + (static_cast<gl::size_t>(std::min(y, source_dimensions.y - 1u)) * source_dimensions.x + std::min(x, source_dimensions.x - 1u)) * 4u;
+            };
+
+        for (auto y = gl::uint32_t{ 0u }; y < dimensions.y; ++y)
+        {
+            for (auto x = gl::uint32_t{ 0u }; x < dimensions.x; ++x)
+            {
+                auto const* texel_00 = texel(2u * x     , 2u * y     );
+                auto const* texel_10 = texel(2u * x + 1u, 2u * y     );
+                auto const* texel_01 = texel(2u * x     , 2u * y + 1u);
+                auto const* texel_11 = texel(2u * x + 1u, 2u * y + 1u);
+                auto*       result   = destination.data() + (static_cast<gl::size_t>(y) * dimensions.x + x) * 4u;
+
+#if defined(PIXEL_SSE2)
+                auto const sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(texel_00), _mm_loadu_ps(texel_10)), _mm_add_ps(_mm_loadu_ps(texel_01), _mm_loadu_ps(texel_11)));
+                _mm_storeu_ps(result, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+                for (auto channel = gl::size_t{ 0u }; channel < 4u; ++channel) result[channel] = (texel_00[channel] + texel_10[channel] + texel_01[channel] + texel_11[channel]) * 0.25f;
+#endif
+            }
+        }
+    }
+    //Separable Kaiser windowed sinc of RGBA texels, sharper than the box filter at the cost of slight ringing
+    void downsample_kaiser(std::span<gl::float32_t const> source, gl::vector_2u source_dimensions, std::span<gl::float32_t> destination)
+    {
+        auto const dimensions = gl::vector_2u{ std::max(source_dimensions.x >> 1u, 1u), std::max(source_dimensions.y >> 1u, 1u) };
+        if (source.size() < static_cast<gl::size_t>(source_dimensions.x) * source_dimensions.y * 4u || destination.size() < static_cast<gl::size_t>(dimensions.x) * dimensions.y * 4u) throw std::invalid_argument{ "texel memory is smaller than the dimensions" };
+
+        auto const horizontal   = gl::pixel::kaiser_taps(source_dimensions.x, dimensions.x);
+        auto const vertical     = gl::pixel::kaiser_taps(source_dimensions.y, dimensions.y);
+        auto       intermediate = std::vector<gl::float32_t>(static_cast<gl::size_t>(dimensions.x) * source_dimensions.y * 4u);
+        auto const clamp        = [](gl::int64_t index, gl::uint32_t size) { return static_cast<gl::size_t>(std::clamp<gl::int64_t>(index, 0, static_cast<gl::int64_t>(size) - 1)); };
+
+        for (auto y = gl::size_t{ 0u }; y < source_dimensions.y; ++y)
+        {
+            auto const* row = source.data() + y * source_dimensions.x * 4u;
+            for (auto x = gl::size_t{ 0u }; x < dimensions.x; ++x)
+            {
+                auto* result = intermediate.data() + (y * dimensions.x + x) * 4u;
+                for (auto tap = gl::size_t{ 0u }; tap < horizontal.taps_per_texel; ++tap)
+                {
+                    auto const weight = horizontal.weights[x * horizontal.taps_per_texel + tap];
+                    if (weight != 0.0f) gl::pixel::accumulate(result, row + clamp(horizontal.first[x] + static_cast<gl::int64_t>(tap), source_dimensions.x) * 4u, weight);
+                }
+            }
+        }
+
+        std::ranges::fill(destination.first(static_cast<gl::size_t>(dimensions.x) * dimensions.y * 4u), 0.0f);
+        for (auto y = gl::size_t{ 0u }; y < dimensions.y; ++y)
+        {
+            auto* result = destination.data() + y * dimensions.x * 4u;
+            for (auto tap = gl::size_t{ 0u }; tap < vertical.taps_per_texel; ++tap)
+            {
+                auto const  weight = vertical.weights[y * vertical.taps_per_texel + tap];
+                auto const* row    = intermediate.data() + clamp(vertical.first[y] + static_cast<gl::int64_t>(tap), source_dimensions.y) * dimensions.x * 4u;
+                if (weight == 0.0f) continue;
+
+                for (auto x = gl::size_t{ 0u }; x < dimensions.x; ++x) gl::pixel::accumulate(result + x * 4u, row + x * 4u, weight);
+            }
+        }
+    }
+}
@@ -0,0 +1,265 @@
+export module chroma_gl:io.texture_container;
+
+import std;
+import glm;
+import opengl;
+
+export namespace gl::io
+{
+    //Parses the level, layer and face tables of a KTX2 or DDS container of block compressed images
+    //Images are views into the container memory, nothing is copied, the memory has to outlive the container
+    //Parsing a mapped_file only touches the headers, the blocks are read when the driver copies them
+    class texture_container
+    {
+    public:
+        using format_e = gl::texture_compressed_format_e;
+
+        explicit
+        texture_container(std::span<gl::byte_t const> memory)
+            : format_{}, dimensions_{}, level_count_{ 1u }, layer_count_{ 1u }, face_count_{ 1u }, images_{}
+        {
+            if      (has_identifier_(memory, ktx2_identifier_)) parse_ktx2_(memory);
+            else if (has_identifier_(memory, dds_identifier_ )) parse_dds_ (memory);
+            else throw std::runtime_error{ "unrecognized texture container" };
+        }
+
+        //Faces are ordered +X, -X, +Y, -Y, +Z, -Z, matching the cubemap faces
+        auto image           (gl::uint32_t level, gl::uint32_t layer = 0u, gl::uint32_t face = 0u) const -> std::span<gl::byte_t const>
+        {
+            if (level >= level_count_ || layer >= layer_count_ || face >= face_count_) throw std::out_of_range{ "image index out of range" };
+
+            return images_.at((static_cast<gl::size_t>(level) * layer_count_ + layer) * face_count_ + face);
+        }
+        auto level_dimensions(gl::uint32_t level) const -> gl::vector_2u
+        {
+            return glm::max(dimensions_ >> level, gl::vector_2u{ 1u });
+        }
+
+        auto format          () const -> format_e
+        {
+            return format_;
+        }
+        auto dimensions      () const -> gl::vector_2u
+        {
+            return dimensions_;
+        }
+        auto level_count     () const -> gl::uint32_t
+        {
+            return level_count_;
+        }
+        auto layer_count     () const -> gl::uint32_t
+        {
+            return layer_count_;
+        }
+        auto face_count      () const -> gl::uint32_t
+        {
+            return face_count_;
+        }
+        auto is_cubemap      () const -> gl::bool_t
+        {
+            return face_count_ == 6u;
+        }
+        auto is_array        () const -> gl::bool_t
+        {
+            return layer_count_ > 1u;
+        }
+
+    private:
+        static auto constexpr ktx2_identifier_ = std::array<gl::byte_t, 12u>{ 0xABu, 0x4Bu, 0x54u, 0x58u, 0x20u, 0x32u, 0x30u, 0xBBu, 0x0Du, 0x0Au, 0x1Au, 0x0Au };
+        static auto constexpr dds_identifier_  = std::array<gl::byte_t,  4u>{ 0x44u, 0x44u, 0x53u, 0x20u };
+
+        static auto constexpr four_cc_(std::string_view code) -> gl::uint32_t
+        {
+            return static_cast<gl::uint32_t>(code[0]) | (static_cast<gl::uint32_t>(code[1]) << 8u) | (static_cast<gl::uint32_t>(code[2]) << 16u) | (static_cast<gl::uint32_t>(code[3]) << 24u);
+        }
+        static auto has_identifier_(std::span<gl::byte_t const> memory, std::span<gl::byte_t const> identifier) -> gl::bool_t
+        {
+            return memory.size() >= identifier.size() && std::ranges::equal(memory.first(identifier.size()), identifier);
+        }
+        //Fields are little endian and not necessarily aligned
+        template<typename value_t>
+        static auto read_          (std::span<gl::byte_t const> memory, gl::size_t offset) -> value_t
+        {
+            if (offset + sizeof(value_t) > memory.size()) throw std::runtime_error{ "texture container is truncated" };
+
+            auto value = value_t{};
+            std::memcpy(&value, memory.data() + offset, sizeof(value_t));
+            return value;
+        }
+        static auto view_          (std::span<gl::byte_t const> memory, gl::size_t offset, gl::size_t size) -> std::span<gl::byte_t const>
+        {
+            if (offset > memory.size() || size > memory.size() - offset) throw std::runtime_error{ "texture container is truncated" };
+
+            return memory.subspan(offset, size);
+        }
+
+        //BC1 and BC4 store a 4x4 block in 8 bytes, the other formats use 16 bytes
+        auto image_size_(gl::uint32_t level) const -> gl::size_t
+        {
+            auto const dimensions = level_dimensions(level);
+            auto const blocks     = (dimensions + gl::vector_2u{ 3u }) / gl::vector_2u{ 4u };
+            auto       block_size = gl::size_t{ 16u };
+
+            switch (format_)
+            {
+                case format_e::rgb_s3tc_dxt1  :
+                case format_e::rgba_s3tc_dxt1 :
+                case format_e::srgb_s3tc_dxt1 :
+                case format_e::srgba_s3tc_dxt1:
+                case format_e::r_rgtc1        :
+                case format_e::r_rgtc1_n      : block_size = 8u; break;
+
+                default: break;
+            }
+
+            return static_cast<gl::size_t>(blocks.x) * blocks.y * block_size;
+        }
+        void validate_()
+        {
+            if (dimensions_.x == 0u || dimensions_.y == 0u)          throw std::runtime_error{ "texture container has no dimensions"                         };
+            if (face_count_ != 1u && face_count_ != 6u)              throw std::runtime_error{ "texture container has an invalid face count"                 };
+            if (face_count_ == 6u && dimensions_.x != dimensions_.y) throw std::runtime_error{ "cubemap faces are not square"                                };
+            if (level_count_ > gl::mipmap_levels(dimensions_))       throw std::runtime_error{ "texture container has more levels than its dimensions allow" };
+
+            images_.resize(static_cast<gl::size_t>(level_count_) * layer_count_ * face_count_);
+        }
+
+        //Levels are stored from largest to smallest, each level holds its layers, each layer its faces
+        void parse_ktx2_(std::span<gl::byte_t const> memory)
+        {
+            auto const vk_format         = read_<gl::uint32_t>(memory, 12u);
+            auto const pixel_depth       = read_<gl::uint32_t>(memory, 28u);
+            auto const supercompression  = read_<gl::uint32_t>(memory, 44u);
+            dimensions_                  = gl::vector_2u{ read_<gl::uint32_t>(memory, 20u), read_<gl::uint32_t>(memory, 24u) };
+            layer_count_                 = std::max(read_<gl::uint32_t>(memory, 32u), 1u);
+            face_count_                  =          read_<gl::uint32_t>(memory, 36u);
+            level_count_                 = std::max(read_<gl::uint32_t>(memory, 40u), 1u);
+
+            if (pixel_depth      != 0u) throw std::runtime_error{ "volume texture containers are not supported"        };
+            if (supercompression != 0u) throw std::runtime_error{ "supercompressed texture containers are not supported" };
+
+            switch (vk_format)
+            {
+                case 131u: format_ = format_e::rgb_s3tc_dxt1  ; break;
+                case 132u: format_ = format_e::srgb_s3tc_dxt1 ; break;
+                case 133u: format_ = format_e::rgba_s3tc_dxt1 ; break;
+                case 134u: format_ = format_e::srgba_s3tc_dxt1; break;
+                case 135u: format_ = format_e::rgba_s3tc_dxt3 ; break;
+                case 136u: format_ = format_e::srgba_s3tc_dxt3; break;
+                case 137u: format_ = format_e::rgba_s3tc_dxt5 ; break;
+                case 138u: format_ = format_e::srgba_s3tc_dxt5; break;
+                case 139u: format_ = format_e::r_rgtc1        ; break;
+                case 140u: format_ = format_e::r_rgtc1_n      ; break;
+                case 141u: format_ = format_e::rg_rgtc2       ; break;
+                case 142u: format_ = format_e::rg_rgtc2_n     ; break;
+                case 143u: format_ = format_e::rgb_bptc_ufloat; break;
+                case 144u: format_ = format_e::rgb_bptc_float ; break;
+                case 145u: format_ = format_e::rgba_bptc      ; break;
+                case 146u: format_ = format_e::srgba_bptc     ; break;
+
+                default: throw std::runtime_error{ "texture container format is not block compressed" };
+            }
+
+            validate_();
+
+            for (auto level = gl::uint32_t{ 0u }; level < level_count_; ++level)
+            {
+                auto const entry       = gl::size_t{ 80u } + level * gl::size_t{ 24u };
+                auto const level_data  = view_(memory, read_<gl::uint64_t>(memory, entry), read_<gl::uint64_t>(memory, entry + 8u));
+                auto const image_size  = image_size_(level);
+                if (level_data.size() < image_size * layer_count_ * face_count_) throw std::runtime_error{ "texture container level is truncated" };
+
+                for (auto image = gl::size_t{ 0u }; image < static_cast<gl::size_t>(layer_count_) * face_count_; ++image)
+                {
+                    images_.at(level * static_cast<gl::size_t>(layer_count_) * face_count_ + image) = level_data.subspan(image * image_size, image_size);
+                }
+            }
+        }
+        //Each layer holds its faces, each face its levels from largest to smallest
+        void parse_dds_ (std::span<gl::byte_t const> memory)
+        {
+            auto const flags            = read_<gl::uint32_t>(memory,   8u);
+            auto const pixel_flags      = read_<gl::uint32_t>(memory,  80u);
+            auto const four_cc          = read_<gl::uint32_t>(memory,  84u);
+            auto const capabilities     = read_<gl::uint32_t>(memory, 112u);
+            auto       offset           = gl::size_t{ 128u };
+            dimensions_                 = gl::vector_2u{ read_<gl::uint32_t>(memory, 16u), read_<gl::uint32_t>(memory, 12u) };
+            level_count_                = (flags & 0x20000u) ? std::max(read_<gl::uint32_t>(memory, 28u), 1u) : 1u;
+
+            if (read_<gl::uint32_t>(memory, 4u) != 124u) throw std::runtime_error{ "invalid dds header size"                             };
+            if (!(pixel_flags & 0x4u))                   throw std::runtime_error{ "texture container format is not block compressed" };
+            if (capabilities & 0x200000u)                throw std::runtime_error{ "volume texture containers are not supported"       };
+
+            if (four_cc == four_cc_("DX10"))
+            {
+                auto const dxgi_format        = read_<gl::uint32_t>(memory, 128u);
+                auto const resource_dimension = read_<gl::uint32_t>(memory, 132u);
+                auto const miscellaneous      = read_<gl::uint32_t>(memory, 136u);
+                offset                        = gl::size_t{ 148u };
+                layer_count_                  = std::max(read_<gl::uint32_t>(memory, 140u), 1u);
+                face_count_                   = (miscellaneous & 0x4u) ? 6u : 1u;
+
+                if (resource_dimension != 3u) throw std::runtime_error{ "only two dimensional texture containers are supported" };
+
+                switch (dxgi_format)
+                {
+                    case 71u: format_ = format_e::rgba_s3tc_dxt1 ; break;
+                    case 72u: format_ = format_e::srgba_s3tc_dxt1; break;
+                    case 74u: format_ = format_e::rgba_s3tc_dxt3 ; break;
+                    case 75u: format_ = format_e::srgba_s3tc_dxt3; break;
+                    case 77u: format_ = format_e::rgba_s3tc_dxt5 ; break;
+                    case 78u: format_ = format_e::srgba_s3tc_dxt5; break;
+                    case 80u: format_ = format_e::r_rgtc1        ; break;
+                    case 81u: format_ = format_e::r_rgtc1_n      ; break;
+                    case 83u: format_ = format_e::rg_rgtc2       ; break;
+                    case 84u: format_ = format_e::rg_rgtc2_n     ; break;
+                    case 95u: format_ = format_e::rgb_bptc_ufloat; break;
+                    case 96u: format_ = format_e::rgb_bptc_float ; break;
+                    case 98u: format_ = format_e::rgba_bptc      ; break;
+                    case 99u: format_ = format_e::srgba_bptc     ; break;
+
+                    default: throw std::runtime_error{ "texture container format is not block compressed" };
+                }
+            }
+            else
+            {
+                if      (four_cc == four_cc_("DXT1"))                                format_ = format_e::rgba_s3tc_dxt1;
+                else if (four_cc == four_cc_("DXT3"))                                format_ = format_e::rgba_s3tc_dxt3;
+                else if (four_cc == four_cc_("DXT5"))                                format_ = format_e::rgba_s3tc_dxt5;
+                else if (four_cc == four_cc_("ATI1") || four_cc == four_cc_("BC4U")) format_ = format_e::r_rgtc1       ;
+                else if (four_cc == four_cc_("BC4S"))                                format_ = format_e::r_rgtc1_n     ;
+                else if (four_cc == four_cc_("ATI2") || four_cc == four_cc_("BC5U")) format_ = format_e::rg_rgtc2      ;
+                else if (four_cc == four_cc_("BC5S"))                                format_ = format_e::rg_rgtc2_n    ;
+                else throw std::runtime_error{ "texture container format is not block compressed" };
+
+                if (capabilities & 0x200u)
+                {
+                    if ((capabilities & 0xFC00u) != 0xFC00u) throw std::runtime_error{ "cubemap containers have to store every face" };
+                    face_count_ = 6u;
+                }
+            }
+
+            validate_();
+
+            for (auto layer = gl::uint32_t{ 0u }; layer < layer_count_; ++layer)
+            {
+                for (auto face = gl::uint32_t{ 0u }; face < face_count_; ++face)
+                {
+                    for (auto level = gl::uint32_t{ 0u }; level < level_count_; ++level)
+                    {
+                        auto const image_size = image_size_(level);
+                        images_.at((static_cast<gl::size_t>(level) * layer_count_ + layer) * face_count_ + face) = view_(memory, offset, image_size);
+                        offset += image_size;
+                    }
+                }
+            }
+        }
+
+        format_e                                 format_;
+        gl::vector_2u                            dimensions_;
+        gl::uint32_t                             level_count_;
+        gl::uint32_t                             layer_count_;
+        gl::uint32_t                             face_count_;
+        std::vector<std::span<gl::byte_t const>> images_;
+    };
+}
@@ -15,6 +15,18 @@ export namespace gl::io
         file.read(reinterpret_cast<gl::char_t*>(buffer.data()), size);
         return buffer;
     }
+    //Reads into memory the caller owns, e.g. a span mapped from a stream or pixel unpack buffer, returns the number of bytes read
+    auto read (const std::filesystem::path& path, std::span<gl::byte_t> memory, gl::size_t offset = 0u) -> gl::size_t
+    {
+        auto file = std::ifstream(path, std::ios::binary);
+        if (!file) throw std::runtime_error{ "failed to open file" };
+
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<gl::char_t*>(memory.data()), static_cast<std::streamsize>(memory.size_bytes()));
+        if (file.bad()) throw std::runtime_error{ "failed to read file" };
+
+        return static_cast<gl::size_t>(file.gcount());
+    }
     void write(const std::filesystem::path& path, std::span<const gl::byte_t> memory)
     {
         auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
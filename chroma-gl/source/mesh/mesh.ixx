@@ -0,0 +1,444 @@
+export module chroma_gl:mesh;
+
+import std;
+import glm;
+import opengl;
+import :object.vertex_array;
+
+export namespace gl::mesh
+{
+    //Indices of vertices that no triangle references are remapped to unused
+    auto constexpr unused = std::numeric_limits<gl::uint32_t>::max();
+
+    //ACMR is the number of transformed vertices per triangle, ATVR per vertex, both are 1.0 at best when every vertex is shared
+    struct statistics
+    {
+        gl::float32_t acmr         = 0.0f;
+        gl::float32_t atvr         = 0.0f;
+        gl::size_t    vertex_bytes = 0u;
+        gl::size_t    index_bytes  = 0u;
+    };
+}
+namespace gl::mesh
+{
+    //Counts the transformed vertices of every triangle with a FIFO post-transform cache
+    auto simulate_cache(std::span<gl::uint32_t const> indices, gl::count_t vertex_count, gl::count_t cache_size) -> std::vector<gl::uint32_t>
+    {
+        if (indices.size() % 3u != 0u) throw std::invalid_argument{ "index count is not a multiple of three" };
+
+        auto insertion = std::vector<gl::uint64_t>(vertex_count, 0u);
+        auto time      = gl::uint64_t{ cache_size + 1u };
+        auto misses    = std::vector<gl::uint32_t>(indices.size() / 3u, 0u);
+        for (auto index = gl::size_t{ 0u }; index < indices.size(); ++index)
+        {
+            auto const vertex = indices[index];
+            if (vertex >= vertex_count) throw std::out_of_range{ "index exceeds the vertex count" };
+            if (time - insertion[vertex] <= cache_size) continue;
+
+            insertion[vertex] = time++;
+            ++misses[index / 3u];
+        }
+
+        return misses;
+    }
+    auto triangle_normal(std::span<gl::vector_3f const> positions, gl::uint32_t first, gl::uint32_t second, gl::uint32_t third) -> gl::vector_3f
+    {
+        return glm::cross(positions[second] - positions[first], positions[third] - positions[first]);
+    }
+}
+export namespace gl::mesh
+{
+    template<typename layout_t>
+    auto analyze(std::span<gl::uint32_t const> indices, gl::count_t vertex_count, gl::count_t cache_size = 16u) -> gl::mesh::statistics
+    {
+        auto const misses      = gl::mesh::simulate_cache(indices, vertex_count, cache_size);
+        auto const transformed = std::accumulate(misses.begin(), misses.end(), gl::uint64_t{ 0u });
+
+        return gl::mesh::statistics
+        {
+            .acmr         = misses.empty()    ? 0.0f : static_cast<gl::float32_t>(transformed) / static_cast<gl::float32_t>(misses.size()),
+            .atvr         = vertex_count == 0u ? 0.0f : static_cast<gl::float32_t>(transformed) / static_cast<gl::float32_t>(vertex_count ),
+            .vertex_bytes = vertex_count   * layout_t::stride    ,
+            .index_bytes  = indices.size() * sizeof(gl::uint32_t),
+        };
+    }
+
+    //Orders triangles for post-transform cache reuse with Forsyth's linear speed algorithm
+    //Triangles are scored by how recently their vertices were used and how few triangles still reference them
+    auto optimize_vertex_cache(std::span<gl::uint32_t const> indices, gl::count_t vertex_count) -> std::vector<gl::uint32_t>
+    {
+        auto constexpr cache_size     = gl::size_t{ 32u };
+        auto constexpr no_triangle    = std::numeric_limits<gl::size_t>::max();
+        auto const     triangle_count = indices.size() / 3u;
+        if (indices.size() % 3u != 0u) throw std::invalid_argument{ "index count is not a multiple of three" };
+
+        auto offsets = std::vector<gl::uint32_t>(vertex_count + 1u, 0u);
+        for (auto const vertex : indices)
+        {
+            if (vertex >= vertex_count) throw std::out_of_range{ "index exceeds the vertex count" };
+            ++offsets[vertex + 1u];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        auto adjacency = std::vector<gl::uint32_t>(indices.size());
+        auto remaining = std::vector<gl::uint32_t>(vertex_count, 0u);
+        for (auto triangle = gl::uint32_t{ 0u }; triangle < triangle_count; ++triangle)
+        {
+            for (auto corner = gl::size_t{ 0u }; corner < 3u; ++corner)
+            {
+                auto const vertex = indices[triangle * 3u + corner];
+                adjacency[offsets[vertex] + remaining[vertex]++] = triangle;
+            }
+        }
+
+        auto const score = [](gl::int32_t position, gl::uint32_t triangles)
+            {
+                if (triangles == 0u) return -1.0f;
+
+                auto result = 0.0f;
+                if      (position >= 3) result = std::pow(1.0f - static_cast<gl::float32_t>(position - 3) / static_cast<gl::float32_t>(cache_size - 3u), 1.5f);
+                else if (position >= 0) result = 0.75f;
+
+                return result + 2.0f / std::sqrt(static_cast<gl::float32_t>(triangles));
+            };
+
+        auto positions       = std::vector<gl::int32_t  >(vertex_count, -1);
+        auto vertex_scores   = std::vector<gl::float32_t>(vertex_count);
+        auto triangle_scores = std::vector<gl::float32_t>(triangle_count, 0.0f);
+        auto is_emitted      = std::vector<gl::bool_t   >(triangle_count, gl::false_);
+        for (auto vertex = gl::size_t{ 0u }; vertex < vertex_count; ++vertex) vertex_scores[vertex] = score(-1, remaining[vertex]);
+        for (auto index  = gl::size_t{ 0u }; index  < indices.size(); ++index) triangle_scores[index / 3u] += vertex_scores[indices[index]];
+
+        auto cache  = std::vector<gl::uint32_t>{};
+        auto next   = std::vector<gl::uint32_t>{};
+        auto result = std::vector<gl::uint32_t>{};
+        auto cursor = gl::size_t{ 0u };
+        auto best   = triangle_count == 0u ? no_triangle : static_cast<gl::size_t>(std::distance(triangle_scores.begin(), std::ranges::max_element(triangle_scores)));
+        result.reserve(indices.size());
+
+        while (result.size() < indices.size())
+        {
+            if (best == no_triangle)
+            {
+                while (is_emitted[cursor]) ++cursor;
+                best = cursor;
+            }
+
+            auto const triangle = indices.subspan(best * 3u, 3u);
+            result.append_range(triangle);
+            is_emitted[best] = gl::true_;
+
+            for (auto const vertex : triangle)
+            {
+                auto const live = std::span{ adjacency }.subspan(offsets[vertex], remaining[vertex]);
+                auto const it   = std::ranges::find(live, static_cast<gl::uint32_t>(best));
+                std::iter_swap(it, live.end() - 1);
+                --remaining[vertex];
+            }
+
+            next.assign(triangle.begin(), triangle.end());
+            std::ranges::copy_if(cache, std::back_inserter(next), [&](gl::uint32_t vertex) { return std::ranges::find(triangle, vertex) == triangle.end(); });
+
+            for (auto position = gl::size_t{ 0u }; position < next.size(); ++position)
+            {
+                auto const vertex    = next[position];
+                auto const in_cache  = position < cache_size;
+                positions[vertex]    = in_cache ? static_cast<gl::int32_t>(position) : -1;
+
+                auto const updated   = score(positions[vertex], remaining[vertex]);
+                auto const delta     = updated - vertex_scores[vertex];
+                vertex_scores[vertex] = updated;
+                for (auto const adjacent : std::span{ adjacency }.subspan(offsets[vertex], remaining[vertex])) triangle_scores[adjacent] += delta;
+            }
+            if (next.size() > cache_size) next.resize(cache_size);
+            std::swap(cache, next);
+
+            best = no_triangle;
+            auto best_score = -std::numeric_limits<gl::float32_t>::infinity();
+            for (auto const vertex : cache)
+            {
+                for (auto const adjacent : std::span{ adjacency }.subspan(offsets[vertex], remaining[vertex]))
+                {
+                    if (triangle_scores[adjacent] <= best_score) continue;
+
+                    best       = adjacent;
+                    best_score = triangle_scores[adjacent];
+                }
+            }
+        }
+
+        return result;
+    }
+    //Splits the cache optimized triangles into clusters wherever all three vertices miss the cache, cluster order barely affects the cache efficiency
+    //Clusters facing away from the mesh center are drawn first, they are most likely to occlude the clusters behind them
+    auto optimize_overdraw(std::span<gl::uint32_t const> indices, std::span<gl::vector_3f const> positions, gl::count_t cache_size = 16u) -> std::vector<gl::uint32_t>
+    {
+        struct cluster
+        {
+            gl::size_t    first;
+            gl::size_t    count;
+            gl::float32_t sort_key;
+        };
+
+        auto const misses   = gl::mesh::simulate_cache(indices, positions.size(), cache_size);
+        auto       clusters = std::vector<cluster>{};
+        for (auto triangle = gl::size_t{ 0u }; triangle < misses.size(); ++triangle)
+        {
+            if (clusters.empty() || misses[triangle] == 3u) clusters.emplace_back(cluster{ triangle, 0u, 0.0f });
+            ++clusters.back().count;
+        }
+
+        auto center = gl::vector_3f{ 0.0f };
+        auto area   = 0.0f;
+        for (auto triangle = gl::size_t{ 0u }; triangle < misses.size(); ++triangle)
+        {
+            auto const weight = glm::length(gl::mesh::triangle_normal(positions, indices[triangle * 3u], indices[triangle * 3u + 1u], indices[triangle * 3u + 2u]));
+            center += weight * (positions[indices[triangle * 3u]] + positions[indices[triangle * 3u + 1u]] + positions[indices[triangle * 3u + 2u]]) / 3.0f;
+            area   += weight;
+        }
+        if (area > 0.0f) center /= area;
+
+        for (auto& value : clusters)
+        {
+            auto centroid = gl::vector_3f{ 0.0f };
+            auto normal   = gl::vector_3f{ 0.0f };
+            auto weight   = 0.0f;
+            for (auto triangle = value.first; triangle < value.first + value.count; ++triangle)
+            {
+                auto const face      = gl::mesh::triangle_normal(positions, indices[triangle * 3u], indices[triangle * 3u + 1u], indices[triangle * 3u + 2u]);
+                auto const face_area = glm::length(face);
+                centroid += face_area * (positions[indices[triangle * 3u]] + positions[indices[triangle * 3u + 1u]] + positions[indices[triangle * 3u + 2u]]) / 3.0f;
+                normal   += face;
+                weight   += face_area;
+            }
+
+            if (weight > 0.0f && glm::length(normal) > 0.0f) value.sort_key = glm::dot(centroid / weight - center, glm::normalize(normal));
+        }
+
+        std::ranges::stable_sort(clusters, std::ranges::greater{}, &cluster::sort_key);
+
+        auto result = std::vector<gl::uint32_t>{};
+        result.reserve(indices.size());
+        for (auto const& value : clusters) result.append_range(indices.subspan(value.first * 3u, value.count * 3u));
+
+        return result;
+    }
+    //Renumbers vertices in the order the indices first reference them so vertex fetches walk memory linearly
+    //Returns the new index of every old vertex, apply it to each vertex stream with remap_vertices
+    auto optimize_vertex_fetch(std::span<gl::uint32_t> indices, gl::count_t vertex_count) -> std::vector<gl::uint32_t>
+    {
+        auto remap = std::vector<gl::uint32_t>(vertex_count, gl::mesh::unused);
+        auto next  = gl::uint32_t{ 0u };
+        for (auto& index : indices)
+        {
+            if (index >= vertex_count) throw std::out_of_range{ "index exceeds the vertex count" };
+            if (remap[index] == gl::mesh::unused) remap[index] = next++;
+
+            index = remap[index];
+        }
+
+        return remap;
+    }
+    template<typename vertex_t>
+    auto remap_vertices(std::span<vertex_t const> vertices, std::span<gl::uint32_t const> remap) -> std::vector<vertex_t>
+    {
+        if (vertices.size() != remap.size()) throw std::invalid_argument{ "remap table does not match the vertex count" };
+
+        auto const count  = static_cast<gl::size_t>(std::ranges::count_if(remap, [](gl::uint32_t index) { return index != gl::mesh::unused; }));
+        auto       result = std::vector<vertex_t>(count);
+        for (auto vertex = gl::size_t{ 0u }; vertex < vertices.size(); ++vertex)
+        {
+            if (remap[vertex] != gl::mesh::unused) result[remap[vertex]] = vertices[vertex];
+        }
+
+        return result;
+    }
+
+    //Simplifies the mesh by clustering its vertices on a grid, each level keeps about the reduction factor of the indices of the level before it
+    //Levels index into the vertices of the source mesh so one vertex buffer serves the whole chain, level zero is the source
+    //The chain ends early once a level cannot be reduced any further
+    auto generate_lod_chain(std::span<gl::uint32_t const> indices, std::span<gl::vector_3f const> positions, gl::count_t level_count, gl::float32_t reduction = 0.5f) -> std::vector<std::vector<gl::uint32_t>>
+    {
+        if (reduction <= 0.0f || reduction >= 1.0f) throw std::invalid_argument{ "reduction has to be between zero and one" };
+
+        auto chain = std::vector<std::vector<gl::uint32_t>>{};
+        if (level_count == 0u) return chain;
+        chain.emplace_back(indices.begin(), indices.end());
+
+        auto minimum = gl::vector_3f{ std::numeric_limits<gl::float32_t>::max()    };
+        auto maximum = gl::vector_3f{ std::numeric_limits<gl::float32_t>::lowest() };
+        for (auto const index : indices)
+        {
+            if (index >= positions.size()) throw std::out_of_range{ "index exceeds the vertex count" };
+            minimum = glm::min(minimum, positions[index]);
+            maximum = glm::max(maximum, positions[index]);
+        }
+        auto const extent = glm::max(maximum - minimum, gl::vector_3f{ std::numeric_limits<gl::float32_t>::epsilon() });
+
+        auto const simplify = [&](gl::uint32_t resolution)
+            {
+                auto const cell_of = [&](gl::uint32_t vertex)
+                    {
+                        auto const cell = glm::min(gl::vector_3u{ (positions[vertex] - minimum) / extent * static_cast<gl::float32_t>(resolution) }, gl::vector_3u{ resolution - 1u });
+                        return (static_cast<gl::uint64_t>(cell.z) * resolution + cell.y) * resolution + cell.x;
+                    };
+
+                auto means = std::unordered_map<gl::uint64_t, std::pair<gl::vector_3f, gl::uint32_t>>{};
+                for (auto const index : indices)
+                {
+                    auto& [sum, count] = means[cell_of(index)];
+                    sum   += positions[index];
+                    count += 1u;
+                }
+
+                auto representatives = std::unordered_map<gl::uint64_t, std::pair<gl::uint32_t, gl::float32_t>>{};
+                for (auto const index : indices)
+                {
+                    auto const  cell     = cell_of(index);
+                    auto const& [sum, count] = means.at(cell);
+                    auto const  distance = glm::distance(positions[index], sum / static_cast<gl::float32_t>(count));
+                    auto const [it, inserted] = representatives.try_emplace(cell, index, distance);
+                    if (!inserted && distance < it->second.second) it->second = { index, distance };
+                }
+
+                auto result    = std::vector<gl::uint32_t>{};
+                auto triangles = std::set<std::array<gl::uint32_t, 3u>>{};
+                for (auto triangle = gl::size_t{ 0u }; triangle + 2u < indices.size(); triangle += 3u)
+                {
+                    auto corners = std::array<gl::uint32_t, 3u>{};
+                    for (auto corner = gl::size_t{ 0u }; corner < 3u; ++corner) corners[corner] = representatives.at(cell_of(indices[triangle + corner])).first;
+                    if (corners[0] == corners[1] || corners[1] == corners[2] || corners[0] == corners[2]) continue;
+
+                    //Rotated so the smallest index comes first, which keeps the winding while identifying duplicates
+                    std::ranges::rotate(corners, std::ranges::min_element(corners));
+                    if (triangles.insert(corners).second) result.append_range(corners);
+                }
+
+                return result;
+            };
+
+        for (auto level = gl::size_t{ 1u }; level < level_count; ++level)
+        {
+            auto const target  = static_cast<gl::size_t>(static_cast<gl::float32_t>(chain.back().size() / 3u) * reduction) * 3u;
+            auto       lowest  = gl::uint32_t{ 1u    };
+            auto       highest = gl::uint32_t{ 1024u };
+            auto       best    = std::vector<gl::uint32_t>{};
+            while (lowest <= highest)
+            {
+                auto const resolution = lowest + (highest - lowest) / 2u;
+                auto       candidate  = simplify(resolution);
+                if (candidate.size() <= target)
+                {
+                    best   = std::move(candidate);
+                    lowest = resolution + 1u;
+                }
+                else highest = resolution - 1u;
+            }
+
+            if (best.empty() || best.size() >= chain.back().size()) break;
+            chain.emplace_back(gl::mesh::optimize_vertex_cache(best, positions.size()));
+        }
+
+        return chain;
+    }
+
+
+
+    //Encodings convert a source attribute to a compact value and declare the vertex attribute that reads it back
+    template<typename type_t>
+    struct unquantized
+    {
+        using source_t    = type_t;
+        using value_t     = type_t;
+        using attribute_t = gl::vertex_attribute<value_t>;
+
+        static auto encode(source_t const& value) -> value_t
+        {
+            return value;
+        }
+    };
+    //The fourth component is one so the position can be read as a vec4 or vec3, precision is about 1/1000 of the distance to the origin
+    struct half_position
+    {
+        using source_t    = gl::vector_3f;
+        using value_t     = std::array<gl::half_t, 4u>;
+        using attribute_t = gl::vertex_attribute<value_t>;
+
+        static auto encode(source_t const& value) -> value_t
+        {
+            auto const half = [](gl::float32_t component) { return static_cast<gl::half_t>(glm::packHalf1x16(component)); };
+            return value_t{ half(value.x), half(value.y), half(value.z), half(1.0f) };
+        }
+    };
+    struct half_coordinate
+    {
+        using source_t    = gl::vector_2f;
+        using value_t     = std::array<gl::half_t, 2u>;
+        using attribute_t = gl::vertex_attribute<value_t>;
+
+        static auto encode(source_t const& value) -> value_t
+        {
+            return value_t{ static_cast<gl::half_t>(glm::packHalf1x16(value.x)), static_cast<gl::half_t>(glm::packHalf1x16(value.y)) };
+        }
+    };
+    //Unit normal folded onto an octahedron, decoded with n = vec3(e, 1 - |e.x| - |e.y|); n.xy += max(-n.z, 0) * -sign(n.xy); normalize(n)
+    struct octahedral_normal
+    {
+        using source_t    = gl::vector_3f;
+        using value_t     = gl::vector_t<gl::int16_t, 2u>;
+        using attribute_t = gl::vertex_attribute<value_t, 2u, 1u, 0u, gl::true_>;
+
+        static auto encode(source_t const& value) -> value_t
+        {
+            auto const sign     = [](gl::float32_t component) { return component >= 0.0f ? 1.0f : -1.0f; };
+            auto const length   = std::abs(value.x) + std::abs(value.y) + std::abs(value.z);
+            auto       folded   = length > 0.0f ? gl::vector_2f{ value.x, value.y } / length : gl::vector_2f{ 0.0f };
+            if (value.z < 0.0f) folded = gl::vector_2f{ (1.0f - std::abs(folded.y)) * sign(folded.x), (1.0f - std::abs(folded.x)) * sign(folded.y) };
+
+            return value_t{ glm::round(glm::clamp(folded, -1.0f, 1.0f) * 32767.0f) };
+        }
+    };
+    //Tangent direction in three signed normalized 10-bit components, the handedness in w is kept as its sign
+    struct packed_tangent
+    {
+        using source_t    = gl::vector_4f;
+        using value_t     = gl::int32_2_10_10_10_r_t;
+        using attribute_t = gl::vertex_attribute<value_t, 4u, 1u, 0u, gl::true_>;
+
+        static auto encode(source_t const& value) -> value_t
+        {
+            auto const pack = [](gl::float32_t component, gl::float32_t maximum, gl::uint32_t mask) { return static_cast<gl::uint32_t>(static_cast<gl::int32_t>(std::round(std::clamp(component, -1.0f, 1.0f) * maximum))) & mask; };
+            return static_cast<value_t>(pack(value.x, 511.0f, 0x3FFu) | (pack(value.y, 511.0f, 0x3FFu) << 10u) | (pack(value.z, 511.0f, 0x3FFu) << 20u) | (pack(value.w < 0.0f ? -1.0f : 1.0f, 1.0f, 0x3u) << 30u));
+        }
+    };
+
+    //The layout attaches the buffer written by make_quantized with the same encodings, e.g. vertex_array.attach<quantized_layout<...>>(buffer)
+    template<typename... encoding_t>
+    using quantized_layout = gl::interleaved_layout<typename encoding_t::attribute_t...>;
+
+    //Interleaves the encoded ranges in the order of the encodings, one range per encoding
+    template<typename... encoding_t, typename... range_t> requires (sizeof...(encoding_t) == sizeof...(range_t))
+    auto make_quantized(range_t const&... ranges) -> std::vector<gl::byte_t>
+    {
+        using layout_t = gl::mesh::quantized_layout<encoding_t...>;
+
+        auto const count  = std::min({ static_cast<gl::size_t>(std::ranges::size(ranges))... });
+        auto       result = std::vector<gl::byte_t>(count * layout_t::stride);
+        auto       offset = gl::size_t{ 0u };
+        auto const write  = [&]<typename current_t>(auto const& range)
+            {
+                using value_t = typename current_t::value_t;
+                static_assert(sizeof(value_t) == current_t::attribute_t::size, "encoded value does not match its vertex attribute");
+
+                for (auto index = gl::size_t{ 0u }; index < count; ++index)
+                {
+                    auto const value = current_t::encode(std::ranges::begin(range)[index]);
+                    std::memcpy(result.data() + index * layout_t::stride + offset, &value, sizeof(value));
+                }
+                offset += sizeof(value_t);
+            };
+
+        (write.template operator()<encoding_t>(ranges), ...);
+        return result;
+    }
+}
@@ -21,8 +21,9 @@ export namespace gl
             auto const  upload_range  = gl::clamp_range(gl::index_range{ index, memory.size() }, derived.count());
             if (upload_range.is_empty()) return;
 
+            derived.require_barrier(gl::memory_barrier_e::buffer_update);
             auto        mapped_memory = gl::map_buffer_range<element_t>(derived.handle(), gl::buffer_mapping_range_access_flags_e::write, upload_range);
-            std::memcpy(mapped_memory.data() + upload_range.index, memory.data(), upload_range.count * sizeof(element_t));
+            std::memcpy(mapped_memory.data(), memory.data(), upload_range.count * sizeof(element_t));
             gl::unmap_buffer(derived.handle());
         }
     };
@@ -39,8 +40,9 @@ export namespace gl
             auto const  download_range = gl::clamp_range(gl::index_range{ index, memory.size() }, derived.count());
             if (download_range.is_empty()) return;
 
+            derived.require_barrier(gl::memory_barrier_e::buffer_update);
             auto        mapped_memory  = gl::map_buffer_range<element_t>(derived.handle(), gl::buffer_mapping_range_access_flags_e::read, download_range);
-            std::memcpy(memory.data(), mapped_memory.data() + download_range.index, download_range.count * sizeof(element_t));
+            std::memcpy(memory.data(), mapped_memory.data(), download_range.count * sizeof(element_t));
             gl::unmap_buffer(derived.handle());
         }
     };
@@ -66,6 +68,30 @@ export namespace gl
             std::memcpy(derived.mapped_memory_.data() + upload_range.index, memory.data(), upload_range.count * sizeof(element_t));
             derived.memory_locker_.lock(upload_range);
         }
+        auto try_upload(std::span<element_t const> memory, gl::index_t index = 0u) -> gl::bool_t
+        {
+            auto      & derived      = static_cast<derived_t&>(*this);
+            auto const  upload_range = gl::clamp_range(gl::index_range{ index, memory.size() }, derived.count());
+            if (upload_range.is_empty()) return gl::true_;
+            if (!derived.memory_locker_.try_wait(upload_range)) return gl::false_;
+
+            std::memcpy(derived.mapped_memory_.data() + upload_range.index, memory.data(), upload_range.count * sizeof(element_t));
+            derived.memory_locker_.lock(upload_range);
+
+            return gl::true_;
+        }
+        //Waits until the range is no longer in use and returns it for direct writes, the range is locked as if it were uploaded
+        auto map       (gl::index_range range) -> std::span<element_t>
+        {
+            auto      & derived   = static_cast<derived_t&>(*this);
+            auto const  map_range = gl::clamp_range(range, derived.count());
+            if (map_range.is_empty()) return {};
+
+            derived.memory_locker_.wait(map_range);
+            derived.memory_locker_.lock(map_range);
+
+            return derived.mapped_memory_.subspan(map_range.index, map_range.count);
+        }
     };
     template<typename derived_t, typename element_t>
     struct persistent_download
@@ -78,7 +104,15 @@ export namespace gl
 
             derived.memory_locker_.wait(download_range);
             std::memcpy(memory.data(), derived.mapped_memory_.data() + download_range.index, download_range.count * sizeof(element_t));
-            derived.memory_locker_.lock(download_range);
+        }
+        //Returns the range without copying it, the caller has to know the commands writing to it completed, e.g. through a fence of its own
+        auto view    (gl::index_range range) const -> std::span<element_t const>
+        {
+            auto const& derived    = static_cast<derived_t const&>(*this);
+            auto const  view_range = gl::clamp_range(range, derived.count());
+            if (view_range.is_empty()) return {};
+
+            return derived.mapped_memory_.subspan(view_range.index, view_range.count);
         }
     };
 
@@ -113,10 +147,11 @@ export namespace gl
     class base_bindable_buffer
     {
     public:
-        void bind(gl::binding_t binding)
+        //Shader storage and atomic counter bindings are only counted as written by shaders when bound with write access
+        void bind(gl::binding_t binding, gl::image_access_e access = gl::image_access_e::read_only)
         {
             auto& derived = static_cast<derived_t&>(*this);
-            gl::bind_buffer_base(derived.handle(), target_v, binding);
+            gl::bind_buffer_base(derived.handle(), target_v, binding, access);
         }
     };
 
@@ -148,6 +183,11 @@ export namespace gl
             return element_count_ * element_size_;
         }
 
+        void require_barrier(gl::memory_barrier_e barrier) const
+        {
+            gl::object::require_barrier(gl::barrier::resource_e::buffer, handle(), barrier);
+        }
+
         auto operator=(buffer&&) noexcept -> buffer& = default;
 
     protected:
@@ -172,6 +212,13 @@ export namespace gl
         {
             gl::buffer_storage<element_t>(handle(), gl::buffer_storage_flags_e::static_, memory);
         }
+        //Storage is left undefined, it can only be filled by copies on the GPU
+        explicit
+        static_buffer(gl::count_t element_count)
+            : gl::buffer{ element_count, sizeof(element_t) }
+        {
+            gl::buffer_storage<element_t>(handle(), gl::buffer_storage_flags_e::static_, element_count);
+        }
     };
     template<typename element_t, gl::bool_t upload_v = gl::true_, gl::bool_t download_v = gl::true_, auto binding_v = gl::none>
     class dynamic_buffer 
@@ -219,6 +266,18 @@ export namespace gl
             mapped_memory_ = gl::map_buffer_range<element_t>(handle(), mapping_range_access_flags, count()      );
         }
 
+        //Places one fence for every transfer since the previous commit, call after submitting the commands that use them
+        //Shader writes have to be made visible to the mapping before the fence that downloads wait on
+        void commit()
+        {
+            if constexpr (download_v) require_barrier(gl::memory_barrier_e::client_mapped_buffer);
+            memory_locker_.commit();
+        }
+        void retire()
+        {
+            memory_locker_.retire();
+        }
+
     private:
         friend struct gl::persistent_upload  <persistent_buffer, element_t>;
         friend struct gl::persistent_download<persistent_buffer, element_t>;
@@ -230,18 +289,33 @@ export namespace gl
     class partition_buffer : private gl::persistent_buffer<element_t, gl::true_, gl::false_, binding_v>
     {
     public:
+        using gl::persistent_buffer<element_t, gl::true_, gl::false_, binding_v>::handle;
+        using gl::persistent_buffer<element_t, gl::true_, gl::false_, binding_v>::count;
+        using gl::persistent_buffer<element_t, gl::true_, gl::false_, binding_v>::size;
+
         explicit
         partition_buffer(gl::count_t partition_count, gl::count_t partition_element_count)
             : gl::persistent_buffer<element_t, gl::true_, gl::false_, binding_v>{ partition_count * partition_element_count }
             , partition_count_{ partition_count }, partition_element_count_{ partition_element_count }, partition_index_{ 0u } {}
 
-        void upload(std::span<element_t const> memory)
+        //The commands using the previous partition have been submitted by the time the next one is written
+        void upload    (std::span<element_t const> memory)
         {
             auto const partition_offset = partition_index_ * partition_element_count_;
+            gl::persistent_buffer<element_t, gl::true_, gl::false_, binding_v>::commit();
             gl::persistent_buffer<element_t, gl::true_, gl::false_, binding_v>::upload(memory, partition_offset);
             
             ++partition_index_ %= partition_count_;
         }
+        auto try_upload(std::span<element_t const> memory) -> gl::bool_t
+        {
+            auto const partition_offset = partition_index_ * partition_element_count_;
+            gl::persistent_buffer<element_t, gl::true_, gl::false_, binding_v>::commit();
+            if (!gl::persistent_buffer<element_t, gl::true_, gl::false_, binding_v>::try_upload(memory, partition_offset)) return gl::false_;
+
+            ++partition_index_ %= partition_count_;
+            return gl::true_;
+        }
 
     private:
         gl::count_t partition_count_;
@@ -272,4 +346,6 @@ export namespace gl
     using pixel_pack_buffer     = gl::result_buffer<gl::byte_t                        , gl::buffer_target_e::pixel_pack_buffer   >;
     using pixel_unpack_buffer   = gl::stream_buffer<gl::byte_t                        , gl::buffer_target_e::pixel_unpack_buffer >;
     using draw_indirect_buffer  = gl::stream_buffer<gl::draw_elements_indirect_command, gl::buffer_target_e::draw_indirect_buffer>;
+    //Written by shaders, e.g. with the work group count of a compaction, and read by dispatch_compute_indirect
+    using dispatch_indirect_buffer = gl::static_buffer<gl::dispatch_indirect_command, gl::buffer_target_e::dispatch_indirect_buffer>;
 }
@@ -0,0 +1,181 @@
+export module chroma_gl:object.draw_batch;
+
+import std;
+import opengl;
+import :object.buffer;
+import :object.geometry_heap;
+
+export namespace gl
+{
+    //Collects draw submissions for one frame and turns them into one multi-draw per pipeline, vertex array and material
+    //Commands and instance data are written into persistently mapped memory that is split into one slice per frame in flight
+    //Instance data is addressed through the absolute base instance of each command, shaders read it at gl_BaseInstance + gl_InstanceID
+    template<typename instance_t>
+    class draw_batch
+    {
+    public:
+        struct bucket
+        {
+            gl::handle_t pipeline;
+            gl::handle_t vertex_array;
+            gl::uint32_t material;
+            gl::index_t  first_command;
+            gl::count_t  command_count;
+        };
+
+        explicit
+        draw_batch(gl::count_t command_capacity, gl::count_t instance_capacity, gl::count_t frame_count = 3u)
+            : command_buffer_{ command_capacity * frame_count }, instance_buffer_{ instance_capacity * frame_count }, parameter_buffer_{ command_capacity * frame_count }
+            , command_capacity_{ command_capacity }, instance_capacity_{ instance_capacity }, frame_count_{ frame_count }, frame_index_{ 0u }
+            , instance_memory_{}, instance_count_{ 0u }, submissions_{}, buckets_{}
+        {
+            if (frame_count == gl::count_t{ 0u }) throw std::invalid_argument{ "frame count must be greater than zero" };
+
+            begin_frame_();
+        }
+
+        void submit     (gl::handle_t pipeline, gl::handle_t vertex_array, gl::uint32_t material, gl::geometry_range const& geometry, std::span<instance_t const> instances)
+        {
+            if (submissions_.size()               >= command_capacity_ ) throw std::runtime_error{ "draw batch command capacity exceeded"  };
+            if (instance_count_ + instances.size() > instance_capacity_) throw std::runtime_error{ "draw batch instance capacity exceeded" };
+
+            auto const base_instance = frame_index_ * instance_capacity_ + instance_count_;
+            std::ranges::copy(instances, instance_memory_.begin() + instance_count_);
+            instance_count_ += instances.size();
+
+            submissions_.emplace_back(
+                sort_key{ pipeline, vertex_array, material },
+                gl::draw_elements_indirect_command
+                {
+                    .count          = static_cast<gl::uint32_t>(geometry.index_count ),
+                    .instance_count = static_cast<gl::uint32_t>(instances.size()     ),
+                    .first          = static_cast<gl::uint32_t>(geometry.first_index ),
+                    .base_vertex    = static_cast<gl::int32_t >(geometry.first_vertex),
+                    .base_instance  = static_cast<gl::uint32_t>(base_instance        ),
+                });
+        }
+        //Sorts the submissions by state and writes their commands, the resulting buckets are valid until the next frame
+        auto build      () -> std::span<bucket const>
+        {
+            buckets_.clear();
+            std::ranges::stable_sort(submissions_, {}, &submission::key);
+
+            auto const first_command   = frame_index_ * command_capacity_;
+            auto const command_memory  = command_buffer_  .map(gl::index_range{ first_command, command_capacity_ });
+            auto const count_memory    = parameter_buffer_.map(gl::index_range{ first_command, command_capacity_ });
+            for (auto index = gl::index_t{ 0u }; index < submissions_.size(); ++index)
+            {
+                auto const& [key, command] = submissions_[index];
+                command_memory[index] = command;
+
+                if (buckets_.empty() || buckets_.back().pipeline != key.pipeline || buckets_.back().vertex_array != key.vertex_array || buckets_.back().material != key.material)
+                {
+                    buckets_.emplace_back(key.pipeline, key.vertex_array, key.material, first_command + index, gl::count_t{ 0u });
+                }
+
+                ++buckets_.back().command_count;
+            }
+            for (auto index = gl::index_t{ 0u }; index < buckets_.size(); ++index) count_memory[index] = static_cast<gl::uint32_t>(buckets_[index].command_count);
+
+            return buckets_;
+        }
+        //Binds the state of each bucket and issues a single multi-draw for it, the callback binds the resources of a material
+        template<typename callback_t>
+        void draw       (callback_t&& bind_material, gl::draw_mode_e draw_mode = gl::draw_mode_e::triangles)
+        {
+            command_buffer_.bind();
+            for (auto const& bucket : buckets_)
+            {
+                bind_bucket_(bucket, bind_material);
+                gl::multi_draw_elements_indirect(draw_mode, gl::draw_type_e::uint32, bucket.command_count, bucket.first_command);
+            }
+        }
+        //Reads the draw count of each bucket from the parameter buffer so it can be reduced on the GPU, e.g. by a culling pass
+        template<typename callback_t>
+        void draw_count (callback_t&& bind_material, gl::draw_mode_e draw_mode = gl::draw_mode_e::triangles)
+        {
+            command_buffer_  .bind();
+            parameter_buffer_.bind();
+            for (auto index = gl::index_t{ 0u }; index < buckets_.size(); ++index)
+            {
+                auto const& bucket = buckets_[index];
+                bind_bucket_(bucket, bind_material);
+                gl::multi_draw_elements_indirect_count(draw_mode, gl::draw_type_e::uint32, bucket.first_command, (frame_index_ * command_capacity_ + index) * sizeof(gl::uint32_t), bucket.command_count);
+            }
+        }
+        //Fences the commands and instance data of this frame and moves on to the next slice
+        void next_frame ()
+        {
+            command_buffer_  .commit();
+            instance_buffer_ .commit();
+            parameter_buffer_.commit();
+            frame_index_ = (frame_index_ + 1u) % frame_count_;
+
+            begin_frame_();
+        }
+
+        void bind_instances  (gl::binding_t binding)
+        {
+            gl::bind_buffer_base(instance_buffer_.handle(), gl::buffer_base_target_e::shader_storage_buffer, binding);
+        }
+
+        auto command_buffer  () -> gl::draw_indirect_buffer&
+        {
+            return command_buffer_;
+        }
+        auto instance_buffer () -> gl::stream_buffer<instance_t>&
+        {
+            return instance_buffer_;
+        }
+        auto parameter_buffer() -> gl::stream_buffer<gl::uint32_t, gl::buffer_target_e::parameter_buffer>&
+        {
+            return parameter_buffer_;
+        }
+        auto buckets         () const -> std::span<bucket const>
+        {
+            return buckets_;
+        }
+
+    private:
+        struct sort_key
+        {
+            gl::handle_t pipeline;
+            gl::handle_t vertex_array;
+            gl::uint32_t material;
+
+            auto operator<=>(sort_key const&) const = default;
+        };
+        struct submission
+        {
+            sort_key                           key;
+            gl::draw_elements_indirect_command command;
+        };
+
+        void begin_frame_()
+        {
+            instance_memory_ = instance_buffer_.map(gl::index_range{ frame_index_ * instance_capacity_, instance_capacity_ });
+            instance_count_  = gl::count_t{ 0u };
+            submissions_.clear();
+            buckets_    .clear();
+        }
+        template<typename callback_t>
+        void bind_bucket_(bucket const& bucket, callback_t& bind_material)
+        {
+            gl::bind_pipeline    (bucket.pipeline    );
+            gl::bind_vertex_array(bucket.vertex_array);
+            std::invoke(bind_material, bucket.material);
+        }
+
+        gl::draw_indirect_buffer                                               command_buffer_;
+        gl::stream_buffer<instance_t>                                          instance_buffer_;
+        gl::stream_buffer<gl::uint32_t, gl::buffer_target_e::parameter_buffer> parameter_buffer_;
+        gl::count_t                                                            command_capacity_;
+        gl::count_t                                                            instance_capacity_;
+        gl::count_t                                                            frame_count_;
+        gl::index_t                                                            frame_index_;
+        std::span<instance_t>                                                  instance_memory_;
+        gl::count_t                                                            instance_count_;
+        std::vector<submission>                                                submissions_;
+        std::vector<bucket>                                                    buckets_;
+    };
+}
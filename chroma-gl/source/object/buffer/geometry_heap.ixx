@@ -0,0 +1,212 @@
+export module chroma_gl:object.geometry_heap;
+
+import std;
+import opengl;
+import :object.buffer;
+import :object.range_allocator;
+import :object.vertex_array;
+
+export namespace gl
+{
+    struct geometry_range
+    {
+        gl::handle_t vertex_buffer;
+        gl::handle_t index_buffer;
+        gl::offset_t vertex_offset;
+        gl::index_t  first_vertex;
+        gl::count_t  vertex_count;
+        gl::offset_t index_offset;
+        gl::index_t  first_index;
+        gl::count_t  index_count;
+    };
+
+    //Shares one vertex buffer, index buffer and vertex array between every mesh of a single vertex layout
+    //Meshes are referenced by identifier, their ranges remain valid until the next free or defragmentation
+    //Uploads are staged through a persistently mapped ring buffer and copied on the GPU
+    template<typename layout_t>
+    class geometry_heap
+    {
+    public:
+        using mesh_t = gl::uint32_t;
+
+        explicit
+        geometry_heap(gl::count_t vertex_capacity, gl::count_t index_capacity, gl::size_t staging_size = 4u * 1024u * 1024u)
+            : vertex_allocator_{ vertex_capacity }, index_allocator_{ index_capacity }
+            , vertex_buffer_{ vertex_capacity * layout_t::stride }, index_buffer_{ index_capacity }, vertex_array_{}
+            , staging_buffer_{ staging_size }, staging_offset_{ 0u }, meshes_{}, spare_meshes_{}
+        {
+            attach_();
+        }
+
+        //Returns nothing when either allocator is exhausted, defragmenting may make room if enough space is free in total
+        auto allocate  (gl::count_t vertex_count, gl::count_t index_count) -> std::optional<mesh_t>
+        {
+            auto const vertices = vertex_allocator_.allocate(vertex_count);
+            if (!vertices) return std::nullopt;
+
+            auto const indices  = index_allocator_ .allocate(index_count );
+            if (!indices)
+            {
+                vertex_allocator_.free(*vertices);
+                return std::nullopt;
+            }
+
+            return emplace_mesh_(mesh_entry{ *vertices, *indices });
+        }
+        template<typename vertex_t>
+        auto allocate  (std::span<vertex_t const> vertices, std::span<gl::uint32_t const> indices) -> std::optional<mesh_t>
+        {
+            auto const mesh = allocate(vertices.size(), indices.size());
+            if (mesh) upload(*mesh, vertices, indices);
+
+            return mesh;
+        }
+        void free      (mesh_t mesh)
+        {
+            auto const& entry = mesh_entry_(mesh);
+            vertex_allocator_.free(entry.vertices);
+            index_allocator_ .free(entry.indices );
+
+            meshes_[mesh].reset();
+            spare_meshes_.emplace_back(mesh);
+        }
+
+        template<typename vertex_t>
+        void upload    (mesh_t mesh, std::span<vertex_t const> vertices, std::span<gl::uint32_t const> indices)
+        {
+            static_assert(sizeof(vertex_t) == layout_t::stride, "vertex size does not match layout stride");
+
+            auto const& entry = mesh_entry_(mesh);
+            if (vertices.size() > entry.vertices.count || indices.size() > entry.indices.count) throw std::invalid_argument{ "data exceeds mesh allocation" };
+
+            stage_(vertex_buffer_.handle(), entry.vertices.index * layout_t::stride   , gl::as_bytes(vertices));
+            stage_(index_buffer_ .handle(), entry.indices .index * sizeof(gl::uint32_t), gl::as_bytes(indices ));
+            staging_buffer_.commit();
+        }
+
+        //Packs every mesh to the front of new buffers, mesh identifiers are preserved but their ranges change
+        void defragment()
+        {
+            auto vertex_buffer = gl::static_buffer<gl::byte_t  >{ vertex_allocator_.capacity() * layout_t::stride };
+            auto index_buffer  = gl::static_buffer<gl::uint32_t>{ index_allocator_ .capacity()                    };
+            vertex_allocator_.reset();
+            index_allocator_ .reset();
+
+            for (auto& entry : meshes_)
+            {
+                if (!entry) continue;
+
+                auto const vertices = *vertex_allocator_.allocate(entry->vertices.count);
+                auto const indices  = *index_allocator_ .allocate(entry->indices .count);
+                gl::copy_buffer_sub_data<gl::byte_t  >(vertex_buffer_.handle(), vertex_buffer.handle(), gl::index_range{ entry->vertices.index * layout_t::stride, entry->vertices.count * layout_t::stride }, vertices.index * layout_t::stride);
+                gl::copy_buffer_sub_data<gl::uint32_t>(index_buffer_ .handle(), index_buffer .handle(), entry->indices.range()                                                                             , indices .index                   );
+
+                *entry = mesh_entry{ vertices, indices };
+            }
+
+            vertex_buffer_ = std::move(vertex_buffer);
+            index_buffer_  = std::move(index_buffer );
+            vertex_array_  = gl::vertex_array{};
+            attach_();
+        }
+
+        void bind      ()
+        {
+            vertex_array_.bind();
+        }
+        void draw      (mesh_t mesh, gl::draw_mode_e draw_mode = gl::draw_mode_e::triangles)
+        {
+            auto const geometry = range(mesh);
+            bind();
+            gl::draw_elements_base_vertex(draw_mode, gl::draw_type_e::uint32, geometry.index_count, geometry.first_index, static_cast<gl::int32_t>(geometry.first_vertex));
+        }
+
+        auto range             (mesh_t mesh) -> gl::geometry_range
+        {
+            auto const& entry = mesh_entry_(mesh);
+            return gl::geometry_range
+            {
+                .vertex_buffer = vertex_buffer_.handle()                          ,
+                .index_buffer  = index_buffer_ .handle()                          ,
+                .vertex_offset = entry.vertices.index * layout_t::stride          ,
+                .first_vertex  = entry.vertices.index                             ,
+                .vertex_count  = entry.vertices.count                             ,
+                .index_offset  = entry.indices .index * sizeof(gl::uint32_t)      ,
+                .first_index   = entry.indices .index                             ,
+                .index_count   = entry.indices .count                             ,
+            };
+        }
+        auto vertex_statistics () const -> gl::allocator_statistics
+        {
+            return vertex_allocator_.statistics();
+        }
+        auto index_statistics  () const -> gl::allocator_statistics
+        {
+            return index_allocator_.statistics();
+        }
+        auto vertex_array      () -> gl::vertex_array&
+        {
+            return vertex_array_;
+        }
+
+    private:
+        struct mesh_entry
+        {
+            gl::range_allocator::allocation vertices;
+            gl::range_allocator::allocation indices;
+        };
+
+        void attach_     ()
+        {
+            vertex_array_.template attach<layout_t>(vertex_buffer_);
+            vertex_array_.attach                   (index_buffer_ );
+        }
+        void stage_      (gl::handle_t destination, gl::offset_t destination_offset, std::span<gl::byte_t const> memory)
+        {
+            while (!memory.empty())
+            {
+                auto const chunk_size = std::min(memory.size(), staging_buffer_.size());
+                if (staging_offset_ + chunk_size > staging_buffer_.size()) staging_offset_ = gl::offset_t{ 0u };
+
+                auto const staging_range = gl::index_range{ staging_offset_, chunk_size };
+                auto const mapped_memory = staging_buffer_.map(staging_range);
+                std::memcpy(mapped_memory.data(), memory.data(), chunk_size);
+                gl::copy_buffer_sub_data(staging_buffer_.handle(), destination, staging_range, destination_offset);
+
+                staging_offset_    += chunk_size;
+                destination_offset += chunk_size;
+                memory              = memory.subspan(chunk_size);
+            }
+        }
+        auto emplace_mesh_(mesh_entry const& entry) -> mesh_t
+        {
+            if (spare_meshes_.empty())
+            {
+                meshes_.emplace_back(entry);
+                return static_cast<mesh_t>(meshes_.size() - 1u);
+            }
+
+            auto const mesh = spare_meshes_.back();
+            spare_meshes_.pop_back();
+            meshes_[mesh] = entry;
+
+            return mesh;
+        }
+        auto mesh_entry_ (mesh_t mesh) const -> mesh_entry const&
+        {
+            if (mesh >= meshes_.size() || !meshes_[mesh]) throw std::invalid_argument{ "invalid mesh" };
+
+            return *meshes_[mesh];
+        }
+
+        gl::range_allocator                              vertex_allocator_;
+        gl::range_allocator                              index_allocator_;
+        gl::static_buffer<gl::byte_t>                    vertex_buffer_;
+        gl::static_buffer<gl::uint32_t>                  index_buffer_;
+        gl::vertex_array                                 vertex_array_;
+        gl::stream_buffer<gl::byte_t>                    staging_buffer_;
+        gl::offset_t                                     staging_offset_;
+        std::vector<std::optional<mesh_entry>>           meshes_;
+        std::vector<mesh_t>                              spare_meshes_;
+    };
+}
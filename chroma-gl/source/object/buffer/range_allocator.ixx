@@ -0,0 +1,283 @@
+export module chroma_gl:object.range_allocator;
+
+import std;
+import opengl;
+
+export namespace gl
+{
+    struct allocator_statistics
+    {
+        gl::count_t   capacity            = 0u;
+        gl::count_t   used                = 0u;
+        gl::count_t   high_water_mark     = 0u;
+        gl::count_t   allocation_count    = 0u;
+        gl::count_t   free_region_count   = 0u;
+        gl::count_t   largest_free_region = 0u;
+        gl::float32_t fragmentation       = 0.0f; //Share of free space outside the largest free region
+    };
+
+    //Two-level segregated fit allocator for element ranges within a fixed capacity, it does not own any memory itself
+    //Free regions are binned by a floating point size class (3 mantissa bits), allocation and free run in constant time
+    //Adjacent free regions are merged on free
+    class range_allocator
+    {
+    public:
+        struct allocation
+        {
+            gl::index_t  index;
+            gl::count_t  count;
+            gl::uint32_t node;
+
+            auto range() const -> gl::index_range
+            {
+                return gl::index_range{ index, count };
+            }
+        };
+
+        explicit
+        range_allocator(gl::count_t capacity)
+            : capacity_{ capacity }, used_{ 0u }, high_water_mark_{ 0u }, allocation_count_{ 0u }
+            , nodes_{}, spare_nodes_{}, bin_heads_{}, used_bins_top_{ 0u }, used_bins_{}
+        {
+            if (capacity > std::numeric_limits<gl::uint32_t>::max()) throw std::invalid_argument{ "capacity exceeds allocator limits" };
+
+            bin_heads_.fill(null_node_);
+            used_bins_.fill(gl::uint8_t{ 0u });
+            if (capacity != gl::count_t{ 0u }) insert_free_(create_node_(gl::index_t{ 0u }, capacity));
+        }
+
+        auto allocate  (gl::count_t count) -> std::optional<allocation>
+        {
+            if (count == gl::count_t{ 0u } || count > capacity_ - used_) return std::nullopt;
+
+            auto const node = find_node_(count);
+            if (node == null_node_) return std::nullopt;
+
+            remove_free_(node);
+
+            if (nodes_[node].count > count)
+            {
+                auto const remainder = create_node_(nodes_[node].index + count, nodes_[node].count - count);
+                auto& split = nodes_[node];
+                nodes_[remainder].neighbor_previous = node;
+                nodes_[remainder].neighbor_next     = split.neighbor_next;
+                if (split.neighbor_next != null_node_) nodes_[split.neighbor_next].neighbor_previous = remainder;
+                split.neighbor_next = remainder;
+                split.count         = count;
+
+                insert_free_(remainder);
+            }
+
+            auto& result = nodes_[node];
+            result.is_used    = gl::true_;
+            used_            += result.count;
+            high_water_mark_  = std::max(high_water_mark_, result.index + result.count);
+            ++allocation_count_;
+
+            return allocation{ result.index, result.count, node };
+        }
+        void free      (allocation const& allocation)
+        {
+            if (allocation.node >= nodes_.size() || !nodes_[allocation.node].is_used) throw std::invalid_argument{ "allocation is not owned by this allocator" };
+
+            auto node = allocation.node;
+            used_    -= nodes_[node].count;
+            --allocation_count_;
+            nodes_[node].is_used = gl::false_;
+
+            auto const previous = nodes_[node].neighbor_previous;
+            if (previous != null_node_ && !nodes_[previous].is_used)
+            {
+                remove_free_(previous);
+                nodes_[previous].count += nodes_[node].count;
+                unlink_neighbor_(node);
+                node = previous;
+            }
+            auto const next     = nodes_[node].neighbor_next;
+            if (next     != null_node_ && !nodes_[next    ].is_used)
+            {
+                remove_free_(next);
+                nodes_[node].count += nodes_[next].count;
+                unlink_neighbor_(next);
+            }
+
+            insert_free_(node);
+        }
+        void reset     ()
+        {
+            nodes_      .clear();
+            spare_nodes_.clear();
+            bin_heads_  .fill(null_node_);
+            used_bins_  .fill(gl::uint8_t{ 0u });
+
+            used_bins_top_    = gl::uint32_t{ 0u };
+            used_             = gl::count_t { 0u };
+            high_water_mark_  = gl::count_t { 0u };
+            allocation_count_ = gl::count_t { 0u };
+            if (capacity_ != gl::count_t{ 0u }) insert_free_(create_node_(gl::index_t{ 0u }, capacity_));
+        }
+
+        auto capacity  () const -> gl::count_t
+        {
+            return capacity_;
+        }
+        auto used      () const -> gl::count_t
+        {
+            return used_;
+        }
+        auto statistics() const -> gl::allocator_statistics
+        {
+            auto free_region_count   = gl::count_t{ 0u };
+            auto largest_free_region = gl::count_t{ 0u };
+            for (auto const& node : nodes_)
+            {
+                if (node.is_used || node.count == gl::count_t{ 0u }) continue;
+
+                ++free_region_count;
+                largest_free_region = std::max(largest_free_region, node.count);
+            }
+
+            auto const free_count    = capacity_ - used_;
+            auto const fragmentation = free_count == gl::count_t{ 0u } ? 0.0f : 1.0f - static_cast<gl::float32_t>(largest_free_region) / static_cast<gl::float32_t>(free_count);
+
+            return gl::allocator_statistics{ capacity_, used_, high_water_mark_, allocation_count_, free_region_count, largest_free_region, fragmentation };
+        }
+
+    private:
+        static auto constexpr null_node_      = std::numeric_limits<gl::uint32_t>::max();
+        static auto constexpr mantissa_bits_  = gl::uint32_t{ 3u };
+        static auto constexpr mantissa_value_ = gl::uint32_t{ 1u } << mantissa_bits_;
+        static auto constexpr mantissa_mask_  = mantissa_value_ - 1u;
+        static auto constexpr top_bin_count_  = gl::uint32_t{ 32u };
+        static auto constexpr bin_count_      = top_bin_count_ * mantissa_value_;
+
+        struct node
+        {
+            gl::index_t  index;
+            gl::count_t  count;
+            gl::uint32_t bin_previous;
+            gl::uint32_t bin_next;
+            gl::uint32_t neighbor_previous;
+            gl::uint32_t neighbor_next;
+            gl::bool_t   is_used;
+        };
+
+        //Free regions are filed under the size class they fully cover, requests search from the class that covers them
+        static auto size_class_(gl::count_t count, gl::bool_t round_up) -> gl::uint32_t
+        {
+            auto const value = static_cast<gl::uint32_t>(count);
+            if (value < mantissa_value_) return value;
+
+            auto const highest_bit   = static_cast<gl::uint32_t>(std::bit_width(value)) - 1u;
+            auto const mantissa_bit  = highest_bit - mantissa_bits_;
+            auto const exponent      = mantissa_bit + 1u;
+            auto       mantissa      = (value >> mantissa_bit) & mantissa_mask_;
+            auto const low_bits_mask = (gl::uint32_t{ 1u } << mantissa_bit) - 1u;
+            if (round_up && (value & low_bits_mask) != gl::uint32_t{ 0u }) ++mantissa;
+
+            return (exponent << mantissa_bits_) + mantissa;
+        }
+        static auto round_up_  (gl::count_t count) -> gl::uint32_t
+        {
+            return size_class_(count, gl::true_);
+        }
+        static auto round_down_(gl::count_t count) -> gl::uint32_t
+        {
+            return size_class_(count, gl::false_);
+        }
+
+        auto find_bin_        (gl::uint32_t minimum_bin) const -> std::optional<gl::uint32_t>
+        {
+            auto const top  = minimum_bin >> mantissa_bits_;
+            auto const leaf = minimum_bin &  mantissa_mask_;
+            if (top >= top_bin_count_) return std::nullopt;
+
+            if (used_bins_top_ & (gl::uint32_t{ 1u } << top))
+            {
+                auto const leaf_mask = static_cast<gl::uint32_t>(used_bins_[top]) & (~gl::uint32_t{ 0u } << leaf);
+                if (leaf_mask != gl::uint32_t{ 0u }) return (top << mantissa_bits_) + static_cast<gl::uint32_t>(std::countr_zero(leaf_mask));
+            }
+
+            if (top + 1u >= top_bin_count_) return std::nullopt;
+            auto const top_mask = used_bins_top_ & (~gl::uint32_t{ 0u } << (top + 1u));
+            if (top_mask == gl::uint32_t{ 0u }) return std::nullopt;
+
+            auto const next_top = static_cast<gl::uint32_t>(std::countr_zero(top_mask));
+            return (next_top << mantissa_bits_) + static_cast<gl::uint32_t>(std::countr_zero(static_cast<gl::uint32_t>(used_bins_[next_top])));
+        }
+        //The class of a request may be empty while its own rounded down class still holds a region that is large enough
+        auto find_node_       (gl::count_t count) const -> gl::uint32_t
+        {
+            if (auto const bin = find_bin_(round_up_(count))) return bin_heads_[*bin];
+
+            for (auto node = bin_heads_[round_down_(count)]; node != null_node_; node = nodes_[node].bin_next)
+            {
+                if (nodes_[node].count >= count) return node;
+            }
+
+            return null_node_;
+        }
+        auto create_node_     (gl::index_t index, gl::count_t count) -> gl::uint32_t
+        {
+            auto const value = node{ index, count, null_node_, null_node_, null_node_, null_node_, gl::false_ };
+            if (!spare_nodes_.empty())
+            {
+                auto const reused = spare_nodes_.back();
+                spare_nodes_.pop_back();
+                nodes_[reused] = value;
+
+                return reused;
+            }
+
+            nodes_.emplace_back(value);
+            return static_cast<gl::uint32_t>(nodes_.size() - 1u);
+        }
+        void insert_free_     (gl::uint32_t index)
+        {
+            auto const bin  = round_down_(nodes_[index].count);
+            auto const head = bin_heads_[bin];
+
+            nodes_[index].bin_previous = null_node_;
+            nodes_[index].bin_next     = head;
+            if (head != null_node_) nodes_[head].bin_previous = index;
+            bin_heads_[bin] = index;
+
+            used_bins_[bin >> mantissa_bits_] |= static_cast<gl::uint8_t>(1u << (bin & mantissa_mask_));
+            used_bins_top_                    |= gl::uint32_t{ 1u } << (bin >> mantissa_bits_);
+        }
+        void remove_free_     (gl::uint32_t index)
+        {
+            auto const& value = nodes_[index];
+            if (value.bin_previous != null_node_) nodes_[value.bin_previous].bin_next = value.bin_next;
+            if (value.bin_next     != null_node_) nodes_[value.bin_next].bin_previous = value.bin_previous;
+
+            auto const bin = round_down_(value.count);
+            if (bin_heads_[bin] != index) return;
+
+            bin_heads_[bin] = value.bin_next;
+            if (bin_heads_[bin] != null_node_) return;
+
+            used_bins_[bin >> mantissa_bits_] &= static_cast<gl::uint8_t>(~(1u << (bin & mantissa_mask_)));
+            if (used_bins_[bin >> mantissa_bits_] == gl::uint8_t{ 0u }) used_bins_top_ &= ~(gl::uint32_t{ 1u } << (bin >> mantissa_bits_));
+        }
+        void unlink_neighbor_ (gl::uint32_t index)
+        {
+            auto& value = nodes_[index];
+            if (value.neighbor_previous != null_node_) nodes_[value.neighbor_previous].neighbor_next = value.neighbor_next;
+            if (value.neighbor_next     != null_node_) nodes_[value.neighbor_next].neighbor_previous = value.neighbor_previous;
+
+            value = node{ gl::index_t{ 0u }, gl::count_t{ 0u }, null_node_, null_node_, null_node_, null_node_, gl::false_ };
+            spare_nodes_.emplace_back(index);
+        }
+
+        gl::count_t                                   capacity_;
+        gl::count_t                                   used_;
+        gl::count_t                                   high_water_mark_;
+        gl::count_t                                   allocation_count_;
+        std::vector<node>                             nodes_;
+        std::vector<gl::uint32_t>                     spare_nodes_;
+        std::array<gl::uint32_t, bin_count_>          bin_heads_;
+        gl::uint32_t                                  used_bins_top_;
+        std::array<gl::uint8_t, top_bin_count_>       used_bins_;
+    };
+}
@@ -0,0 +1,270 @@
+export module chroma_gl:object.readback_queue;
+
+import std;
+import opengl;
+import :io;
+import :io.image;
+import :object.buffer;
+import :object.fence;
+import :object.range_allocator;
+import :object.texture;
+
+export namespace gl
+{
+    //Completed readback, the memory points into the mapped ring and is only valid within the callback of poll
+    struct readback
+    {
+        gl::uint64_t                id;
+        gl::image::format_e         format;
+        gl::vector_2u               dimensions;
+        std::span<gl::byte_t const> memory;
+        gl::count_t                 frame_latency;
+        std::chrono::nanoseconds    latency;
+    };
+    struct readback_statistics
+    {
+        gl::count_t              in_flight             = 0u;
+        gl::count_t              encoding              = 0u;
+        gl::count_t              completed             = 0u;
+        gl::count_t              dropped               = 0u;
+        gl::count_t              failed                = 0u; //Encodes that could not be written
+        gl::float64_t            average_frame_latency = 0.0;
+        std::chrono::nanoseconds average_latency       = {};
+        std::chrono::nanoseconds maximum_latency       = {};
+    };
+
+    //Reads framebuffers and textures into a persistently mapped pixel pack ring, the render thread never waits for the GPU
+    //Every request gets a fence and is handed to poll once the fence signaled and at least frame_latency frames have passed
+    //Requests that do not fit the ring are dropped instead of stalling, completed frames can be encoded to files on a worker thread
+    //Destroying the queue waits until every frame handed to encode has been written
+    class readback_queue
+    {
+    public:
+        explicit
+        readback_queue(gl::size_t staging_size = 64u * 1024u * 1024u, gl::count_t frame_latency = 2u)
+            : staging_buffer_{ gl::align_up(staging_size, staging_alignment_) }, staging_memory_{}, staging_allocator_{ gl::align_up(staging_size, staging_alignment_) / staging_alignment_ }, staging_mutex_{}
+            , requests_{}, sequence_{ 0u }, frame_{ 0u }, frame_latency_{ frame_latency }, polled_{}, is_retained_{ gl::false_ }
+            , completed_{ 0u }, dropped_{ 0u }, total_frame_latency_{ 0u }, total_latency_{}, maximum_latency_{}
+            , jobs_{}, job_mutex_{}, job_condition_{}, encoding_{ 0u }, failed_{ 0u }, worker_{}
+        {
+            staging_memory_ = staging_buffer_.view(gl::index_range{ gl::index_t{ 0u }, staging_buffer_.count() });
+        }
+
+        //Reads from the bound read framebuffer, returns the id of the request or nothing when the ring is full
+        auto read_pixels (gl::rectangle region, gl::image::format_e format = gl::image::format_e::rgba_uint8) -> std::optional<gl::uint64_t>
+        {
+            auto const descriptor   = gl::image::descriptor(format);
+            auto const pixel_format = static_cast<gl::pixel_data_format_e>(gl::to_underlying(descriptor.base_format));
+
+            return request_(region.extent, format, [&](gl::offset_t offset, gl::size_t size)
+                {
+                    gl::read_pixels(region, pixel_format, descriptor.data_type, offset, size);
+                });
+        }
+        auto read_texture(gl::texture& texture, gl::rectangle region, gl::uint32_t level = 0u, gl::image::format_e format = gl::image::format_e::rgba_uint8) -> std::optional<gl::uint64_t>
+        {
+            auto const descriptor   = gl::image::descriptor(format);
+            auto const base_format  = static_cast<gl::buffer_base_format_e>(gl::to_underlying(descriptor.base_format));
+            auto const volume       = gl::box{ gl::vector_3u{ region.extent, 1u }, gl::vector_3u{ region.origin, 0u } };
+
+            return request_(region.extent, format, [&](gl::offset_t offset, gl::size_t size)
+                {
+                    gl::get_texture_sub_image(texture.handle(), level, volume, gl::buffer_data_descriptor{ base_format, descriptor.data_type }, offset, size);
+                });
+        }
+        //Marks the end of a frame, frame latencies are counted in calls to advance
+        void advance     ()
+        {
+            ++frame_;
+        }
+        //Hands every request that completed and is old enough to the function, oldest first
+        //Its memory is released when the function returns unless the function passed it to encode
+        template<typename function_t>
+        auto poll        (function_t&& function) -> gl::count_t
+        {
+            auto polled_count = gl::count_t{ 0u };
+            while (!requests_.empty())
+            {
+                auto& request = requests_.front();
+                if (frame_ - request.frame < frame_latency_ || !request.fence.is_signaled()) break;
+
+                auto const latency  = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - request.time);
+                auto const readback = gl::readback{ request.id, request.format, request.dimensions, staging_memory_.subspan(request.allocation.index * staging_alignment_, request.size), frame_ - request.frame, latency };
+
+                polled_      = request.id;
+                is_retained_ = gl::false_;
+                std::invoke(function, readback);
+                if (!is_retained_) release_(request.allocation);
+                polled_.reset();
+
+                ++completed_;
+                total_frame_latency_ += readback.frame_latency;
+                total_latency_       += latency;
+                maximum_latency_      = std::max(maximum_latency_, latency);
+
+                requests_.pop_front();
+                ++polled_count;
+            }
+
+            return polled_count;
+        }
+        //Encodes the readback and writes it to the path on the worker thread, which is started by the first call
+        //Only valid within the callback of poll, the memory stays reserved until the worker copied it
+        void encode      (gl::readback const& readback, std::filesystem::path path, gl::image::extension_e extension = gl::image::extension_e::png)
+        {
+            if (polled_ != readback.id) throw std::invalid_argument{ "readback is not being polled" };
+            if (!worker_.joinable()) worker_ = std::jthread{ [this](std::stop_token stop_token) { work_(stop_token); } };
+
+            {
+                auto const lock = std::scoped_lock{ job_mutex_ };
+                jobs_.emplace(readback, std::move(path), extension, requests_.front().allocation);
+            }
+            encoding_.fetch_add(1u, std::memory_order_relaxed);
+            job_condition_.notify_one();
+
+            is_retained_ = gl::true_;
+        }
+
+        auto statistics  () const -> gl::readback_statistics
+        {
+            return gl::readback_statistics
+            {
+                .in_flight             = requests_.size()                                ,
+                .encoding              = encoding_.load(std::memory_order_relaxed)       ,
+                .completed             = completed_                                      ,
+                .dropped               = dropped_                                        ,
+                .failed                = failed_  .load(std::memory_order_relaxed)       ,
+                .average_frame_latency = completed_ == 0u ? 0.0 : static_cast<gl::float64_t>(total_frame_latency_) / static_cast<gl::float64_t>(completed_),
+                .average_latency       = completed_ == 0u ? std::chrono::nanoseconds{} : total_latency_ / static_cast<gl::int64_t>(completed_),
+                .maximum_latency       = maximum_latency_                                ,
+            };
+        }
+
+    private:
+        static auto constexpr staging_alignment_ = gl::size_t{ 256u };
+
+        struct request
+        {
+            gl::uint64_t                          id;
+            gl::image::format_e                   format;
+            gl::vector_2u                         dimensions;
+            gl::size_t                            size;
+            gl::range_allocator::allocation       allocation;
+            gl::fence                             fence;
+            gl::uint64_t                          frame;
+            std::chrono::steady_clock::time_point time;
+        };
+        struct encode_job
+        {
+            gl::readback                    readback;
+            std::filesystem::path           path;
+            gl::image::extension_e          extension;
+            gl::range_allocator::allocation allocation;
+        };
+
+        //Pixels are packed tightly so the memory can be handed to the image encoder as is
+        template<typename function_t>
+        auto request_(gl::vector_2u dimensions, gl::image::format_e format, function_t&& function) -> std::optional<gl::uint64_t>
+        {
+            auto const descriptor = gl::image::descriptor(format);
+            auto const pixel_size = gl::map_pixel_data_format_component_count(static_cast<gl::pixel_data_format_e>(gl::to_underlying(descriptor.base_format))) * gl::map_pixel_data_component_size(descriptor.data_type);
+            auto const size       = static_cast<gl::size_t>(dimensions.x) * dimensions.y * pixel_size;
+            if (size == gl::size_t{ 0u }) throw std::invalid_argument{ "region is empty" };
+
+            auto allocation = std::optional<gl::range_allocator::allocation>{};
+            {
+                auto const lock = std::scoped_lock{ staging_mutex_ };
+                allocation      = staging_allocator_.allocate(gl::align_up(size, staging_alignment_) / staging_alignment_);
+            }
+            if (!allocation)
+            {
+                ++dropped_;
+                return std::nullopt;
+            }
+
+            auto const pack_alignment = gl::get<gl::data_e::pack_alignment>();
+            gl::pixel_store<gl::packing_mode_e::pack_alignment>(1);
+            staging_buffer_.bind();
+            function(static_cast<gl::offset_t>(allocation->index * staging_alignment_), size);
+            staging_buffer_.unbind();
+            gl::pixel_store<gl::packing_mode_e::pack_alignment>(static_cast<gl::int32_t>(pack_alignment));
+
+            auto& pending = requests_.emplace_back(sequence_++, format, dimensions, size, *allocation, gl::fence{}, frame_, std::chrono::steady_clock::now());
+            pending.fence.place();
+
+            return pending.id;
+        }
+        void release_(gl::range_allocator::allocation const& allocation)
+        {
+            auto const lock = std::scoped_lock{ staging_mutex_ };
+            staging_allocator_.free(allocation);
+        }
+        //Jobs that are still queued when the queue is destroyed are encoded before the worker exits
+        void work_   (std::stop_token stop_token)
+        {
+            while (gl::true_)
+            {
+                auto job = std::optional<encode_job>{};
+                {
+                    auto lock = std::unique_lock{ job_mutex_ };
+                    job_condition_.wait(lock, stop_token, [this] { return !jobs_.empty(); });
+                    if (jobs_.empty()) return;
+
+                    job = std::move(jobs_.front());
+                    jobs_.pop();
+                }
+
+                //The pixels are copied out of the ring first so its memory is available again while the image is encoded
+                auto image = std::optional<gl::image>{};
+                try
+                {
+                    image.emplace(job->readback.format, job->readback.dimensions, job->readback.memory);
+                }
+                catch (...) {}
+                release_(job->allocation);
+
+                try
+                {
+                    if (!image) throw std::runtime_error{ "failed to copy readback" };
+
+                    switch (job->extension)
+                    {
+                        using enum gl::image::extension_e;
+                        case bmp: gl::io::write(job->path, gl::image::encode<bmp>(image->format(), *image)); break;
+                        case hdr: gl::io::write(job->path, gl::image::encode<hdr>(image->format(), *image)); break;
+                        case jpg: gl::io::write(job->path, gl::image::encode<jpg>(image->format(), *image)); break;
+                        case png: gl::io::write(job->path, gl::image::encode<png>(image->format(), *image)); break;
+                    }
+                }
+                catch (...)
+                {
+                    failed_.fetch_add(1u, std::memory_order_relaxed);
+                }
+
+                encoding_.fetch_sub(1u, std::memory_order_relaxed);
+            }
+        }
+
+        gl::pixel_pack_buffer                  staging_buffer_;
+        std::span<gl::byte_t const>            staging_memory_;
+        gl::range_allocator                    staging_allocator_;
+        std::mutex                             staging_mutex_;
+        std::deque<request>                    requests_;
+        gl::uint64_t                           sequence_;
+        gl::uint64_t                           frame_;
+        gl::count_t                            frame_latency_;
+        std::optional<gl::uint64_t>            polled_;
+        gl::bool_t                             is_retained_;
+        gl::count_t                            completed_;
+        gl::count_t                            dropped_;
+        gl::count_t                            total_frame_latency_;
+        std::chrono::nanoseconds               total_latency_;
+        std::chrono::nanoseconds               maximum_latency_;
+        std::queue<encode_job>                 jobs_;
+        std::mutex                             job_mutex_;
+        std::condition_variable_any            job_condition_;
+        std::atomic<gl::count_t>               encoding_;
+        std::atomic<gl::count_t>               failed_;
+        std::jthread                           worker_;
+    };
+}
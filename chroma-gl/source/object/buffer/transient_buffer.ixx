@@ -0,0 +1,129 @@
+export module chroma_gl:object.transient_buffer;
+
+import std;
+import opengl;
+import :object.buffer;
+
+export namespace gl
+{
+    //Linear allocator for per-draw uniform and shader storage data that is rewritten every frame
+    //The buffer is divided into one slice per frame in flight, a single fence per slice guards its reuse
+    class transient_buffer
+    {
+    public:
+        struct allocation
+        {
+            std::span<gl::byte_t> memory;
+            gl::byte_range        range;
+        };
+
+        explicit
+        transient_buffer(gl::size_t frame_size, gl::count_t frame_count = 3u)
+            : buffer_{ gl::align_up(frame_size, frame_alignment_()) * frame_count }
+            , frame_size_{ gl::align_up(frame_size, frame_alignment_()) }, frame_count_{ frame_count }, frame_index_{ 0u }, frame_memory_{}, frame_offset_{ 0u }
+            , uniform_alignment_{ gl::get<gl::data_e::uniform_buffer_offset_alignment>() }, storage_alignment_{ gl::get<gl::data_e::shader_storage_buffer_offset_alignment>() }
+        {
+            if (frame_count == gl::count_t{ 0u }) throw std::invalid_argument{ "frame count must be greater than zero" };
+
+            begin_frame_();
+        }
+
+        auto allocate  (gl::size_t size, gl::size_t alignment) -> allocation
+        {
+            if (alignment == gl::size_t{ 0u }) throw std::invalid_argument{ "alignment must be greater than zero" };
+
+            auto const offset = gl::align_up(frame_offset_, alignment);
+            if (offset + size > frame_size_) throw std::runtime_error{ "transient buffer frame capacity exceeded" };
+
+            frame_offset_ = offset + size;
+            return allocation{ frame_memory_.subspan(offset, size), gl::byte_range{ frame_index_ * frame_size_ + offset, size } };
+        }
+        auto allocate  (gl::buffer_base_target_e target, gl::size_t size) -> allocation
+        {
+            return allocate(size, alignment(target));
+        }
+        template<typename element_t>
+        auto push      (gl::buffer_base_target_e target, element_t const& element) -> gl::byte_range
+        {
+            return push(target, std::span<element_t const>{ &element, 1u });
+        }
+        template<typename element_t>
+        auto push      (gl::buffer_base_target_e target, std::span<element_t const> memory) -> gl::byte_range
+        {
+            static_assert(std::is_trivially_copyable_v<element_t>, "element must be trivially copyable");
+
+            auto const allocation = allocate(target, memory.size_bytes());
+            std::memcpy(allocation.memory.data(), memory.data(), memory.size_bytes());
+
+            return allocation.range;
+        }
+
+        void bind      (gl::buffer_base_target_e target, gl::binding_t binding, gl::byte_range range)
+        {
+            gl::bind_buffer_range(buffer_.handle(), target, binding, gl::index_range{ range.offset, range.size });
+        }
+        void bind      (gl::buffer_base_target_e target, gl::binding_t binding, std::span<gl::byte_range const> ranges)
+        {
+            auto const buffers = std::vector<gl::handle_t>(ranges.size(), buffer_.handle());
+            auto       indices = std::vector<gl::index_range>{};
+            indices.reserve(ranges.size());
+            std::ranges::transform(ranges, std::back_inserter(indices), [](gl::byte_range const& range) { return gl::index_range{ range.offset, range.size }; });
+
+            gl::bind_buffers_range(buffers, target, binding, indices);
+        }
+
+        //Fences the current slice and moves on to the next, only blocks when the GPU is a full ring behind
+        void next_frame()
+        {
+            buffer_.commit();
+            frame_index_ = (frame_index_ + 1u) % frame_count_;
+
+            begin_frame_();
+        }
+
+        auto alignment (gl::buffer_base_target_e target) const -> gl::size_t
+        {
+            switch (target)
+            {
+                case gl::buffer_base_target_e::uniform_buffer       : return uniform_alignment_;
+                case gl::buffer_base_target_e::shader_storage_buffer: return storage_alignment_;
+
+                default: return gl::size_t{ 4u };
+            }
+        }
+        auto frame_size() const -> gl::size_t
+        {
+            return frame_size_;
+        }
+        auto used      () const -> gl::size_t
+        {
+            return frame_offset_;
+        }
+        auto handle    () -> gl::handle_t
+        {
+            return buffer_.handle();
+        }
+
+    private:
+        //Slices start on a boundary that satisfies every binding target, offsets within a slice only have to be aligned relative to its start
+        static auto frame_alignment_() -> gl::size_t
+        {
+            return std::max<gl::size_t>({ gl::get<gl::data_e::minimum_map_buffer_alignment>(), gl::get<gl::data_e::uniform_buffer_offset_alignment>(), gl::get<gl::data_e::shader_storage_buffer_offset_alignment>() });
+        }
+
+        void begin_frame_()
+        {
+            frame_memory_ = buffer_.map(gl::index_range{ frame_index_ * frame_size_, frame_size_ });
+            frame_offset_ = gl::size_t{ 0u };
+        }
+
+        gl::stream_buffer<gl::byte_t> buffer_;
+        gl::size_t                    frame_size_;
+        gl::count_t                   frame_count_;
+        gl::index_t                   frame_index_;
+        std::span<gl::byte_t>         frame_memory_;
+        gl::size_t                    frame_offset_;
+        gl::size_t                    uniform_alignment_;
+        gl::size_t                    storage_alignment_;
+    };
+}
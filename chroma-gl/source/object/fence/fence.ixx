@@ -10,40 +10,74 @@ export namespace gl
     public:
         explicit 
         fence() 
-            : sync_{ nullptr } {}
+            : sync_{ nullptr }, is_flushed_{ gl::false_ } {}
         fence(fence&& object) noexcept
-            : sync_{ std::exchange(object.sync_, gl::sync_t{}) } {}
+            : sync_{ std::exchange(object.sync_, gl::sync_t{}) }, is_flushed_{ object.is_flushed_ } {}
        ~fence() 
         {
             gl::delete_sync(sync_);
         }
 
-        void place    ()
+        void place       ()
         {
-            if (!sync_) sync_ = gl::fence_sync();
+            if (sync_) return;
+
+            sync_       = gl::fence_sync();
+            is_flushed_ = gl::false_;
+        }
+        auto is_signaled () -> gl::bool_t
+        {
+            if (!sync_) return gl::true_;
+
+            auto const status = gl::client_wait_sync(sync_, flush_command_(), gl::time_t{ 0u });
+            if (status == gl::synchronization_status_e::wait_failed    ) throw std::runtime_error{ "sync wait failed" };
+            if (status == gl::synchronization_status_e::timeout_expired) return gl::false_;
+
+            release_();
+            return gl::true_;
         }
-        void wait     ()
+        void wait        ()
         {
-            auto       status  = gl::client_wait_sync(sync_, gl::synchronization_command_e::flush, gl::time_t{ 0u });
+            if (!sync_) return;
+
             auto const timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds{ 1u }).count();
+            auto       status  = gl::client_wait_sync(sync_, flush_command_(), gl::time_t{ 0u });
             while (status == gl::synchronization_status_e::timeout_expired)
             {
-                status = gl::client_wait_sync(sync_, gl::synchronization_command_e::flush, timeout);
+                status = gl::client_wait_sync(sync_, flush_command_(), timeout);
             }
 
             if (status == gl::synchronization_status_e::wait_failed) throw std::runtime_error{ "sync wait failed" };
 
-            gl::delete_sync(sync_);
+            release_();
         }
 
         auto operator=(fence&& object) noexcept -> fence&
         {
-            if (this != &object) sync_ = std::exchange(object.sync_, sync_);
+            if (this != &object)
+            {
+                sync_       = std::exchange(object.sync_, sync_);
+                is_flushed_ = std::exchange(object.is_flushed_, is_flushed_);
+            }
 
             return *this;
         }
 
     private:
+        //Commands only have to be flushed once for the sync object to eventually signal
+        auto flush_command_() -> gl::synchronization_command_e
+        {
+            if (is_flushed_) return gl::synchronization_command_e::none;
+
+            is_flushed_ = gl::true_;
+            return gl::synchronization_command_e::flush;
+        }
+        void release_      ()
+        {
+            gl::delete_sync(std::exchange(sync_, gl::sync_t{}));
+        }
+
         gl::sync_t sync_;
+        gl::bool_t is_flushed_;
     };
 }
@@ -6,32 +6,110 @@ import :object.fence;
 
 export namespace gl
 {
-    using memory_lock_t = std::tuple<gl::fence, gl::index_range>;
+    using timeline_t = gl::uint64_t;
+    struct memory_lock_t
+    {
+        gl::timeline_t               value;
+        gl::fence                    fence;
+        std::vector<gl::index_range> ranges;
+    };
     class memory_locker
     {
     public:
         memory_locker()
-            : locks_{} {}
+            : pending_{}, locks_{}, spare_ranges_{}, timeline_{ 1u }, completed_{ 0u } {}
 
-        void lock(gl::index_range range)
+        //Locked ranges are collected until the next commit, which places a single fence for all of them
+        void lock  (gl::index_range range)
         {
-            auto& [fence, _] = locks_.emplace_back(gl::fence{}, range);
-            fence.place();
+            if (range.is_empty()) return;
+
+            if (!pending_.empty())
+            {
+                auto& last = pending_.back();
+                if (last.index + last.count == range.index)
+                {
+                    last.count += range.count;
+                    return;
+                }
+            }
+
+            pending_.emplace_back(range);
         }
-        void wait(gl::index_range range)
+        void commit()
         {
-            auto remaining_locks = std::vector<gl::memory_lock_t>{};
-            std::ranges::for_each(locks_, [&](gl::memory_lock_t& lock)
-                {
-                    auto& [lock_fence, lock_range] = lock;
-                    if   (gl::range_overlaps(lock_range, range)) lock_fence     .wait();
-                    else                                         remaining_locks.emplace_back(std::move(lock));
-                });
-            
-            locks_ = std::move(remaining_locks);
+            if (pending_.empty()) return;
+
+            auto& lock = locks_.emplace_back(timeline_++, gl::fence{}, std::exchange(pending_, take_spare_ranges_()));
+            lock.fence.place();
+        }
+        void retire()
+        {
+            while (!locks_.empty() && locks_.front().fence.is_signaled()) pop_front_();
+        }
+
+        auto try_wait(gl::index_range range) -> gl::bool_t
+        {
+            if (overlaps_(pending_, range)) commit();
+
+            retire();
+            return std::ranges::none_of(locks_, [&](gl::memory_lock_t const& lock) { return overlaps_(lock.ranges, range); });
+        }
+        void wait    (gl::index_range range)
+        {
+            if (overlaps_(pending_, range)) commit();
+
+            auto const last_overlap = std::ranges::find_last_if(locks_, [&](gl::memory_lock_t const& lock) { return overlaps_(lock.ranges, range); });
+            if (last_overlap.empty()) return;
+
+            //Fences signal in submission order, every older lock has completed as well
+            auto const retired_count = std::ranges::distance(locks_.begin(), last_overlap.begin()) + 1;
+            last_overlap.front().fence.wait();
+            for (auto index = decltype(retired_count){ 0 }; index < retired_count; ++index) pop_front_();
+        }
+
+        auto timeline         () const -> gl::timeline_t
+        {
+            return timeline_ - 1u;
+        }
+        auto completed        () const -> gl::timeline_t
+        {
+            return completed_;
+        }
+        auto outstanding_count() const -> gl::count_t
+        {
+            return locks_.size();
         }
 
     private:
-        std::vector<gl::memory_lock_t> locks_;
+        static auto overlaps_(std::vector<gl::index_range> const& ranges, gl::index_range range) -> gl::bool_t
+        {
+            return std::ranges::any_of(ranges, [&](gl::index_range const& lock_range) { return gl::range_overlaps(lock_range, range); });
+        }
+
+        auto take_spare_ranges_() -> std::vector<gl::index_range>
+        {
+            if (spare_ranges_.empty()) return {};
+
+            auto ranges = std::move(spare_ranges_.back());
+            spare_ranges_.pop_back();
+
+            return ranges;
+        }
+        void pop_front_        ()
+        {
+            auto& lock = locks_.front();
+            completed_ = lock.value;
+            lock.ranges.clear();
+            spare_ranges_.emplace_back(std::move(lock.ranges));
+
+            locks_.pop_front();
+        }
+
+        std::vector<gl::index_range>              pending_;
+        std::deque<gl::memory_lock_t>             locks_;
+        std::vector<std::vector<gl::index_range>> spare_ranges_;
+        gl::timeline_t                            timeline_;
+        gl::timeline_t                            completed_;
     };
 }
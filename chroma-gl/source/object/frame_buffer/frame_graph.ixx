@@ -0,0 +1,482 @@
+export module chroma_gl:object.frame_graph;
+
+import std;
+import glm;
+import opengl;
+import :object.texture;
+
+export namespace gl
+{
+    //Describes a transient render target, its dimensions are a fraction of the dimensions of the graph
+    struct frame_graph_target
+    {
+        gl::texture_format_e format;
+        gl::vector_2f        scale        = gl::vector_2f{ 1.0f };
+        gl::uint32_t         sample_count = 1u;
+    };
+    struct frame_graph_statistics
+    {
+        gl::count_t pass_count         = 0u;
+        gl::count_t culled_pass_count  = 0u;
+        gl::count_t target_count       = 0u;
+        gl::count_t frame_buffer_count = 0u;
+        gl::size_t  unaliased_memory   = 0u; //Memory the live transient targets would take if each had its own texture
+        gl::size_t  aliased_memory     = 0u; //Memory of the pooled textures the compiled graph actually uses
+        gl::size_t  pool_memory        = 0u; //Memory held by the pool, including targets kept for reuse after a resize
+    };
+
+    //Passes declare the targets they read and write, the graph culls passes whose results are never used and orders the rest
+    //Transient targets are assigned textures from a pool keyed by format, dimensions and sample count
+    //Targets whose lifetimes do not overlap share a texture, framebuffers are cached per attachment set
+    class frame_graph
+    {
+    public:
+        enum class resource_t : gl::uint32_t;
+
+        using attachment_e = gl::frame_buffer_attachment_e;
+        using execute_t    = std::function<void(gl::frame_graph&)>;
+
+        class pass
+        {
+        public:
+            auto read    (resource_t resource) -> pass&
+            {
+                reads_.emplace_back(resource);
+                return *this;
+            }
+            auto write   (resource_t resource, attachment_e attachment) -> pass&
+            {
+                writes_.emplace_back(resource, attachment);
+                return *this;
+            }
+            //Passes with effects outside of the graph, e.g. drawing to the default framebuffer, are never culled
+            auto preserve() -> pass&
+            {
+                is_preserved_ = gl::true_;
+                return *this;
+            }
+
+        private:
+            friend class frame_graph;
+
+            pass(std::string name, execute_t execute)
+                : name_{ std::move(name) }, execute_{ std::move(execute) }, reads_{}, writes_{}, is_preserved_{ gl::false_ } {}
+
+            std::string                                      name_;
+            execute_t                                        execute_;
+            std::vector<resource_t>                          reads_;
+            std::vector<std::pair<resource_t, attachment_e>> writes_;
+            gl::bool_t                                       is_preserved_;
+        };
+
+        explicit
+        frame_graph(gl::vector_2u dimensions, gl::count_t retain_count = 2u)
+            : dimensions_{ dimensions }, passes_{}, resources_{}, order_{}, pool_{}, frame_buffers_{}, statistics_{}, retain_count_{ retain_count }, is_compiled_{ gl::false_ } {}
+       ~frame_graph()
+        {
+            std::ranges::for_each(frame_buffers_, [](auto const& value) { gl::delete_frame_buffer(value.second); });
+        }
+
+        auto create          (std::string name, gl::frame_graph_target const& target) -> resource_t
+        {
+            if (target.sample_count == 0u) throw std::invalid_argument{ "sample count must be greater than zero" };
+
+            is_compiled_ = gl::false_;
+            resources_.emplace_back(resource_{ std::move(name), target, nullptr });
+            return static_cast<resource_t>(resources_.size() - 1u);
+        }
+        //Imported textures are owned elsewhere, passes writing them are never culled and they are never invalidated
+        auto import_texture  (std::string name, gl::texture_2d& texture) -> resource_t
+        {
+            is_compiled_ = gl::false_;
+            resources_.emplace_back(resource_{ std::move(name), std::nullopt, &texture });
+            return static_cast<resource_t>(resources_.size() - 1u);
+        }
+        auto add_pass        (std::string name, execute_t execute) -> pass&
+        {
+            is_compiled_ = gl::false_;
+            return passes_.emplace_back(pass{ std::move(name), std::move(execute) });
+        }
+        //Keeps a transient target alive until the end of the graph so it can be read after execute
+        void present         (resource_t resource)
+        {
+            is_compiled_ = gl::false_;
+            resources_.at(gl::to_underlying(resource)).is_output = gl::true_;
+        }
+
+        //Removes all passes and resources, pooled targets and cached framebuffers are kept
+        void clear           ()
+        {
+            passes_   .clear();
+            resources_.clear();
+            order_    .clear();
+            is_compiled_ = gl::false_;
+        }
+        //Targets of the previous dimensions stay pooled for a few compilations in case the dimensions change back
+        void resize          (gl::vector_2u dimensions)
+        {
+            if (dimensions == dimensions_) return;
+
+            dimensions_  = dimensions;
+            is_compiled_ = gl::false_;
+        }
+
+        void compile         ()
+        {
+            auto const is_live = cull_();
+            schedule_(is_live);
+            allocate_();
+
+            is_compiled_ = gl::true_;
+        }
+        void execute         ()
+        {
+            if (!is_compiled_) compile();
+
+            for (auto position = gl::index_t{ 0u }; position < order_.size(); ++position)
+            {
+                auto& pass = passes_.at(order_.at(position));
+                gl::push_debug_group(static_cast<gl::handle_t>(order_.at(position)), pass.name_);
+
+                auto frame_buffer = gl::null_object;
+                if (!pass.writes_.empty())
+                {
+                    frame_buffer = frame_buffer_(pass);
+                    gl::bind_frame_buffer(frame_buffer, gl::frame_buffer_target_e::read_write);
+                    gl::viewport(gl::rectangle{ resources_.at(gl::to_underlying(pass.writes_.front().first)).dimensions });
+
+                    invalidate_(frame_buffer, pass, position, gl::true_);
+                }
+
+                pass.execute_(*this);
+
+                if (!pass.writes_.empty())
+                {
+                    invalidate_(frame_buffer, pass, position, gl::false_);
+                    gl::bind_frame_buffer(gl::null_object, gl::frame_buffer_target_e::read_write);
+                }
+
+                gl::pop_debug_group();
+            }
+        }
+
+        auto texture            (resource_t resource) -> gl::texture_2d&
+        {
+            auto& value = resources_.at(gl::to_underlying(resource));
+            if (value.imported) return *value.imported;
+            if (!value.physical) throw std::runtime_error{ "resource has no target assigned" };
+
+            return std::get<gl::texture_2d>(value.physical->texture);
+        }
+        auto multisample_texture(resource_t resource) -> gl::multisample_texture_2d&
+        {
+            auto& value = resources_.at(gl::to_underlying(resource));
+            if (!value.physical) throw std::runtime_error{ "resource has no target assigned" };
+
+            return std::get<gl::multisample_texture_2d>(value.physical->texture);
+        }
+        auto dimensions         (resource_t resource) const -> gl::vector_2u
+        {
+            return resources_.at(gl::to_underlying(resource)).dimensions;
+        }
+        auto dimensions         () const -> gl::vector_2u
+        {
+            return dimensions_;
+        }
+        auto statistics         () const -> gl::frame_graph_statistics
+        {
+            return statistics_;
+        }
+
+    private:
+        static auto constexpr npos_ = std::numeric_limits<gl::index_t>::max();
+
+        struct key_
+        {
+            auto operator==(key_ const&) const -> gl::bool_t = default;
+
+            gl::texture_format_e format;
+            gl::vector_2u        dimensions;
+            gl::uint32_t         sample_count;
+        };
+        struct target_
+        {
+            key_                                                        key;
+            std::variant<gl::texture_2d, gl::multisample_texture_2d>   texture;
+            gl::size_t                                                  size;
+            gl::count_t                                                 idle_count;
+            gl::bool_t                                                  is_free;
+        };
+        struct resource_
+        {
+            std::string                           name;
+            std::optional<gl::frame_graph_target> target;
+            gl::texture_2d*                       imported;
+            gl::vector_2u                         dimensions = {};
+            gl::bool_t                            is_output  = gl::false_;
+            gl::index_t                           first_use  = npos_;
+            gl::index_t                           last_use   = npos_;
+            target_*                              physical   = nullptr;
+        };
+        using frame_buffer_key_t = std::vector<std::pair<attachment_e, gl::handle_t>>;
+
+        static auto handle_(target_& target) -> gl::handle_t
+        {
+            return std::visit([](auto& texture) { return texture.handle(); }, target.texture);
+        }
+
+        //Walks back from preserved passes and passes writing outputs or imported textures, anything not reached is culled
+        auto cull_() -> std::vector<gl::bool_t>
+        {
+            auto is_live   = std::vector<gl::bool_t>(passes_.size(), gl::false_);
+            auto is_needed = std::vector<gl::bool_t>(resources_.size(), gl::false_);
+            for (auto index = gl::index_t{ 0u }; index < resources_.size(); ++index)
+            {
+                is_needed.at(index) = resources_.at(index).is_output || resources_.at(index).imported != nullptr;
+            }
+
+            for (auto is_changed = gl::true_; is_changed;)
+            {
+                is_changed = gl::false_;
+                for (auto index = gl::index_t{ 0u }; index < passes_.size(); ++index)
+                {
+                    auto const& pass = passes_.at(index);
+                    if (is_live.at(index)) continue;
+                    if (!pass.is_preserved_ && std::ranges::none_of(pass.writes_, [&](auto const& write) { return is_needed.at(gl::to_underlying(write.first)); })) continue;
+
+                    is_live.at(index) = gl::true_;
+                    is_changed        = gl::true_;
+                    std::ranges::for_each(pass.reads_, [&](resource_t resource) { is_needed.at(gl::to_underlying(resource)) = gl::true_; });
+                }
+            }
+
+            statistics_.pass_count        = static_cast<gl::count_t>(std::ranges::count(is_live, gl::true_));
+            statistics_.culled_pass_count = static_cast<gl::count_t>(passes_.size()) - statistics_.pass_count;
+            return is_live;
+        }
+        //Every writer of a resource runs before its readers, writers of the same resource keep their declaration order
+        //Independent passes are ordered by declaration, a cycle cannot be scheduled and throws
+        void schedule_(std::vector<gl::bool_t> const& is_live)
+        {
+            auto edges     = std::vector<std::vector<gl::index_t>>(passes_.size());
+            auto in_degree = std::vector<gl::count_t>(passes_.size(), 0u);
+            auto writers   = std::vector<std::vector<gl::index_t>>(resources_.size());
+            auto const add_edge = [&](gl::index_t from, gl::index_t to)
+                {
+                    if (from == to || !is_live.at(from) || !is_live.at(to)) return;
+
+                    edges.at(from).emplace_back(to);
+                    ++in_degree.at(to);
+                };
+
+            for (auto index = gl::index_t{ 0u }; index < passes_.size(); ++index)
+            {
+                for (auto const& [resource, attachment] : passes_.at(index).writes_)
+                {
+                    auto& resource_writers = writers.at(gl::to_underlying(resource));
+                    if (!resource_writers.empty()) add_edge(resource_writers.back(), index);
+                    resource_writers.emplace_back(index);
+                }
+            }
+            for (auto index = gl::index_t{ 0u }; index < passes_.size(); ++index)
+            {
+                for (auto const resource : passes_.at(index).reads_)
+                {
+                    auto const& resource_writers = writers.at(gl::to_underlying(resource));
+                    if (resource_writers.empty() && !resources_.at(gl::to_underlying(resource)).imported) throw std::runtime_error{ std::format("pass '{}' reads '{}' which is never written", passes_.at(index).name_, resources_.at(gl::to_underlying(resource)).name) };
+
+                    std::ranges::for_each(resource_writers, [&](gl::index_t writer) { add_edge(writer, index); });
+                }
+            }
+
+            auto ready = std::priority_queue<gl::index_t, std::vector<gl::index_t>, std::greater<gl::index_t>>{};
+            for (auto index = gl::index_t{ 0u }; index < passes_.size(); ++index)
+            {
+                if (is_live.at(index) && in_degree.at(index) == 0u) ready.push(index);
+            }
+
+            order_.clear();
+            while (!ready.empty())
+            {
+                auto const index = ready.top();
+                ready.pop();
+                order_.emplace_back(index);
+
+                for (auto const next : edges.at(index))
+                {
+                    if (--in_degree.at(next) == 0u) ready.push(next);
+                }
+            }
+
+            if (order_.size() != statistics_.pass_count) throw std::runtime_error{ "frame graph contains a cycle" };
+        }
+        //Targets are taken from the pool at their first use and returned after their last, so later targets can alias them
+        void allocate_()
+        {
+            std::ranges::for_each(pool_, [](target_& target) { target.is_free = gl::true_; });
+            for (auto& resource : resources_)
+            {
+                resource.first_use  = npos_;
+                resource.last_use   = npos_;
+                resource.physical   = nullptr;
+                resource.dimensions = resource.imported ? resource.imported->dimensions() : scaled_(resource.target->scale);
+            }
+
+            for (auto position = gl::index_t{ 0u }; position < order_.size(); ++position)
+            {
+                auto const& pass = passes_.at(order_.at(position));
+                auto const  use  = [&](resource_t resource)
+                    {
+                        auto& value = resources_.at(gl::to_underlying(resource));
+                        if (value.first_use == npos_) value.first_use = position;
+                        value.last_use = position;
+                    };
+
+                std::ranges::for_each(pass.reads_ , use);
+                std::ranges::for_each(pass.writes_, [&](auto const& write) { use(write.first); });
+            }
+
+            statistics_.unaliased_memory = gl::size_t{ 0u };
+            for (auto position = gl::index_t{ 0u }; position < order_.size(); ++position)
+            {
+                for (auto& resource : resources_)
+                {
+                    if (resource.imported || resource.first_use != position) continue;
+
+                    resource.physical             = &acquire_(key_{ resource.target->format, resource.dimensions, resource.target->sample_count });
+                    statistics_.unaliased_memory += resource.physical->size;
+                }
+                for (auto& resource : resources_)
+                {
+                    if (resource.physical && resource.last_use == position && !resource.is_output) resource.physical->is_free = gl::true_;
+                }
+            }
+
+            trim_();
+        }
+        auto acquire_(key_ const& key) -> target_&
+        {
+            auto const iterator = std::ranges::find_if(pool_, [&](target_ const& target) { return target.is_free && target.key == key; });
+            if (iterator != pool_.end())
+            {
+                iterator->is_free    = gl::false_;
+                iterator->idle_count = 0u;
+                return *iterator;
+            }
+
+            auto const size = gl::map_texture_format_size(key.format) * key.dimensions.x * key.dimensions.y * key.sample_count;
+            if (key.sample_count > 1u) return pool_.emplace_back(target_{ key, gl::multisample_texture_2d{ key.format, key.dimensions, key.sample_count }, size, 0u, gl::false_ });
+            else                       return pool_.emplace_back(target_{ key, gl::texture_2d            { key.format, key.dimensions, gl::false_       }, size, 0u, gl::false_ });
+        }
+        //Targets no resource was assigned for retain_count compilations are released along with the framebuffers using them
+        void trim_()
+        {
+            auto const is_used = [&](target_ const& target) { return std::ranges::any_of(resources_, [&](resource_ const& resource) { return resource.physical == &target; }); };
+
+            statistics_.aliased_memory = gl::size_t{ 0u };
+            statistics_.pool_memory    = gl::size_t{ 0u };
+            for (auto iterator = pool_.begin(); iterator != pool_.end();)
+            {
+                if (is_used(*iterator))
+                {
+                    statistics_.aliased_memory += iterator->size;
+                    statistics_.pool_memory    += iterator->size;
+                    ++iterator;
+                    continue;
+                }
+                if (++iterator->idle_count <= retain_count_)
+                {
+                    statistics_.pool_memory += iterator->size;
+                    ++iterator;
+                    continue;
+                }
+
+                auto const handle = handle_(*iterator);
+                std::erase_if(frame_buffers_, [&](auto const& value)
+                    {
+                        if (std::ranges::none_of(value.first, [&](auto const& attachment) { return attachment.second == handle; })) return gl::false_;
+
+                        gl::delete_frame_buffer(value.second);
+                        return gl::true_;
+                    });
+                iterator = pool_.erase(iterator);
+            }
+
+            statistics_.target_count       = static_cast<gl::count_t>(pool_.size());
+            statistics_.frame_buffer_count = static_cast<gl::count_t>(frame_buffers_.size());
+        }
+
+        auto frame_buffer_(pass const& pass) -> gl::handle_t
+        {
+            auto key = frame_buffer_key_t{};
+            for (auto const& [resource, attachment] : pass.writes_)
+            {
+                auto& value = resources_.at(gl::to_underlying(resource));
+                key.emplace_back(attachment, value.imported ? value.imported->handle() : handle_(*value.physical));
+            }
+            std::ranges::sort(key);
+
+            auto const iterator = frame_buffers_.find(key);
+            if (iterator != frame_buffers_.end()) return iterator->second;
+
+            auto const frame_buffer = gl::create_frame_buffer();
+            auto       sources      = std::vector<gl::frame_buffer_source_e>{};
+            for (auto const& [attachment, texture] : key)
+            {
+                gl::frame_buffer_texture(frame_buffer, texture, attachment, gl::uint32_t{ 0u });
+                if (attachment >= attachment_e::color_0 && attachment <= attachment_e::color_7)
+                {
+                    sources.emplace_back(gl::frame_buffer_source_e::color_0 + (gl::to_underlying(attachment) - gl::to_underlying(attachment_e::color_0)));
+                }
+            }
+
+            if (sources.empty())
+            {
+                gl::frame_buffer_read_buffer(frame_buffer, gl::frame_buffer_source_e::none);
+                gl::frame_buffer_draw_buffer(frame_buffer, gl::frame_buffer_source_e::none);
+            }
+            else gl::frame_buffer_draw_buffers(frame_buffer, sources);
+
+            if (gl::check_frame_buffer_status(frame_buffer, gl::frame_buffer_target_e::read_write) != gl::frame_buffer_status_e::complete)
+            {
+                gl::delete_frame_buffer(frame_buffer);
+                throw std::runtime_error{ std::format("frame buffer of pass '{}' is not complete", pass.name_) };
+            }
+
+            frame_buffers_.emplace(std::move(key), frame_buffer);
+            statistics_.frame_buffer_count = static_cast<gl::count_t>(frame_buffers_.size());
+            return frame_buffer;
+        }
+        //Before its first use a pooled target still holds whatever the previous alias left, after its last use its contents are dead
+        void invalidate_(gl::handle_t frame_buffer, pass const& pass, gl::index_t position, gl::bool_t is_first_use)
+        {
+            auto attachments = std::vector<attachment_e>{};
+            for (auto const& [resource, attachment] : pass.writes_)
+            {
+                auto const& value = resources_.at(gl::to_underlying(resource));
+                if (value.imported) continue;
+                if ( is_first_use && (value.first_use != position || std::ranges::contains(pass.reads_, resource))) continue;
+                if (!is_first_use && (value.last_use  != position || value.is_output                             )) continue;
+
+                attachments.emplace_back(attachment);
+            }
+
+            if (!attachments.empty()) gl::invalidate_frame_buffer_data(frame_buffer, attachments);
+        }
+
+        auto scaled_(gl::vector_2f scale) const -> gl::vector_2u
+        {
+            return glm::max(gl::vector_2u{ gl::vector_2f{ dimensions_ } * scale }, gl::vector_2u{ 1u });
+        }
+
+        gl::vector_2u                                      dimensions_;
+        std::deque<pass>                                   passes_;
+        std::vector<resource_>                             resources_;
+        std::vector<gl::index_t>                           order_;
+        std::list<target_>                                 pool_;
+        std::map<frame_buffer_key_t, gl::handle_t>         frame_buffers_;
+        gl::frame_graph_statistics                         statistics_;
+        gl::count_t                                        retain_count_;
+        gl::bool_t                                         is_compiled_;
+    };
+}
@@ -2,6 +2,7 @@ export module chroma_gl:object;
 
 import std;
 import opengl;
+import :config;
 
 export namespace gl
 {
@@ -33,6 +34,17 @@ export namespace gl
             return *this;
         }
 
+        //Issues the barrier bits a use of an object depends on if a shader wrote to it, debug builds report every hazard resolved
+        //Transfers check the object right before they are issued, draws, dispatches and pixel transfers resolve their bindings themselves
+        static void require_barrier(gl::barrier::resource_e resource, gl::handle_t handle, gl::memory_barrier_e barrier)
+        {
+            auto const required = gl::require_memory_barrier(resource, handle, barrier);
+            if constexpr (gl::config::build_configuration == gl::config::build_configuration_e::debug)
+            {
+                if (required != gl::memory_barrier_e{}) gl::debug_message_insert(handle, gl::debug_type_e::performance, gl::debug_severity_e::notification, std::format("resolved shader write hazard on object {} with barrier bits {:#x}", gl::to_underlying(handle), gl::to_underlying(required)));
+            }
+        }
+
     private:
         gl::handle_t handle_;
     };
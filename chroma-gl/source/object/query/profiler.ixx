@@ -0,0 +1,312 @@
+export module chroma_gl:object.profiler;
+
+import std;
+import opengl;
+import :io;
+
+export namespace gl
+{
+    struct profiler_timing
+    {
+        std::chrono::nanoseconds minimum = {};
+        std::chrono::nanoseconds average = {};
+        std::chrono::nanoseconds p99     = {};
+    };
+    struct profiler_statistics
+    {
+        std::string         name;
+        gl::count_t         samples = 0u;
+        gl::profiler_timing cpu     = {};
+        gl::profiler_timing gpu     = {};
+    };
+
+    //Times named zones on both the CPU and the GPU, GPU time is measured with timestamp queries from one pool per frame in flight
+    //A frame is only harvested once the last query it recorded reports its result available, so the CPU never waits on the GPU
+    //Frames whose pool comes around again while their results are still pending are dropped instead
+    class profiler
+    {
+    public:
+        using clock_t = std::chrono::steady_clock;
+
+        //Closes its zone when it goes out of scope, zones nest but have to be closed before the frame ends
+        class zone
+        {
+        public:
+            zone(zone&& other) noexcept
+                : profiler_{ std::exchange(other.profiler_, nullptr) }, index_{ other.index_ } {}
+           ~zone()
+            {
+                if (profiler_) profiler_->end_zone_(index_);
+            }
+
+            auto operator=(zone&& other) noexcept -> zone&
+            {
+                if (this != &other)
+                {
+                    if (profiler_) profiler_->end_zone_(index_);
+
+                    profiler_ = std::exchange(other.profiler_, nullptr);
+                    index_    = other.index_;
+                }
+
+                return *this;
+            }
+
+        private:
+            friend class profiler;
+
+            zone(gl::profiler& profiler, gl::index_t index)
+                : profiler_{ &profiler }, index_{ index } {}
+
+            gl::profiler* profiler_;
+            gl::index_t   index_;
+        };
+
+        explicit
+        profiler(gl::count_t frame_count = 3u, gl::count_t zone_capacity = 256u, gl::count_t history_size = 128u, gl::count_t trace_capacity = 65536u)
+            : frames_{}, names_{}, name_indices_{}, histories_{}, trace_events_{}, frame_index_{ 0u }, depth_{ 0u }
+            , history_size_{ std::max<gl::count_t>(history_size, 1u) }, trace_capacity_{ trace_capacity }, dropped_frames_{ 0u }, overflowed_zones_{ 0u }
+            , cpu_origin_{ clock_t::now() }, gpu_origin_{ gl::get<gl::data_e::timestamp>() }
+        {
+            if (frame_count   == 0u) throw std::invalid_argument{ "frame count must be greater than zero"   };
+            if (zone_capacity == 0u) throw std::invalid_argument{ "zone capacity must be greater than zero" };
+
+            frames_.resize(frame_count);
+            std::ranges::for_each(frames_, [&](frame_& frame) { frame.queries = gl::create_queries(gl::query_target_e::timestamp, zone_capacity * 2u); });
+        }
+       ~profiler()
+        {
+            std::ranges::for_each(frames_, [](frame_ const& frame) { gl::delete_queries(frame.queries); });
+        }
+
+        //Opens a zone labeled with a debug group, zones beyond the capacity of the pool are still timed on the CPU
+        auto scope(std::string const& name) -> zone
+        {
+            auto&      frame      = frames_.at(frame_index_);
+            auto const name_index = intern_(name);
+            auto const index      = static_cast<gl::index_t>(frame.records.size());
+
+            gl::push_debug_group(static_cast<gl::handle_t>(name_index), name);
+
+            auto query = npos_;
+            if (frame.query_count + 2u <= frame.queries.size())
+            {
+                query              = frame.query_count;
+                frame.query_count += 2u;
+                record_query_(frame, query);
+            }
+            else ++overflowed_zones_;
+
+            ++depth_;
+            frame.records.emplace_back(record_{ name_index, query, clock_t::now(), clock_t::time_point{} });
+            return zone{ *this, index };
+        }
+
+        //Harvests every frame whose results arrived and hands the oldest pool to the next frame
+        void next_frame()
+        {
+            if (depth_ != 0u) throw std::runtime_error{ "zones are still open at the end of the frame" };
+
+            auto& current = frames_.at(frame_index_);
+            current.is_pending = !current.records.empty();
+            frame_index_       = (frame_index_ + 1u) % frames_.size();
+
+            harvest_();
+
+            auto& next = frames_.at(frame_index_);
+            if (next.is_pending) ++dropped_frames_;
+
+            next.records.clear();
+            next.query_count = 0u;
+            next.last_query  = std::nullopt;
+            next.is_pending  = gl::false_;
+        }
+
+        auto statistics      () const -> std::vector<gl::profiler_statistics>
+        {
+            auto statistics = std::vector<gl::profiler_statistics>{};
+            statistics.reserve(names_.size());
+
+            for (auto index = gl::index_t{ 0u }; index < names_.size(); ++index)
+            {
+                auto const& history = histories_.at(index);
+                statistics.emplace_back(gl::profiler_statistics{ names_.at(index), history.samples, timing_(history.cpu), timing_(history.gpu) });
+            }
+
+            return statistics;
+        }
+        auto dropped_frames  () const -> gl::count_t
+        {
+            return dropped_frames_;
+        }
+        auto overflowed_zones() const -> gl::count_t
+        {
+            return overflowed_zones_;
+        }
+
+        //Writes the harvested zones as a Chrome trace, which chrome://tracing and Perfetto both open
+        //CPU and GPU zones are placed on separate tracks, their clocks are aligned once when the profiler is created
+        void write_trace(std::filesystem::path const& path) const
+        {
+            auto const escape = [](std::string_view value)
+                {
+                    auto result = std::string{};
+                    for (auto const character : value)
+                    {
+                        if (character == '"' || character == '\\') result += '\\';
+                        if (static_cast<gl::uint8_t>(character) >= 0x20u) result += character;
+                    }
+
+                    return result;
+                };
+
+            auto trace = std::string{ "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" };
+            trace += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU\"}},";
+            trace += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"GPU\"}}";
+
+            for (auto const& event : trace_events_)
+            {
+                trace += std::format(
+                    ",{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                    escape(names_.at(event.name)), event.is_gpu ? "gpu" : "cpu", event.is_gpu ? 1 : 0,
+                    std::chrono::duration<gl::float64_t, std::micro>{ event.begin    }.count(),
+                    std::chrono::duration<gl::float64_t, std::micro>{ event.duration }.count());
+            }
+            trace += "]}";
+
+            gl::io::write(path, gl::as_bytes(trace));
+        }
+
+    private:
+        static auto constexpr npos_ = std::numeric_limits<gl::index_t>::max();
+
+        struct record_
+        {
+            gl::index_t         name;
+            gl::index_t         query;
+            clock_t::time_point cpu_begin;
+            clock_t::time_point cpu_end;
+        };
+        struct frame_
+        {
+            std::vector<gl::handle_t>   queries     = {};
+            std::vector<record_>        records     = {};
+            gl::count_t                 query_count = 0u;
+            std::optional<gl::handle_t> last_query  = std::nullopt;
+            gl::bool_t                  is_pending  = gl::false_;
+        };
+        struct history_
+        {
+            std::deque<std::chrono::nanoseconds> cpu     = {};
+            std::deque<std::chrono::nanoseconds> gpu     = {};
+            gl::count_t                          samples = 0u;
+        };
+        struct trace_event_
+        {
+            gl::index_t              name;
+            gl::bool_t               is_gpu;
+            std::chrono::nanoseconds begin;
+            std::chrono::nanoseconds duration;
+        };
+
+        void end_zone_(gl::index_t index)
+        {
+            auto& frame  = frames_.at(frame_index_);
+            auto& record = frame.records.at(index);
+
+            record.cpu_end = clock_t::now();
+            if (record.query != npos_) record_query_(frame, record.query + 1u);
+
+            gl::pop_debug_group();
+            --depth_;
+        }
+        void record_query_(frame_& frame, gl::index_t query)
+        {
+            auto const handle = frame.queries.at(query);
+            gl::query_counter(handle);
+            frame.last_query = handle;
+        }
+
+        //Queries complete in submission order, the first pending frame ends the harvest
+        void harvest_()
+        {
+            for (auto offset = gl::index_t{ 0u }; offset < frames_.size(); ++offset)
+            {
+                auto& frame = frames_.at((frame_index_ + offset) % frames_.size());
+                if (!frame.is_pending) continue;
+                if (frame.last_query && !gl::get_query_object_parameter<gl::query_parameter_e::result_available>(*frame.last_query)) return;
+
+                for (auto const& record : frame.records)
+                {
+                    auto& history = histories_.at(record.name);
+                    push_sample_(history.cpu, record.cpu_end - record.cpu_begin);
+                    push_trace_(trace_event_{ record.name, gl::false_, record.cpu_begin - cpu_origin_, record.cpu_end - record.cpu_begin });
+                    ++history.samples;
+
+                    if (record.query == npos_) continue;
+
+                    auto const begin = timestamp_(frame.queries.at(record.query     ));
+                    auto const end   = timestamp_(frame.queries.at(record.query + 1u));
+                    push_sample_(history.gpu, end - begin);
+                    push_trace_(trace_event_{ record.name, gl::true_, begin - std::chrono::nanoseconds{ gpu_origin_ }, end - begin });
+                }
+
+                frame.is_pending = gl::false_;
+            }
+        }
+        void push_sample_(std::deque<std::chrono::nanoseconds>& samples, std::chrono::nanoseconds sample)
+        {
+            samples.emplace_back(sample);
+            if (samples.size() > history_size_) samples.pop_front();
+        }
+        void push_trace_(trace_event_ const& event)
+        {
+            if (trace_capacity_ == 0u) return;
+
+            trace_events_.emplace_back(event);
+            if (trace_events_.size() > trace_capacity_) trace_events_.pop_front();
+        }
+        auto intern_(std::string const& name) -> gl::index_t
+        {
+            auto const [iterator, inserted] = name_indices_.try_emplace(name, static_cast<gl::index_t>(names_.size()));
+            if (inserted)
+            {
+                names_    .emplace_back(name);
+                histories_.emplace_back();
+            }
+
+            return iterator->second;
+        }
+
+        static auto timestamp_(gl::handle_t query) -> std::chrono::nanoseconds
+        {
+            return std::chrono::nanoseconds{ static_cast<std::chrono::nanoseconds::rep>(gl::get_query_object_parameter<gl::query_parameter_e::result>(query)) };
+        }
+        static auto timing_(std::deque<std::chrono::nanoseconds> const& samples) -> gl::profiler_timing
+        {
+            if (samples.empty()) return {};
+
+            auto sorted = std::vector<std::chrono::nanoseconds>{ samples.begin(), samples.end() };
+            std::ranges::sort(sorted);
+
+            auto const total = std::accumulate(sorted.begin(), sorted.end(), std::chrono::nanoseconds{});
+            auto const p99   = std::min<gl::size_t>((sorted.size() * 99u) / 100u, sorted.size() - 1u);
+
+            return gl::profiler_timing{ sorted.front(), total / static_cast<std::chrono::nanoseconds::rep>(sorted.size()), sorted.at(p99) };
+        }
+
+        std::vector<frame_>                          frames_;
+        std::vector<std::string>                     names_;
+        std::unordered_map<std::string, gl::index_t> name_indices_;
+        std::vector<history_>                        histories_;
+        std::deque<trace_event_>                     trace_events_;
+        gl::index_t                                  frame_index_;
+        gl::count_t                                  depth_;
+        gl::count_t                                  history_size_;
+        gl::count_t                                  trace_capacity_;
+        gl::count_t                                  dropped_frames_;
+        gl::count_t                                  overflowed_zones_;
+        clock_t::time_point                          cpu_origin_;
+        gl::int64_t                                  gpu_origin_;
+    };
+}
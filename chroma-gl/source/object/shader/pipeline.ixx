@@ -28,19 +28,42 @@ export namespace gl
 
         void bind  ()
         {
+            if (!pending_shaders_.empty()) resolve();
             gl::bind_pipeline(handle());
         }
+        //Stages of shaders that are still compiling are attached once they are resolved, so linking never blocks
         void link  (std::shared_ptr<gl::shader> shader)
         {
+            shaders_.emplace(shader->type(), shader);
+            if (!shader->is_resolved())
+            {
+                pending_shaders_.emplace_back(shader);
+                return;
+            }
+
             auto const program_stage = gl::map_program_stage(shader->type());
             gl::use_program_stage(handle(), shader->handle(), program_stage);
-            shaders_.emplace(shader->type(), shader);
         }
         void unlink(stage_e program_stage)
         {
             gl::use_program_stage(handle(), gl::null_object, program_stage);
         }
 
+        auto is_ready() -> gl::bool_t
+        {
+            return std::ranges::all_of(pending_shaders_, [](auto const& shader) { return shader->is_ready(); });
+        }
+        //Waits for every pending shader and attaches its stage, throws if one of them failed to compile or link
+        void resolve ()
+        {
+            auto const shaders = std::exchange(pending_shaders_, {});
+            std::ranges::for_each(shaders, [&](auto const& shader)
+                {
+                    shader->resolve();
+                    gl::use_program_stage(handle(), shader->handle(), gl::map_program_stage(shader->type()));
+                });
+        }
+
         auto stage (this auto&& self, stage_e stage) -> auto&&
         {
             return shaders_.at(stage);
@@ -50,5 +73,6 @@ export namespace gl
 
     private:
         std::unordered_map<gl::shader::type_e, std::shared_ptr<gl::shader>> shaders_;
+        std::vector<std::shared_ptr<gl::shader>>                            pending_shaders_;
     };
 }
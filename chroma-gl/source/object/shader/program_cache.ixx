@@ -0,0 +1,183 @@
+export module chroma_gl:object.shader.program_cache;
+
+import std;
+import opengl;
+import :io;
+
+export namespace gl
+{
+    struct program_cache_statistics
+    {
+        gl::count_t              hits       = 0u;
+        gl::count_t              misses     = 0u;
+        gl::count_t              rejections = 0u; //Binaries the driver refused to load, e.g. after an update
+        std::chrono::nanoseconds time_saved = {};
+    };
+
+    //Stores linked program binaries keyed by a hash of their SPIR-V, entry point, specialization constants and the driver
+    //The cache file consists of a header, a table of entries and the binaries, so it can be mapped and searched in place
+    //Entries record how long their program took to compile, hits report the difference with loading the binary as time saved
+    class program_cache
+    {
+    public:
+        using key_t = gl::uint64_t;
+
+        struct entry
+        {
+            gl::enum_t               format;
+            std::vector<gl::byte_t>  binary;
+            std::chrono::nanoseconds compile_time;
+        };
+
+        explicit
+        program_cache(std::filesystem::path path)
+            : path_{ std::move(path) }, driver_hash_{}, entries_{}, statistics_{}, is_modified_{ gl::false_ }
+            , is_parallel_{ gl::is_extension_supported("GL_KHR_parallel_shader_compile") }
+        {
+            auto const renderer = gl::get_string<gl::context_property_e::renderer>();
+            auto const version  = gl::get_string<gl::context_property_e::version >();
+            driver_hash_ = hash_(gl::as_bytes(version), hash_(gl::as_bytes(renderer), offset_basis_));
+
+            if (is_parallel_) gl::maximum_shader_compiler_threads(std::numeric_limits<gl::uint32_t>::max());
+            if (std::filesystem::exists(path_)) load_();
+        }
+
+        auto key    (std::span<gl::byte_t const> binary, std::string const& entry_point, std::span<gl::uint32_t const> indices = {}, std::span<gl::uint32_t const> values = {}) const -> key_t
+        {
+            auto hash = hash_(binary, driver_hash_);
+            hash = hash_(gl::as_bytes(entry_point), hash);
+            hash = hash_(gl::as_bytes(indices    ), hash);
+            hash = hash_(gl::as_bytes(values     ), hash);
+
+            return hash;
+        }
+        auto find   (key_t key) const -> entry const*
+        {
+            auto const iterator = entries_.find(key);
+            if (iterator == entries_.end()) return nullptr;
+
+            return &iterator->second;
+        }
+        void store  (key_t key, gl::binary_info binary_info, std::chrono::nanoseconds compile_time)
+        {
+            if (binary_info.binary.empty()) return;
+
+            entries_.insert_or_assign(key, entry{ binary_info.format, std::move(binary_info.binary), compile_time });
+            is_modified_ = gl::true_;
+        }
+        void erase  (key_t key)
+        {
+            is_modified_ |= entries_.erase(key) != gl::size_t{ 0u };
+        }
+
+        void record_hit      (key_t key, std::chrono::nanoseconds load_time)
+        {
+            ++statistics_.hits;
+            if (auto const* entry = find(key)) statistics_.time_saved += std::max(entry->compile_time - load_time, std::chrono::nanoseconds{});
+        }
+        void record_miss     ()
+        {
+            ++statistics_.misses;
+        }
+        void record_rejection()
+        {
+            ++statistics_.rejections;
+        }
+
+        //Writes the cache file if any entry changed since it was loaded or last saved
+        void save      ()
+        {
+            if (!is_modified_) return;
+
+            auto const table_size = sizeof(file_header) + entries_.size() * sizeof(file_entry);
+            auto       data_size  = gl::size_t{ 0u };
+            std::ranges::for_each(entries_, [&](auto const& value) { data_size += value.second.binary.size(); });
+
+            auto memory = std::vector<gl::byte_t>(table_size + data_size);
+            auto header = file_header{ magic_, version_, driver_hash_, static_cast<gl::uint64_t>(entries_.size()) };
+            std::memcpy(memory.data(), &header, sizeof(file_header));
+
+            auto table_offset = sizeof(file_header);
+            auto data_offset  = table_size;
+            for (auto const& [key, value] : entries_)
+            {
+                auto const file_entry_value = file_entry{ key, static_cast<gl::uint64_t>(data_offset), static_cast<gl::uint64_t>(value.binary.size()), static_cast<gl::int64_t>(value.compile_time.count()), value.format };
+                std::memcpy(memory.data() + table_offset, &file_entry_value, sizeof(file_entry));
+                std::memcpy(memory.data() + data_offset , value.binary.data(), value.binary.size());
+
+                table_offset += sizeof(file_entry);
+                data_offset  += value.binary.size();
+            }
+
+            gl::io::write(path_, memory);
+            is_modified_ = gl::false_;
+        }
+
+        auto is_parallel() const -> gl::bool_t
+        {
+            return is_parallel_;
+        }
+        auto statistics () const -> gl::program_cache_statistics
+        {
+            return statistics_;
+        }
+
+    private:
+        static auto constexpr magic_        = gl::uint32_t{ 0x43504743u }; //"CGPC"
+        static auto constexpr version_      = gl::uint32_t{ 1u };
+        static auto constexpr offset_basis_ = key_t{ 0xCBF29CE484222325u };
+        static auto constexpr prime_        = key_t{ 0x00000100000001B3u };
+
+        struct file_header
+        {
+            gl::uint32_t magic;
+            gl::uint32_t version;
+            gl::uint64_t driver_hash;
+            gl::uint64_t entry_count;
+        };
+        struct file_entry
+        {
+            gl::uint64_t key;
+            gl::uint64_t offset;
+            gl::uint64_t size;
+            gl::int64_t  compile_time;
+            gl::enum_t   format;
+        };
+
+        //64-bit FNV-1a, stable across runs unlike std::hash
+        static auto hash_(std::span<gl::byte_t const> memory, key_t hash) -> key_t
+        {
+            for (auto const value : memory) hash = (hash ^ static_cast<key_t>(value)) * prime_;
+            return hash;
+        }
+
+        //Caches written by another driver, version or format are discarded as a whole
+        void load_()
+        {
+            auto const memory = gl::io::read(path_);
+            if (memory.size() < sizeof(file_header)) return;
+
+            auto header = file_header{};
+            std::memcpy(&header, memory.data(), sizeof(file_header));
+            if (header.magic != magic_ || header.version != version_ || header.driver_hash != driver_hash_) return;
+            if (header.entry_count > (memory.size() - sizeof(file_header)) / sizeof(file_entry)) return;
+
+            for (auto index = gl::index_t{ 0u }; index < header.entry_count; ++index)
+            {
+                auto value = file_entry{};
+                std::memcpy(&value, memory.data() + sizeof(file_header) + index * sizeof(file_entry), sizeof(file_entry));
+                if (value.offset > memory.size() || value.size > memory.size() - value.offset) return;
+
+                auto const binary = std::span{ memory }.subspan(value.offset, value.size);
+                entries_.insert_or_assign(value.key, entry{ value.format, std::vector<gl::byte_t>{ binary.begin(), binary.end() }, std::chrono::nanoseconds{ value.compile_time } });
+            }
+        }
+
+        std::filesystem::path                  path_;
+        key_t                                  driver_hash_;
+        std::unordered_map<key_t, entry>       entries_;
+        gl::program_cache_statistics           statistics_;
+        gl::bool_t                             is_modified_;
+        gl::bool_t                             is_parallel_;
+    };
+}
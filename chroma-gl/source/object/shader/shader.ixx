@@ -4,6 +4,8 @@ import std;
 import opengl;
 import :config;
 import :object;
+import :object.shader.program_cache;
+import :object.shader.uniform_cache;
 
 export namespace gl
 {
@@ -15,46 +17,205 @@ export namespace gl
         explicit
         shader(type_e type, std::string const& entry_point, std::span<gl::byte_t const> binary)
             : gl::object{ gl::create_program() }
-            , type_{ type }
+            , type_{ type }, compilation_{}, uniform_cache_{}
         {
             gl::program_parameter<gl::program_specification_e::separable>(handle(), gl::true_);
 
-            auto const shader         = gl::create_shader(type_);
-            gl::shader_binary    (shader, gl::shader_binary_format_e::spir_v, binary);
-            gl::specialize_shader(shader, entry_point);
+            compile_(entry_point, binary, nullptr, program_cache::key_t{});
+            resolve();
+        }
+        //Loads the program binary from the cache when possible, otherwise the program is compiled and stored once it is resolved
+        //Status queries are deferred until the shader is resolved, the cache has to outlive it until then
+        explicit
+        shader(type_e type, std::string const& entry_point, std::span<gl::byte_t const> binary, gl::program_cache& cache)
+            : gl::object{ gl::create_program() }
+            , type_{ type }, compilation_{}, uniform_cache_{}
+        {
+            gl::program_parameter<gl::program_specification_e::separable>(handle(), gl::true_);
 
-            auto const compile_status = gl::get_shader_parameter<gl::shader_parameter_e::compile_status>(shader);
-            if (compile_status != gl::true_) throw std::runtime_error{ gl::get_shader_info_log(shader) };
-            
-            gl::attach_shader(handle(), shader);
-            gl::link_program (handle()        );
+            auto const key = cache.key(binary, entry_point);
+            if (load_(cache, key)) return;
 
-            auto const link_status    = gl::get_program_parameter<gl::program_parameter_e::link_status>(handle());
-            if (link_status != gl::true_) throw std::runtime_error{ gl::get_program_info_log(handle()) };
+            cache.record_miss();
+            gl::program_parameter<gl::program_specification_e::binary_retrievable>(handle(), gl::true_);
+            compile_(entry_point, binary, &cache, key);
+        }
+        //Compiles GLSL source, for kernels generated at runtime that have no precompiled binary
+        explicit
+        shader(type_e type, std::string const& source)
+            : gl::object{ gl::create_program() }
+            , type_{ type }, compilation_{}, uniform_cache_{}
+        {
+            gl::program_parameter<gl::program_specification_e::separable>(handle(), gl::true_);
 
-            gl::detach_shader(handle(), shader);
-            gl::delete_shader(          shader);
+            compile_source_(source, nullptr, program_cache::key_t{});
+            resolve();
         }
-        shader(shader&&) noexcept = default;
+        explicit
+        shader(type_e type, std::string const& source, gl::program_cache& cache)
+            : gl::object{ gl::create_program() }
+            , type_{ type }, compilation_{}, uniform_cache_{}
+        {
+            gl::program_parameter<gl::program_specification_e::separable>(handle(), gl::true_);
+
+            auto const key = cache.key(gl::as_bytes(source), "main");
+            if (load_(cache, key)) return;
+
+            cache.record_miss();
+            gl::program_parameter<gl::program_specification_e::binary_retrievable>(handle(), gl::true_);
+            compile_source_(source, &cache, key);
+        }
+        shader(shader&& other) noexcept
+            : gl::object{ std::move(other) }
+            , type_{ other.type_ }, compilation_{ std::exchange(other.compilation_, std::nullopt) }, uniform_cache_{ std::move(other.uniform_cache_) } {}
        ~shader()
         {
+            if (compilation_) gl::delete_shader(compilation_->shader);
             gl::delete_program(handle());
         }
 
+        //Without parallel compilation the driver has finished by the time the program is linked
+        //The compile time is taken when completion is first reported, not when the program is resolved later on
+        auto is_ready() -> gl::bool_t
+        {
+            if (!compilation_ || !compilation_->cache || !compilation_->cache->is_parallel()) return gl::true_;
+
+            auto const is_complete = gl::get_program_parameter<gl::program_parameter_e::completion_status>(handle());
+            if (is_complete && !compilation_->compile_time) compilation_->compile_time = std::chrono::steady_clock::now() - compilation_->start_time;
+
+            return is_complete;
+        }
+        auto is_resolved() const -> gl::bool_t
+        {
+            return !compilation_.has_value();
+        }
+        //Waits for the program to link and checks its status, the binary is stored in the cache on success
+        void resolve ()
+        {
+            if (!compilation_) return;
+
+            auto const compilation = *std::exchange(compilation_, std::nullopt);
+            auto const link_status = gl::get_program_parameter<gl::program_parameter_e::link_status>(handle());
+            auto const compile_time = compilation.compile_time.value_or(std::chrono::steady_clock::now() - compilation.start_time);
+            if (link_status != gl::true_)
+            {
+                auto const compile_status = gl::get_shader_parameter<gl::shader_parameter_e::compile_status>(compilation.shader);
+                auto const info_log       = compile_status != gl::true_ ? gl::get_shader_info_log(compilation.shader) : gl::get_program_info_log(handle());
+                gl::delete_shader(compilation.shader);
+
+                throw std::runtime_error{ info_log };
+            }
+
+            gl::detach_shader(handle(), compilation.shader);
+            gl::delete_shader(          compilation.shader);
+
+            if (compilation.cache) compilation.cache->store(compilation.key, gl::get_program_binary(handle()), compile_time);
+        }
+
         template<typename value_t>
         void upload(gl::index_t location, value_t const& value)
         {
             gl::program_uniform(handle(), location, value);
         }
+        template<typename value_t>
+        void upload(gl::uniform_cache::uniform_t uniform, value_t const& value)
+        {
+            gl::program_uniform(handle(), uniforms().uniform(uniform).location, value);
+        }
 
-        auto type() const -> type_e
+        auto type    () const -> type_e
         {
             return type_;
         }
+        //Reflected on first use, the program is resolved first if it is still compiling
+        auto uniforms() -> gl::uniform_cache const&
+        {
+            if (!uniform_cache_)
+            {
+                resolve();
+                uniform_cache_.emplace(handle());
+            }
+
+            return *uniform_cache_;
+        }
+
+        auto operator=(shader&& other) noexcept -> shader&
+        {
+            if (this != &other)
+            {
+                gl::object::operator=(std::move(other));
+                type_        = std::exchange(other.type_, type_);
+                compilation_  .swap(other.compilation_  );
+                uniform_cache_.swap(other.uniform_cache_);
+            }
 
-        auto operator=(shader&&) noexcept -> shader& = default;
+            return *this;
+        }
 
     private:
-        type_e type_;
+        //The compile time is known once the driver reports completion, or when resolve has to wait for it
+        struct compilation
+        {
+            gl::handle_t                            shader;
+            gl::program_cache*                      cache;
+            gl::program_cache::key_t                key;
+            std::chrono::steady_clock::time_point   start_time;
+            std::optional<std::chrono::nanoseconds> compile_time;
+        };
+
+        static auto finished_time_(gl::program_cache* cache, std::chrono::steady_clock::time_point start_time) -> std::optional<std::chrono::nanoseconds>
+        {
+            if (cache && cache->is_parallel()) return std::nullopt;
+
+            return std::chrono::steady_clock::now() - start_time;
+        }
+
+        void compile_(std::string const& entry_point, std::span<gl::byte_t const> binary, gl::program_cache* cache, gl::program_cache::key_t key)
+        {
+            auto const start_time = std::chrono::steady_clock::now();
+            auto const shader     = gl::create_shader(type_);
+            gl::shader_binary    (shader, gl::shader_binary_format_e::spir_v, binary);
+            gl::specialize_shader(shader, entry_point);
+            gl::attach_shader    (handle(), shader);
+            gl::link_program     (handle()        );
+
+            compilation_ = compilation{ shader, cache, key, start_time, finished_time_(cache, start_time) };
+        }
+        void compile_source_(std::string const& source, gl::program_cache* cache, gl::program_cache::key_t key)
+        {
+            auto const start_time = std::chrono::steady_clock::now();
+            auto const shader     = gl::create_shader(type_);
+            gl::shader_source    (shader, source);
+            gl::compile_shader   (shader        );
+            gl::attach_shader    (handle(), shader);
+            gl::link_program     (handle()        );
+
+            compilation_ = compilation{ shader, cache, key, start_time, finished_time_(cache, start_time) };
+        }
+        //A binary that no longer loads, e.g. after a driver update, is dropped so it is replaced on resolve
+        auto load_   (gl::program_cache& cache, gl::program_cache::key_t key) -> gl::bool_t
+        {
+            auto const* entry = cache.find(key);
+            if (!entry) return gl::false_;
+
+            auto const start_time  = std::chrono::steady_clock::now();
+            gl::program_binary(handle(), entry->format, entry->binary);
+
+            auto const link_status = gl::get_program_parameter<gl::program_parameter_e::link_status>(handle());
+            if (link_status != gl::true_)
+            {
+                cache.erase(key);
+                cache.record_rejection();
+
+                return gl::false_;
+            }
+
+            cache.record_hit(key, std::chrono::steady_clock::now() - start_time);
+            return gl::true_;
+        }
+
+        type_e                           type_;
+        std::optional<compilation>       compilation_;
+        std::optional<gl::uniform_cache> uniform_cache_;
     };
 }
@@ -0,0 +1,184 @@
+export module chroma_gl:object.shader.shader_block;
+
+import std;
+import opengl;
+import :object.buffer;
+import :object.shader.uniform_cache;
+
+export namespace gl
+{
+    //Describes one member of a C++ structure that mirrors a block, created through gl::block_member
+    struct block_member_info
+    {
+        std::string        name;
+        gl::uniform_type_e type;
+        gl::size_t         offset;
+        gl::size_t         array_size;
+        gl::size_t         array_stride;
+        gl::size_t         matrix_stride;
+    };
+
+    //Unsupported member types fail to compile, the layout itself is checked against the reflected block by shader_block::validate
+    template<typename structure_t, typename member_t>
+    auto block_member(std::string name, member_t structure_t::* member) -> gl::block_member_info
+    {
+        static_assert(std::is_standard_layout_v<structure_t> && std::is_trivially_copyable_v<structure_t>, "block structure must be standard layout and trivially copyable");
+
+        using value_t = std::remove_all_extents_t<member_t>;
+        auto matrix_stride = gl::size_t{ 0u };
+        if constexpr (requires { typename value_t::col_type; }) matrix_stride = sizeof(typename value_t::col_type);
+
+        return gl::block_member_info{ std::move(name), gl::map_uniform_type<value_t>(), gl::offset_of(member), std::max<gl::size_t>(std::extent_v<member_t>, 1u), sizeof(value_t), matrix_stride };
+    }
+
+
+
+    //CPU copy of a uniform (std140) or shader storage (std430) block, laid out with the offsets and strides the driver reflects
+    //Members are addressed through handles resolved once by name, changed bytes are collected into one dirty range
+    //Flushing writes that range to the backing buffer in a single upload instead of one program uniform call per value
+    template<gl::buffer_base_target_e target_v>
+    class shader_block
+    {
+    public:
+        using member_t = gl::uint32_t;
+
+        explicit
+        shader_block(gl::uniform_cache const& cache, std::string const& block_name)
+            : shader_block{ cache, find_block_(cache, block_name) } {}
+
+        //Member names are reflected either as is or prefixed with the block name
+        auto member  (std::string_view name) const -> member_t
+        {
+            auto const prefixed = std::format("{}.{}", info_.name, name);
+            auto const iterator = std::ranges::find_if(members_, [&](gl::uniform_info const& info) { return info.name == name || info.name == prefixed; });
+            if (iterator == members_.end()) throw std::invalid_argument{ "block member is not active" };
+
+            return static_cast<member_t>(std::distance(members_.begin(), iterator));
+        }
+        template<typename value_t>
+        void set     (member_t member, value_t const& value, gl::index_t array_index = 0u)
+        {
+            auto const& info = members_.at(member);
+            if (info.type != gl::map_uniform_type<value_t>()) throw std::invalid_argument{ "value type does not match block member" };
+            if (array_index >= std::max<gl::size_t>(info.array_size, 1u)) throw std::out_of_range{ "array index exceeds block member" };
+
+            auto const offset = info.offset + array_index * info.array_stride;
+            if constexpr (requires { typename value_t::col_type; })
+            {
+                for (auto column = gl::index_t{ 0u }; column < static_cast<gl::index_t>(value_t::length()); ++column)
+                {
+                    write_(offset + column * info.matrix_stride, gl::as_bytes(std::span{ &value[static_cast<typename value_t::length_type>(column)], 1u }));
+                }
+            }
+            else
+            {
+                write_(offset, gl::as_bytes(std::span{ &value, 1u }));
+            }
+        }
+        //Copies a whole structure at once, its layout should have been checked with validate
+        template<typename structure_t>
+        void assign  (structure_t const& structure)
+        {
+            static_assert(std::is_trivially_copyable_v<structure_t>, "block structure must be trivially copyable");
+            if (sizeof(structure_t) > staging_.size()) throw std::invalid_argument{ "structure exceeds block size" };
+
+            write_(gl::size_t{ 0u }, gl::as_bytes(std::span{ &structure, 1u }));
+        }
+
+        //Throws on the first member whose type, offset or strides differ from the reflected layout
+        template<typename structure_t>
+        void validate(std::initializer_list<gl::block_member_info> layout) const
+        {
+            if (sizeof(structure_t) > info_.size) throw std::runtime_error{ std::format("structure of {} bytes exceeds block '{}' of {} bytes", sizeof(structure_t), info_.name, info_.size) };
+
+            for (auto const& expected : layout)
+            {
+                auto const& actual = members_.at(member(expected.name));
+                auto const  error  = [&](std::string_view property) { return std::runtime_error{ std::format("block '{}' member '{}' has a different {}", info_.name, expected.name, property) }; };
+
+                if (actual.type   != expected.type  ) throw error("type"  );
+                if (actual.offset != expected.offset) throw error("offset");
+                if (expected.array_size    > 1u         && actual.array_stride  != expected.array_stride ) throw error("array stride" );
+                if (expected.matrix_stride > 0u         && actual.matrix_stride != expected.matrix_stride) throw error("matrix stride");
+                if (std::max<gl::size_t>(actual.array_size, 1u) != expected.array_size                   ) throw error("array size"   );
+            }
+        }
+
+        //Uploads the dirty range, if any, in a single write
+        void flush   ()
+        {
+            if (dirty_begin_ >= dirty_end_) return;
+
+            buffer_.upload(std::span<gl::byte_t const>{ staging_ }.subspan(dirty_begin_, dirty_end_ - dirty_begin_), dirty_begin_);
+            dirty_begin_ = gl::size_t{ 0u };
+            dirty_end_   = gl::size_t{ 0u };
+        }
+        void bind    ()
+        {
+            bind(info_.binding_point);
+        }
+        void bind    (gl::binding_t binding)
+        {
+            flush();
+            buffer_.bind(binding);
+        }
+
+        auto info    () const -> gl::uniform_block_info const&
+        {
+            return info_;
+        }
+        auto is_dirty() const -> gl::bool_t
+        {
+            return dirty_begin_ < dirty_end_;
+        }
+        auto data    () const -> std::span<gl::byte_t const>
+        {
+            return staging_;
+        }
+
+    private:
+        using buffer_t = gl::dynamic_buffer<gl::byte_t, gl::true_, gl::false_, target_v>;
+
+        explicit
+        shader_block(gl::uniform_cache const& cache, gl::uniform_cache::block const& block)
+            : info_{ block.info }, members_{}, staging_(block.info.size), buffer_{ std::max<gl::size_t>(block.info.size, 1u) }, dirty_begin_{ 0u }, dirty_end_{ 0u }
+        {
+            members_.reserve(block.members.size());
+            std::ranges::for_each(block.members, [&](auto const uniform) { members_.emplace_back(cache.uniform(uniform)); });
+        }
+
+        static auto find_block_(gl::uniform_cache const& cache, std::string const& block_name) -> gl::uniform_cache::block const&
+        {
+            if constexpr (target_v == gl::buffer_base_target_e::uniform_buffer) return cache.uniform_block(block_name);
+            else                                                                return cache.storage_block(block_name);
+        }
+
+        //Unchanged values do not mark the block dirty
+        void write_(gl::size_t offset, std::span<gl::byte_t const> memory)
+        {
+            if (offset + memory.size() > staging_.size()) throw std::out_of_range{ "write exceeds block size" };
+            if (std::memcmp(staging_.data() + offset, memory.data(), memory.size()) == 0) return;
+
+            std::memcpy(staging_.data() + offset, memory.data(), memory.size());
+            if (dirty_begin_ >= dirty_end_)
+            {
+                dirty_begin_ = offset;
+                dirty_end_   = offset + memory.size();
+                return;
+            }
+
+            dirty_begin_ = std::min(dirty_begin_, offset                );
+            dirty_end_   = std::max(dirty_end_  , offset + memory.size());
+        }
+
+        gl::uniform_block_info        info_;
+        std::vector<gl::uniform_info> members_;
+        std::vector<gl::byte_t>       staging_;
+        buffer_t                      buffer_;
+        gl::size_t                    dirty_begin_;
+        gl::size_t                    dirty_end_;
+    };
+
+    using uniform_block = gl::shader_block<gl::buffer_base_target_e::uniform_buffer       >;
+    using storage_block = gl::shader_block<gl::buffer_base_target_e::shader_storage_buffer>;
+}
@@ -5,40 +5,120 @@ import opengl;
 
 export namespace gl
 {
+    //Reflects the active uniforms, uniform blocks and shader storage blocks of a program once
+    //Names are resolved to compact handles up front so that per-frame code only indexes into arrays
     class uniform_cache
     {
     public:
+        enum class uniform_t : gl::uint32_t;
+
+        struct block
+        {
+            gl::uniform_block_info info;
+            std::vector<uniform_t> members;
+        };
+
         explicit
         uniform_cache(gl::handle_t shader)
+            : uniforms_{}, uniform_handles_{}, uniform_blocks_{}, storage_blocks_{}
+        {
+            reflect_blocks_   (shader, gl::program_interface_e::uniform_block       , uniform_blocks_);
+            reflect_blocks_   (shader, gl::program_interface_e::shader_storage_block, storage_blocks_);
+            reflect_variables_(shader, gl::program_interface_e::uniform             , uniform_blocks_);
+            reflect_variables_(shader, gl::program_interface_e::buffer_variable     , storage_blocks_);
+        }
+
+        auto find          (std::string const& name) const -> std::optional<uniform_t>
+        {
+            auto const iterator = uniform_handles_.find(name);
+            if (iterator == uniform_handles_.end()) return std::nullopt;
+
+            return iterator->second;
+        }
+        auto uniform       (uniform_t uniform) const -> gl::uniform_info const&
+        {
+            return uniforms_.at(gl::to_underlying(uniform));
+        }
+        auto uniform_block (std::string const& name) const -> block const&
+        {
+            return find_block_(uniform_blocks_, name);
+        }
+        auto storage_block (std::string const& name) const -> block const&
+        {
+            return find_block_(storage_blocks_, name);
+        }
+        auto uniforms      () const -> std::span<gl::uniform_info const>
+        {
+            return uniforms_;
+        }
+
+    private:
+        static void reflect_blocks_(gl::handle_t shader, gl::program_interface_e interface, std::vector<block>& blocks)
+        {
+            auto const active_resources = gl::get_program_interface_value<gl::program_interface_parameter_e::active_resources>(shader, interface);
+            for (auto index = gl::index_t{ 0u }; index < active_resources; ++index)
+            {
+                auto const values = gl::get_program_resource_value<
+                    gl::program_resource_e::buffer_binding         ,
+                    gl::program_resource_e::buffer_data_size       ,
+                    gl::program_resource_e::number_active_variables>(shader, interface, index);
+
+                blocks.emplace_back(gl::uniform_block_info
+                {
+                    .name            = gl::get_program_resource_name(shader, interface, index),
+                    .binding_point   = static_cast<gl::binding_t>(values[0u])                ,
+                    .size            = static_cast<gl::size_t   >(values[1u])                ,
+                    .active_uniforms = static_cast<gl::count_t  >(values[2u])                ,
+                });
+            }
+        }
+        //Buffer variables have no location, members of a block are recorded with the block they belong to
+        void reflect_variables_(gl::handle_t shader, gl::program_interface_e interface, std::vector<block>& blocks)
         {
-            auto const active_resources = gl::get_program_interface_value<gl::program_interface_parameter_e::active_resources>(shader, gl::program_interface_e::uniform);
+            auto const has_location     = interface == gl::program_interface_e::uniform;
+            auto const active_resources = gl::get_program_interface_value<gl::program_interface_parameter_e::active_resources>(shader, interface);
             for (auto index = gl::index_t{ 0u }; index < active_resources; ++index)
             {
                 auto const values       = gl::get_program_resource_value<
-                    gl::program_resource_e::type         , 
-                    gl::program_resource_e::location     , 
-                    gl::program_resource_e::block_index  , 
-                    gl::program_resource_e::array_size   , 
-                    gl::program_resource_e::array_stride , 
-                    gl::program_resource_e::matrix_stride, 
-                    gl::program_resource_e::is_row_major >(shader, gl::program_interface_e::uniform, index);
-
-                auto const uniform_name = gl::get_program_resource_name(shader, gl::program_interface_e::uniform, index);
-                uniforms_[uniform_name] = gl::uniform_info
+                    gl::program_resource_e::type         ,
+                    gl::program_resource_e::offset       ,
+                    gl::program_resource_e::block_index  ,
+                    gl::program_resource_e::array_size   ,
+                    gl::program_resource_e::array_stride ,
+                    gl::program_resource_e::matrix_stride,
+                    gl::program_resource_e::is_row_major >(shader, interface, index);
+
+                auto const uniform_name = gl::get_program_resource_name(shader, interface, index);
+                auto const location     = has_location ? gl::get_program_resource_value<gl::program_resource_e::location>(shader, interface, index)[0u] : gl::int32_t{ -1 };
+                auto const handle       = static_cast<uniform_t>(uniforms_.size());
+                uniforms_.emplace_back(gl::uniform_info
                 {
-                    .name          = uniform_name                               , 
-                    .type          = static_cast<gl::uniform_type_e>(values[0u]), 
-                    .location      = static_cast<gl::index_t       >(values[1u]), 
-                    .block_index   = static_cast<gl::index_t       >(values[2u]), 
-                    .array_size    = static_cast<gl::size_t        >(values[3u]), 
-                    .array_stride  = static_cast<gl::size_t        >(values[4u]), 
-                    .matrix_stride = static_cast<gl::size_t        >(values[5u]), 
-                    .is_row_major  = static_cast<gl::bool_t        >(values[6u]), 
-                };
+                    .name          = uniform_name                               ,
+                    .type          = static_cast<gl::uniform_type_e>(values[0u]),
+                    .offset        = static_cast<gl::size_t        >(values[1u]),
+                    .location      = static_cast<gl::index_t       >(location  ),
+                    .block_index   = static_cast<gl::index_t       >(values[2u]),
+                    .array_size    = static_cast<gl::size_t        >(values[3u]),
+                    .array_stride  = static_cast<gl::size_t        >(values[4u]),
+                    .matrix_stride = static_cast<gl::size_t        >(values[5u]),
+                    .is_row_major  = static_cast<gl::bool_t        >(values[6u]),
+                });
+                uniform_handles_.try_emplace(uniform_name, handle);
+
+                if (values[2u] >= gl::int32_t{ 0 }) blocks.at(static_cast<gl::size_t>(values[2u])).members.emplace_back(handle);
             }
         }
+        static auto find_block_(std::vector<block> const& blocks, std::string const& name) -> block const&
+        {
+            auto const iterator = std::ranges::find(blocks, name, [](block const& value) -> std::string const& { return value.info.name; });
+            if (iterator == blocks.end()) throw std::invalid_argument{ "block is not active" };
 
-    private:
-        std::unordered_map<std::string, gl::uniform_info> uniforms_;
+            return *iterator;
+        }
+
+        std::vector<gl::uniform_info>                 uniforms_;
+        std::unordered_map<std::string, uniform_t>    uniform_handles_;
+        std::vector<block>                            uniform_blocks_;
+        std::vector<block>                            storage_blocks_;
     };
 }
@@ -15,11 +15,14 @@ export namespace gl
         using face_e   = gl::cubemap_face_e;
 
         explicit
-        cubemap(format_e format, gl::vector_1u dimensions, gl::bool_t allocate_mipmaps = gl::true_)
+        cubemap(format_e format, gl::vector_1u dimensions, gl::bool_t   allocate_mipmaps = gl::true_)
+            : cubemap{ format, dimensions, allocate_mipmaps ? gl::mipmap_levels(gl::vector_2u{ dimensions.x }) : gl::uint32_t{ 1u } } {}
+        explicit
+        cubemap(format_e format, gl::vector_1u dimensions, gl::uint32_t mipmap_levels)
             : gl::texture{ gl::texture_target_e::cubemap }
-            , format_{ format }, dimensions_{ dimensions.x }, mipmap_levels_{ 1u }
+            , format_{ format }, dimensions_{ dimensions.x }, mipmap_levels_{ mipmap_levels }
         {
-            if (allocate_mipmaps) mipmap_levels_ = gl::mipmap_levels(dimensions_);
+            if (mipmap_levels_ == 0u || mipmap_levels_ > gl::mipmap_levels(dimensions_)) throw std::invalid_argument{ "mipmap level count exceeds the mip chain of the dimensions" };
 
             gl::texture_storage_2d(handle(), format_, dimensions_, mipmap_levels_);
         }
@@ -30,9 +33,16 @@ export namespace gl
         }
         void upload          (face_e face, gl::uint32_t image_level, gl::rectangle image_area, gl::texture_data_descriptor texture_data_descriptor,           std::span<gl::byte_t const>            memory)
         {
-            auto const image_volume = gl::box{ gl::vector_3u{ image_area.origin, gl::to_underlying(face - face_e::positive_x) }, gl::vector_3u{ image_area.extent, 1u }, };
+            auto const image_volume = gl::box{ gl::vector_3u{ image_area.extent, 1u }, gl::vector_3u{ image_area.origin, gl::to_underlying(face - face_e::positive_x) } };
             gl::texture_sub_image_3d(handle(), image_level, image_volume, texture_data_descriptor, memory);
         }
+        //The cubemap has to be created with the compressed format cast to its format
+        void upload          (face_e face, gl::uint32_t image_level, gl::rectangle image_area, gl::texture_compressed_format_e compressed_format,                 std::span<gl::byte_t const>            memory)
+        {
+            require_barrier(gl::memory_barrier_e::texture_update);
+            auto const image_volume = gl::box{ gl::vector_3u{ image_area.extent, 1u }, gl::vector_3u{ image_area.origin, gl::to_underlying(face - face_e::positive_x) } };
+            gl::compressed_texture_sub_image_3d(handle(), image_level, image_volume, compressed_format, memory);
+        }
         void upload          (                                                                 gl::texture_data_descriptor texture_data_descriptor, std::span<std::span<gl::byte_t const> const, 6u> memory)
         {
             for (auto const [face_index, face_memory] : std::views::enumerate(memory))
@@ -113,7 +123,7 @@ export namespace gl
         void upload          (gl::index_t index, face_e face, gl::uint32_t image_level, gl::rectangle image_area, gl::texture_data_descriptor texture_data_descriptor,           std::span<gl::byte_t const>            memory)
         {
             auto const face_origin  = index * 6u + gl::to_underlying(face - face_e::positive_x);
-            auto const image_volume = gl::box{ gl::vector_3u{ image_area.origin, face_origin }, gl::vector_3u{ image_area.extent, 1u } };
+            auto const image_volume = gl::box{ gl::vector_3u{ image_area.extent, 1u }, gl::vector_3u{ image_area.origin, face_origin } };
             gl::texture_sub_image_3d(handle(), image_level, image_volume, texture_data_descriptor, memory);
         }
         void upload          (gl::index_t index,                                                                  gl::texture_data_descriptor texture_data_descriptor, std::span<std::span<gl::byte_t const> const, 6u> memory)
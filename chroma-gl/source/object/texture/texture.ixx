@@ -17,6 +17,11 @@ export namespace gl
             gl::delete_texture(handle());
         }
 
+        void require_barrier(gl::memory_barrier_e barrier) const
+        {
+            gl::object::require_barrier(gl::barrier::resource_e::texture, handle(), barrier);
+        }
+
         auto operator=(texture&&) noexcept -> texture& = default;
 
     protected:
@@ -36,10 +41,14 @@ export namespace gl
 
         explicit
         texture_n(format_e format, vector_t dimensions,                                  gl::bool_t allocate_mipmaps = gl::true_)
+            : texture_n{ format, dimensions, allocate_mipmaps ? gl::mipmap_levels(dimensions) : gl::uint32_t{ 1u } } {}
+        //Allocates exactly the given number of levels, e.g. the mip chain stored in a texture container
+        explicit
+        texture_n(format_e format, vector_t dimensions,                                  gl::uint32_t mipmap_levels)
             : gl::texture{ gl::map_texture_target(dimension_v) }
-            , format_{ format }, dimensions_{ dimensions }, mipmap_levels_{ 1u }
+            , format_{ format }, dimensions_{ dimensions }, mipmap_levels_{ mipmap_levels }
         {
-            if (allocate_mipmaps) mipmap_levels_ = gl::mipmap_levels(dimensions_);
+            if (mipmap_levels_ == 0u || mipmap_levels_ > gl::mipmap_levels(dimensions_)) throw std::invalid_argument{ "mipmap level count exceeds the mip chain of the dimensions" };
 
             if constexpr (dimension_v == gl::uint32_t{ 1u }) gl::texture_storage_1d(handle(), format_, dimensions_, mipmap_levels_);
             if constexpr (dimension_v == gl::uint32_t{ 2u }) gl::texture_storage_2d(handle(), format_, dimensions_, mipmap_levels_);
@@ -56,6 +65,11 @@ export namespace gl
         {
             gl::bind_texture_unit(handle(), slot);
         }
+        //Images bound with write access count as written by every draw and dispatch until the unit is rebound
+        void bind_image      (gl::index_t image_unit, gl::image_format_e image_format, gl::image_access_e image_access, gl::uint32_t image_level = 0u)
+        {
+            gl::bind_image_texture(handle(), image_level, dimension_v == gl::uint32_t{ 3u }, gl::uint32_t{ 0u }, image_unit, image_format, image_access);
+        }
 
         void upload          (                                                 gl::texture_data_descriptor texture_data_descriptor, std::span<gl::byte_t const> memory)
         {
@@ -63,10 +77,19 @@ export namespace gl
         }
         void upload          (gl::uint32_t image_level, region_t image_region, gl::texture_data_descriptor texture_data_descriptor, std::span<gl::byte_t const> memory)
         {
+            require_barrier(gl::memory_barrier_e::texture_update);
             if constexpr (dimension_v == gl::uint32_t{ 1u }) gl::texture_sub_image_1d(handle(), image_level, image_region, texture_data_descriptor, memory);
             if constexpr (dimension_v == gl::uint32_t{ 2u }) gl::texture_sub_image_2d(handle(), image_level, image_region, texture_data_descriptor, memory);
             if constexpr (dimension_v == gl::uint32_t{ 3u }) gl::texture_sub_image_3d(handle(), image_level, image_region, texture_data_descriptor, memory);
         }
+        //Sources the image from the bound pixel unpack buffer at the given byte offset
+        void upload          (gl::uint32_t image_level, region_t image_region, gl::texture_data_descriptor texture_data_descriptor, gl::offset_t buffer_offset)
+        {
+            require_barrier(gl::memory_barrier_e::texture_update);
+            if constexpr (dimension_v == gl::uint32_t{ 1u }) gl::texture_sub_image_1d(handle(), image_level, image_region, texture_data_descriptor, buffer_offset);
+            if constexpr (dimension_v == gl::uint32_t{ 2u }) gl::texture_sub_image_2d(handle(), image_level, image_region, texture_data_descriptor, buffer_offset);
+            if constexpr (dimension_v == gl::uint32_t{ 3u }) gl::texture_sub_image_3d(handle(), image_level, image_region, texture_data_descriptor, buffer_offset);
+        }
         void generate_mipmaps()
         {
             gl::generate_texture_mipmaps(handle());
@@ -126,18 +149,28 @@ export namespace gl
         using region_t = gl::texture_n<dimension_v>::region_t;
 
         explicit
-        compressed_texture_n(format_e format, vector_t dimensions, gl::bool_t allocate_mipmaps = gl::true_)
+        compressed_texture_n(format_e format, vector_t dimensions, gl::bool_t   allocate_mipmaps = gl::true_)
             : gl::texture_n<dimension_v>{ static_cast<gl::texture_n<dimension_v>::format_e>(format), dimensions, allocate_mipmaps } {}
+        explicit
+        compressed_texture_n(format_e format, vector_t dimensions, gl::uint32_t mipmap_levels)
+            : gl::texture_n<dimension_v>{ static_cast<gl::texture_n<dimension_v>::format_e>(format), dimensions, mipmap_levels    } {}
 
-        void upload(                                                 gl::compressed_texture_data_descriptor compressed_texture_data_descriptor, std::span<gl::byte_t const> memory)
+        //Compressed data is uploaded as is, the blocks of every level are already encoded in the format of the texture
+        void upload(                                                 std::span<gl::byte_t const> memory)
         {
-            upload(gl::uint32_t{ 0u }, gl::texture_n<dimension_v>::dimensions(), compressed_texture_data_descriptor.base_format, memory);
+            upload(gl::uint32_t{ 0u }, gl::texture_n<dimension_v>::dimensions(), memory);
         }
-        void upload(gl::uint32_t image_level, region_t image_region, gl::compressed_texture_data_descriptor compressed_texture_data_descriptor, std::span<gl::byte_t const> memory)
+        void upload(gl::uint32_t image_level, region_t image_region, std::span<gl::byte_t const> memory)
         {
-            if constexpr (dimension_v == gl::uint32_t{ 1u }) gl::compressed_texture_sub_image_1d(gl::texture_n<dimension_v>::handle(), image_level, image_region, compressed_texture_data_descriptor.base_format, memory);
-            if constexpr (dimension_v == gl::uint32_t{ 2u }) gl::compressed_texture_sub_image_2d(gl::texture_n<dimension_v>::handle(), image_level, image_region, compressed_texture_data_descriptor.base_format, memory);
-            if constexpr (dimension_v == gl::uint32_t{ 3u }) gl::compressed_texture_sub_image_3d(gl::texture_n<dimension_v>::handle(), image_level, image_region, compressed_texture_data_descriptor.base_format, memory);
+            gl::texture_n<dimension_v>::require_barrier(gl::memory_barrier_e::texture_update);
+            if constexpr (dimension_v == gl::uint32_t{ 1u }) gl::compressed_texture_sub_image_1d(gl::texture_n<dimension_v>::handle(), image_level, image_region, format(), memory);
+            if constexpr (dimension_v == gl::uint32_t{ 2u }) gl::compressed_texture_sub_image_2d(gl::texture_n<dimension_v>::handle(), image_level, image_region, format(), memory);
+            if constexpr (dimension_v == gl::uint32_t{ 3u }) gl::compressed_texture_sub_image_3d(gl::texture_n<dimension_v>::handle(), image_level, image_region, format(), memory);
+        }
+
+        auto format() const -> format_e
+        {
+            return static_cast<format_e>(gl::texture_n<dimension_v>::format());
         }
     };
     template<gl::uint32_t dimension_v>
@@ -192,11 +225,13 @@ export namespace gl
         using vector_t = gl::vector_t<gl::uint32_t, dimension_v>;
         using region_t = gl::region<gl::uint32_t, dimension_v>;
 
-        texture_n_array(gl::count_t element_count, format_e format, vector_t dimensions, gl::bool_t allocate_mipmaps = gl::true_)
+        texture_n_array(gl::count_t element_count, format_e format, vector_t dimensions, gl::bool_t   allocate_mipmaps = gl::true_)
+            : texture_n_array{ element_count, format, dimensions, allocate_mipmaps ? gl::mipmap_levels(dimensions) : gl::uint32_t{ 1u } } {}
+        texture_n_array(gl::count_t element_count, format_e format, vector_t dimensions, gl::uint32_t mipmap_levels)
             : gl::texture{ gl::map_texture_array_target(dimension_v) }
-            , element_count_{ element_count }, format_{ format }, dimensions_{ dimensions }, mipmap_levels_{ 1u }
+            , element_count_{ element_count }, format_{ format }, dimensions_{ dimensions }, mipmap_levels_{ mipmap_levels }
         {
-            if (allocate_mipmaps) mipmap_levels_ = gl::mipmap_levels(dimensions_);
+            if (mipmap_levels_ == 0u || mipmap_levels_ > gl::mipmap_levels(dimensions_)) throw std::invalid_argument{ "mipmap level count exceeds the mip chain of the dimensions" };
 
             if constexpr (dimension_v == gl::uint32_t{ 1u }) gl::texture_storage_2d(handle(), format_, gl::vector_2u{ dimensions_, element_count_ }, mipmap_levels_);
             if constexpr (dimension_v == gl::uint32_t{ 2u }) gl::texture_storage_3d(handle(), format_, gl::vector_3u{ dimensions_, element_count_ }, mipmap_levels_);
@@ -213,10 +248,19 @@ export namespace gl
         }
         void upload          (gl::index_t index, gl::uint32_t image_level, region_t image_region, gl::texture_data_descriptor texture_data_descriptor, std::span<gl::byte_t const> memory)
         {
-            auto const index_region = gl::region<gl::uint32_t, dimension_v + 1u>{ { image_region.origin, static_cast<gl::uint32_t>(index) }, { image_region.extent, gl::uint32_t{ 1u } } };
+            require_barrier(gl::memory_barrier_e::texture_update);
+            auto const index_region = gl::region<gl::uint32_t, dimension_v + 1u>{ { image_region.extent, gl::uint32_t{ 1u } }, { image_region.origin, static_cast<gl::uint32_t>(index) } };
             if constexpr (dimension_v == gl::uint32_t{ 1u }) gl::texture_sub_image_2d(handle(), image_level, index_region, texture_data_descriptor, memory);
             if constexpr (dimension_v == gl::uint32_t{ 2u }) gl::texture_sub_image_3d(handle(), image_level, index_region, texture_data_descriptor, memory);
         }
+        //The array has to be created with the compressed format cast to its format
+        void upload          (gl::index_t index, gl::uint32_t image_level, region_t image_region, gl::texture_compressed_format_e compressed_format, std::span<gl::byte_t const> memory)
+        {
+            require_barrier(gl::memory_barrier_e::texture_update);
+            auto const index_region = gl::region<gl::uint32_t, dimension_v + 1u>{ { image_region.extent, gl::uint32_t{ 1u } }, { image_region.origin, static_cast<gl::uint32_t>(index) } };
+            if constexpr (dimension_v == gl::uint32_t{ 1u }) gl::compressed_texture_sub_image_2d(handle(), image_level, index_region, compressed_format, memory);
+            if constexpr (dimension_v == gl::uint32_t{ 2u }) gl::compressed_texture_sub_image_3d(handle(), image_level, index_region, compressed_format, memory);
+        }
         void generate_mipmaps()
         {
             gl::generate_texture_mipmaps(handle());
@@ -0,0 +1,394 @@
+export module chroma_gl:object.texture_atlas;
+
+import std;
+import opengl;
+import :io.image;
+import :object.texture;
+
+namespace gl
+{
+    //Shelf packer for one layer, rectangles share a row with others of a similar height and free spans within a row are merged on release
+    //Rows that become empty are merged with their empty neighbours and can be split again for rectangles of any height
+    class shelf_allocator
+    {
+    public:
+        struct allocation
+        {
+            gl::vector_2u origin;
+            gl::vector_2u extent;
+        };
+
+        explicit
+        shelf_allocator(gl::vector_2u dimensions)
+            : dimensions_{ dimensions }, shelves_{}, used_area_{ 0u } {}
+
+        auto allocate       (gl::vector_2u extent) -> std::optional<allocation>
+        {
+            if (extent.x == 0u || extent.y == 0u || extent.x > dimensions_.x || extent.y > dimensions_.y) return std::nullopt;
+
+            //The used row that wastes the least height wins, an empty row is only split when no used row fits
+            auto best       = shelves_.end();
+            auto best_waste = std::numeric_limits<gl::uint32_t>::max();
+            for (auto row = shelves_.begin(); row != shelves_.end(); ++row)
+            {
+                if (row->height < extent.y || row->is_empty() || !row->find(extent.x)) continue;
+                if (row->height - extent.y >= best_waste                             ) continue;
+
+                best       = row;
+                best_waste = row->height - extent.y;
+            }
+            if (best == shelves_.end())
+            {
+                best = std::ranges::find_if(shelves_, [&](shelf const& row) { return row.is_empty() && row.height >= extent.y; });
+                if (best != shelves_.end() && best->height > extent.y)
+                {
+                    auto const remainder = shelf{ best->y + extent.y, best->height - extent.y, dimensions_.x };
+                    best->height         = extent.y;
+                    best                 = std::prev(shelves_.insert(std::next(best), remainder));
+                }
+            }
+            if (best == shelves_.end())
+            {
+                auto const top = shelves_.empty() ? gl::uint32_t{ 0u } : shelves_.back().y + shelves_.back().height;
+                if (top + extent.y > dimensions_.y) return std::nullopt;
+
+                best = shelves_.insert(shelves_.end(), shelf{ top, extent.y, dimensions_.x });
+            }
+
+            auto const x = best->take(extent.x);
+            used_area_  += static_cast<gl::size_t>(extent.x) * extent.y;
+
+            return allocation{ gl::vector_2u{ x, best->y }, extent };
+        }
+        void free           (allocation const& value)
+        {
+            auto row = std::ranges::find(shelves_, value.origin.y, &shelf::y);
+            if (row == shelves_.end()) throw std::invalid_argument{ "allocation does not belong to this allocator" };
+
+            row->give(span{ value.origin.x, value.extent.x });
+            used_area_ -= static_cast<gl::size_t>(value.extent.x) * value.extent.y;
+            if (!row->is_empty()) return;
+
+            //Empty rows are merged with their empty neighbours, an empty row at the top is returned to the unclaimed space
+            if (auto const next = std::next(row); next != shelves_.end() && next->is_empty())
+            {
+                row->height += next->height;
+                row          = std::prev(shelves_.erase(next));
+            }
+            if (row != shelves_.begin() && std::prev(row)->is_empty())
+            {
+                std::prev(row)->height += row->height;
+                row                     = std::prev(shelves_.erase(row));
+            }
+            if (std::next(row) == shelves_.end()) shelves_.erase(row);
+        }
+
+        auto used_area      () const -> gl::size_t
+        {
+            return used_area_;
+        }
+        //Free area within rows that hold rectangles, it can only be reused by rectangles no taller than the row
+        auto fragmented_area() const -> gl::size_t
+        {
+            return std::ranges::fold_left(shelves_, gl::size_t{ 0u }, [](gl::size_t sum, shelf const& row)
+                {
+                    return row.is_empty() ? sum : sum + static_cast<gl::size_t>(row.free_width()) * row.height;
+                });
+        }
+
+    private:
+        struct span
+        {
+            gl::uint32_t x;
+            gl::uint32_t width;
+        };
+        struct shelf
+        {
+            shelf(gl::uint32_t y, gl::uint32_t height, gl::uint32_t width)
+                : y{ y }, height{ height }, width{ width }, spans{ span{ 0u, width } } {}
+
+            auto find      (gl::uint32_t extent) const -> gl::bool_t
+            {
+                return std::ranges::any_of(spans, [&](span const& value) { return value.width >= extent; });
+            }
+            auto take      (gl::uint32_t extent) -> gl::uint32_t
+            {
+                auto const it = std::ranges::find_if(spans, [&](span const& value) { return value.width >= extent; });
+                auto const x  = it->x;
+                it->x        += extent;
+                it->width    -= extent;
+                if (it->width == 0u) spans.erase(it);
+
+                return x;
+            }
+            void give      (span value)
+            {
+                auto it = spans.insert(std::ranges::lower_bound(spans, value.x, {}, &span::x), value);
+                if (auto const next = std::next(it); next != spans.end() && it->x + it->width == next->x)
+                {
+                    it->width += next->width;
+                    it         = std::prev(spans.erase(next));
+                }
+                if (it != spans.begin() && std::prev(it)->x + std::prev(it)->width == it->x)
+                {
+                    std::prev(it)->width += it->width;
+                    spans.erase(it);
+                }
+            }
+            auto free_width() const -> gl::uint32_t
+            {
+                return std::ranges::fold_left(spans, gl::uint32_t{ 0u }, [](gl::uint32_t sum, span const& value) { return sum + value.width; });
+            }
+            auto is_empty  () const -> gl::bool_t
+            {
+                return spans.size() == 1u && spans.front().width == width;
+            }
+
+            gl::uint32_t      y;
+            gl::uint32_t      height;
+            gl::uint32_t      width;
+            std::vector<span> spans;
+        };
+
+        gl::vector_2u      dimensions_;
+        std::vector<shelf> shelves_;
+        gl::size_t         used_area_;
+    };
+}
+export namespace gl
+{
+    //Rectangle of an image within its layer, laid out so it can be copied into instance data as is
+    struct atlas_region
+    {
+        gl::vector_4f uv_rectangle; //Minimum and maximum texture coordinates of the image, the gutter excluded
+        gl::uint32_t  layer;
+    };
+    struct atlas_statistics
+    {
+        gl::count_t   layer_count   = 0u;
+        gl::count_t   image_count   = 0u;
+        gl::count_t   evicted_count = 0u;
+        gl::count_t   growth_count  = 0u;
+        gl::float32_t occupancy     = 0.0f; //Share of all texels that belong to images
+        gl::float32_t fragmentation = 0.0f; //Share of the free texels that lie within partially used rows
+    };
+
+    //Packs images into the layers of a texture array so any number of them can be drawn with a single bind
+    //Images are placed on a grid of 2^(levels - 1) texels and surrounded by a gutter of repeated edge texels that is padding texels wide on every level
+    //A full atlas grows by copying its layers into a larger array on the GPU, once it can not grow the least recently used images are evicted
+    class texture_atlas
+    {
+    public:
+        using id_t     = gl::uint64_t;
+        using format_e = gl::texture_2d_array::format_e;
+
+        texture_atlas(format_e format, gl::vector_2u dimensions, gl::count_t layer_count = 1u, gl::count_t maximum_layer_count = 16u, gl::uint32_t mipmap_levels = 1u, gl::uint32_t padding = 1u)
+            : texture_{ layer_count, format, dimensions, mipmap_levels }, layers_{}, maximum_layer_count_{ maximum_layer_count }
+            , alignment_{ gl::uint32_t{ 1u } << (mipmap_levels - 1u) }, gutter_{ padding << (mipmap_levels - 1u) }
+            , entries_{}, recency_{}, sequence_{ 0u }, frame_{ 0u }, image_area_{ 0u }, evicted_count_{ 0u }, growth_count_{ 0u }
+        {
+            if (layer_count == 0u || layer_count > maximum_layer_count             ) throw std::invalid_argument{ "layer count has to be between one and the maximum layer count" };
+            if (dimensions.x % alignment_ != 0u || dimensions.y % alignment_ != 0u) throw std::invalid_argument{ "dimensions have to be a multiple of the mip alignment" };
+
+            layers_.resize(layer_count, gl::shelf_allocator{ dimensions });
+        }
+
+        //Returns nothing when the image does not fit after growing to the maximum layer count and evicting every image not used in this frame
+        //Images larger than a layer once padded can never fit and throw before anything is grown or evicted
+        auto insert    (gl::image const& image) -> std::optional<id_t>
+        {
+            auto const dimensions = image.dimensions();
+            if (dimensions.x == 0u || dimensions.y == 0u) throw std::invalid_argument{ "image is empty" };
+
+            auto const extent     = gl::vector_2u
+            {
+                static_cast<gl::uint32_t>(gl::align_up(dimensions.x, alignment_)) + 2u * gutter_,
+                static_cast<gl::uint32_t>(gl::align_up(dimensions.y, alignment_)) + 2u * gutter_,
+            };
+            if (extent.x > texture_.dimensions().x || extent.y > texture_.dimensions().y) throw std::invalid_argument{ "padded image exceeds atlas dimensions" };
+
+            auto       allocation = allocate_(extent);
+            while (!allocation && layers_.size() < maximum_layer_count_)
+            {
+                grow_(std::min(layers_.size() * 2u, maximum_layer_count_));
+                allocation = allocate_(extent);
+            }
+            while (!allocation && evict_())
+            {
+                allocation = allocate_(extent);
+            }
+            if (!allocation) return std::nullopt;
+
+            auto const& [layer, region] = *allocation;
+            upload_(layer, region.origin, pad_(image, extent));
+
+            auto const id = sequence_++;
+            recency_.emplace_back(id);
+            entries_.emplace(id, entry{ layer, region, dimensions, frame_, std::prev(recency_.end()) });
+            image_area_  += static_cast<gl::size_t>(dimensions.x) * dimensions.y;
+
+            return id;
+        }
+        void erase     (id_t id)
+        {
+            auto const it = entries_.find(id);
+            if (it == entries_.end()) return;
+
+            release_(it);
+        }
+        //Marks the image as used in this frame, images used in the current frame are never evicted
+        void touch     (id_t id)
+        {
+            auto& value      = entries_.at(id);
+            value.last_frame = frame_;
+            recency_.splice(recency_.end(), recency_, value.recency);
+        }
+        void advance   ()
+        {
+            ++frame_;
+        }
+
+        auto contains  (id_t id) const -> gl::bool_t
+        {
+            return entries_.contains(id);
+        }
+        auto region    (id_t id) const -> gl::atlas_region
+        {
+            auto const& value      = entries_.at(id);
+            auto const  dimensions = gl::vector_2f{ texture_.dimensions() };
+            auto const  minimum    = gl::vector_2f{ value.allocation.origin + gutter_                    } / dimensions;
+            auto const  maximum    = gl::vector_2f{ value.allocation.origin + gutter_ + value.dimensions } / dimensions;
+
+            return gl::atlas_region{ gl::vector_4f{ minimum, maximum }, value.layer };
+        }
+        auto statistics() const -> gl::atlas_statistics
+        {
+            auto const total_area = static_cast<gl::size_t>(texture_.dimensions().x) * texture_.dimensions().y * layers_.size();
+            auto const used_area  = std::ranges::fold_left(layers_, gl::size_t{ 0u }, [](gl::size_t sum, gl::shelf_allocator const& layer) { return sum + layer.used_area      (); });
+            auto const fragmented = std::ranges::fold_left(layers_, gl::size_t{ 0u }, [](gl::size_t sum, gl::shelf_allocator const& layer) { return sum + layer.fragmented_area(); });
+            auto const free_area  = total_area - used_area;
+
+            return gl::atlas_statistics
+            {
+                .layer_count   = layers_.size() ,
+                .image_count   = entries_.size(),
+                .evicted_count = evicted_count_ ,
+                .growth_count  = growth_count_  ,
+                .occupancy     = static_cast<gl::float32_t>(image_area_) / static_cast<gl::float32_t>(total_area),
+                .fragmentation = free_area == 0u ? 0.0f : static_cast<gl::float32_t>(fragmented) / static_cast<gl::float32_t>(free_area),
+            };
+        }
+
+        void bind      (gl::binding_t slot)
+        {
+            texture_.bind(slot);
+        }
+        //The texture is replaced when the atlas grows, references to it are only valid until the next insert
+        auto texture   () -> gl::texture_2d_array&
+        {
+            return texture_;
+        }
+
+    private:
+        struct entry
+        {
+            gl::uint32_t                    layer;
+            gl::shelf_allocator::allocation allocation;
+            gl::vector_2u                   dimensions;
+            gl::uint64_t                    last_frame;
+            std::list<id_t>::iterator       recency;
+        };
+
+        auto allocate_(gl::vector_2u extent) -> std::optional<std::pair<gl::uint32_t, gl::shelf_allocator::allocation>>
+        {
+            for (auto layer = gl::uint32_t{ 0u }; layer < layers_.size(); ++layer)
+            {
+                if (auto const allocation = layers_[layer].allocate(extent)) return std::pair{ layer, *allocation };
+            }
+
+            return std::nullopt;
+        }
+        //Every level of the existing layers is copied with a single call, their packing is kept as is
+        void grow_    (gl::count_t layer_count)
+        {
+            auto grown = gl::texture_2d_array{ layer_count, texture_.format(), texture_.dimensions(), texture_.mipmap_levels() };
+            texture_.require_barrier(gl::memory_barrier_e::texture_update);
+            for (auto level = gl::uint32_t{ 0u }; level < texture_.mipmap_levels(); ++level)
+            {
+                auto const dimensions = gl::vector_2u{ std::max(texture_.dimensions().x >> level, 1u), std::max(texture_.dimensions().y >> level, 1u) };
+                auto const region     = gl::hyper_box{ gl::vector_4u{ dimensions, static_cast<gl::uint32_t>(layers_.size()), level } };
+                gl::copy_image_sub_data(texture_.handle(), grown.handle(), gl::texture_target_e::texture_2d_array, gl::texture_target_e::texture_2d_array, region, region);
+            }
+
+            texture_ = std::move(grown);
+            layers_.resize(layer_count, gl::shelf_allocator{ texture_.dimensions() });
+            ++growth_count_;
+        }
+        auto evict_   () -> gl::bool_t
+        {
+            if (recency_.empty()) return gl::false_;
+
+            auto const it = entries_.find(recency_.front());
+            if (it->second.last_frame == frame_) return gl::false_;
+
+            release_(it);
+            ++evicted_count_;
+
+            return gl::true_;
+        }
+        void release_ (std::unordered_map<id_t, entry>::iterator it)
+        {
+            layers_[it->second.layer].free(it->second.allocation);
+            recency_.erase(it->second.recency);
+            image_area_ -= static_cast<gl::size_t>(it->second.dimensions.x) * it->second.dimensions.y;
+            entries_.erase(it);
+        }
+        //Copies the image into the padded extent, texels outside of the image repeat its nearest edge texel
+        auto pad_     (gl::image const& image, gl::vector_2u extent) const -> gl::image
+        {
+            auto const dimensions = image.dimensions();
+            auto const texel_size = image.row_size() / dimensions.x;
+            auto const row_size   = static_cast<gl::size_t>(extent.x) * texel_size;
+            auto const clamp      = [&](gl::uint32_t value, gl::uint32_t limit) { return static_cast<gl::size_t>(std::min(value - std::min(value, gutter_), limit - 1u)); };
+            auto       memory     = std::vector<gl::byte_t>(row_size * extent.y);
+            for (auto y = gl::uint32_t{ 0u }; y < extent.y; ++y)
+            {
+                auto const source = image.data().subspan(clamp(y, dimensions.y) * image.row_size(), image.row_size());
+                auto const row    = memory.data() + y * row_size;
+                for (auto x = gl::uint32_t{ 0u }; x < extent.x; ++x) std::memcpy(row + x * texel_size, source.data() + clamp(x, dimensions.x) * texel_size, texel_size);
+            }
+
+            return gl::image{ image.format(), extent, std::move(memory) };
+        }
+        //The extent and origin are multiples of the alignment, so every level of the block covers whole texels
+        void upload_  (gl::uint32_t layer, gl::vector_2u origin, gl::image const& image)
+        {
+            auto const unpack_alignment = gl::get<gl::data_e::unpack_alignment>();
+            gl::pixel_store<gl::packing_mode_e::unpack_alignment>(1);
+            texture_.upload(layer, 0u, gl::rectangle{ image.dimensions(), origin }, image.descriptor(), image.data());
+            if (texture_.mipmap_levels() > 1u)
+            {
+                auto const levels = image.generate_mipmaps();
+                for (auto level = gl::uint32_t{ 1u }; level < texture_.mipmap_levels(); ++level)
+                {
+                    auto const& current = levels.at(level - 1u);
+                    texture_.upload(layer, level, gl::rectangle{ current.dimensions(), origin >> level }, current.descriptor(), current.data());
+                }
+            }
+            gl::pixel_store<gl::packing_mode_e::unpack_alignment>(static_cast<gl::int32_t>(unpack_alignment));
+        }
+
+        gl::texture_2d_array             texture_;
+        std::vector<gl::shelf_allocator> layers_;
+        gl::count_t                      maximum_layer_count_;
+        gl::uint32_t                     alignment_;
+        gl::uint32_t                     gutter_;
+        std::unordered_map<id_t, entry>  entries_;
+        std::list<id_t>                  recency_;
+        id_t                             sequence_;
+        gl::uint64_t                     frame_;
+        gl::size_t                       image_area_;
+        gl::count_t                      evicted_count_;
+        gl::count_t                      growth_count_;
+    };
+}
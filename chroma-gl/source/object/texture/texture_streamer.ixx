@@ -0,0 +1,350 @@
+export module chroma_gl:object.texture_streamer;
+
+import std;
+import opengl;
+import :io.image;
+import :io.mapped_file;
+import :object.buffer;
+import :object.fence;
+import :object.range_allocator;
+import :object.texture;
+
+export namespace gl
+{
+    //Handle to a texture that is being streamed in, its levels become resident from the smallest to the largest
+    //The status may be queried from any thread, the texture itself may only be used on the GL thread once it is ready
+    class texture_stream
+    {
+    public:
+        enum class priority_e
+        {
+            low   ,
+            normal,
+            high  ,
+        };
+        enum class status_e
+        {
+            queued   ,
+            loading  ,
+            resident ,
+            complete ,
+            cancelled,
+            failed   ,
+        };
+
+        explicit
+        texture_stream(std::filesystem::path path, priority_e priority)
+            : path_{ std::move(path) }, priority_{ priority }, status_{ status_e::queued }, resident_level_{ no_level_ }, texture_{} {}
+
+        //Stops streaming the remaining levels, levels that are already resident are kept
+        void cancel        ()
+        {
+            transition_(status_e::cancelled);
+        }
+
+        auto status        () const -> status_e
+        {
+            return status_.load();
+        }
+        auto is_ready      () const -> gl::bool_t
+        {
+            return resident_level_.load() != no_level_;
+        }
+        auto is_complete   () const -> gl::bool_t
+        {
+            return status() == status_e::complete;
+        }
+        auto is_cancelled  () const -> gl::bool_t
+        {
+            return status() == status_e::cancelled;
+        }
+        auto resident_level() const -> std::optional<gl::uint32_t>
+        {
+            auto const level = resident_level_.load();
+            if (level == no_level_) return std::nullopt;
+
+            return level;
+        }
+        auto texture       () -> gl::texture_2d&
+        {
+            if (!texture_) throw std::runtime_error{ "texture is not resident" };
+
+            return *texture_;
+        }
+        auto path          () const -> std::filesystem::path const&
+        {
+            return path_;
+        }
+        auto priority      () const -> priority_e
+        {
+            return priority_;
+        }
+
+    private:
+        friend class texture_streamer;
+
+        static auto constexpr no_level_ = std::numeric_limits<gl::uint32_t>::max();
+
+        //Complete, cancelled and failed streams do not change status anymore
+        void transition_(status_e status)
+        {
+            auto current = status_.load();
+            while (current != status_e::complete && current != status_e::cancelled && current != status_e::failed)
+            {
+                if (status_.compare_exchange_weak(current, status)) return;
+            }
+        }
+
+        std::filesystem::path           path_;
+        priority_e                      priority_;
+        std::atomic<status_e>           status_;
+        std::atomic<gl::uint32_t>       resident_level_;
+        std::optional<gl::texture_2d>   texture_;
+    };
+
+
+
+    //Reads and decodes textures on a pool of worker threads, which write their levels into a persistently mapped pixel unpack ring
+    //The GL thread only issues buffer sourced uploads within a per-frame budget, a single fence per update guards reuse of the ring
+    //Levels are uploaded from the smallest to the largest, the base level follows along so the texture can be sampled right away
+    class texture_streamer
+    {
+    public:
+        explicit
+        texture_streamer(gl::size_t staging_size = 64u * 1024u * 1024u, gl::count_t worker_count = std::max(std::thread::hardware_concurrency(), 2u) - 1u)
+            : staging_buffer_{ gl::align_up(staging_size, staging_alignment_) }, staging_memory_{}, staging_allocator_{ gl::align_up(staging_size, staging_alignment_) / staging_alignment_ }
+            , staging_mutex_{}, staging_condition_{}, jobs_{}, job_sequence_{ 0u }, job_mutex_{}, job_condition_{}
+            , uploads_{}, upload_sequence_{ 0u }, upload_mutex_{}, released_streams_{}, retirements_{}, workers_{}
+        {
+            if (worker_count == gl::count_t{ 0u }) throw std::invalid_argument{ "worker count must be greater than zero" };
+
+            //The ring is mapped once for the workers, reuse of its slices is tracked by the fences of this streamer
+            staging_memory_ = staging_buffer_.map(gl::index_range{ gl::index_t{ 0u }, staging_buffer_.count() });
+
+            workers_.reserve(worker_count);
+            for (auto index = gl::index_t{ 0u }; index < worker_count; ++index)
+            {
+                workers_.emplace_back([this](std::stop_token stop_token) { work_(stop_token); });
+            }
+        }
+       ~texture_streamer()
+        {
+            std::ranges::for_each(workers_, [](std::jthread& worker) { worker.request_stop(); });
+            workers_.clear();
+        }
+
+        auto load  (std::filesystem::path const& path, gl::texture_stream::priority_e priority = gl::texture_stream::priority_e::normal) -> std::shared_ptr<gl::texture_stream>
+        {
+            auto stream = std::make_shared<gl::texture_stream>(path, priority);
+            {
+                auto const lock = std::scoped_lock{ job_mutex_ };
+                jobs_.emplace(stream, job_sequence_++);
+            }
+            job_condition_.notify_one();
+
+            return stream;
+        }
+        //Uploads pending levels until either budget is exhausted, at least one level is uploaded per call to guarantee progress
+        void update(gl::size_t byte_budget = 8u * 1024u * 1024u, std::chrono::microseconds time_budget = std::chrono::microseconds{ 2000u })
+        {
+            retire_();
+
+            auto const start_time    = std::chrono::steady_clock::now();
+            auto       uploaded_size = gl::size_t{ 0u };
+            auto       allocations   = std::vector<gl::range_allocator::allocation>{};
+            while (gl::true_)
+            {
+                auto upload = std::optional<pending_upload>{};
+                {
+                    auto const lock = std::scoped_lock{ upload_mutex_ };
+                    if (uploads_.empty()) break;
+
+                    auto const is_over_budget = uploaded_size + uploads_.top().size > byte_budget || std::chrono::steady_clock::now() - start_time >= time_budget;
+                    if (uploaded_size != gl::size_t{ 0u } && is_over_budget) break;
+
+                    upload = uploads_.top();
+                    uploads_.pop();
+                }
+
+                if (allocations.empty()) staging_buffer_.bind();
+                if (!upload->stream->is_cancelled()) upload_(*upload);
+
+                uploaded_size += upload->size;
+                allocations.emplace_back(upload->allocation);
+            }
+            if (allocations.empty()) return;
+
+            staging_buffer_.unbind();
+            auto& retirement = retirements_.emplace_back(gl::fence{}, std::move(allocations));
+            retirement.fence.place();
+        }
+
+        auto pending_upload_count() -> gl::count_t
+        {
+            auto const lock = std::scoped_lock{ upload_mutex_ };
+            return uploads_.size();
+        }
+        auto staging_statistics  () -> gl::allocator_statistics
+        {
+            auto const lock = std::scoped_lock{ staging_mutex_ };
+            return staging_allocator_.statistics();
+        }
+
+    private:
+        static auto constexpr staging_alignment_ = gl::size_t{ 256u };
+
+        struct load_job
+        {
+            std::shared_ptr<gl::texture_stream> stream;
+            gl::uint64_t                        sequence;
+        };
+        struct pending_upload
+        {
+            std::shared_ptr<gl::texture_stream> stream;
+            gl::uint64_t                        sequence;
+            gl::uint32_t                        level;
+            gl::vector_2u                       dimensions;
+            gl::size_t                          size;
+            gl::range_allocator::allocation     allocation;
+        };
+        struct retirement
+        {
+            gl::fence                                    fence;
+            std::vector<gl::range_allocator::allocation> allocations;
+        };
+        //Higher priorities go first, submissions of equal priority are served in order
+        struct priority_order
+        {
+            auto operator()(auto const& left, auto const& right) const -> gl::bool_t
+            {
+                if (left.stream->priority() != right.stream->priority()) return left.stream->priority() < right.stream->priority();
+                return left.sequence > right.sequence;
+            }
+        };
+
+        void work_   (std::stop_token stop_token)
+        {
+            while (!stop_token.stop_requested())
+            {
+                auto job = std::optional<load_job>{};
+                {
+                    auto lock = std::unique_lock{ job_mutex_ };
+                    if (!job_condition_.wait(lock, stop_token, [this] { return !jobs_.empty(); })) return;
+
+                    job = jobs_.top();
+                    jobs_.pop();
+                }
+
+                try
+                {
+                    stream_(stop_token, job->stream);
+                }
+                catch (...)
+                {
+                    job->stream->transition_(gl::texture_stream::status_e::failed);
+                }
+
+                //The worker may hold the last reference once the caller dropped its handle, the texture has to be destroyed on the GL thread
+                auto const lock = std::scoped_lock{ upload_mutex_ };
+                released_streams_.emplace_back(std::move(job->stream));
+            }
+        }
+        //Decodes the image, builds its mip chain and stages the levels from the smallest to the largest
+        void stream_ (std::stop_token stop_token, std::shared_ptr<gl::texture_stream> const& handle)
+        {
+            auto& stream = *handle;
+            if (stream.is_cancelled()) return;
+            stream.transition_(gl::texture_stream::status_e::loading);
+
+            auto const file   = gl::io::mapped_file{ stream.path() };
+            auto const image   = gl::image::decode(gl::image::format_e::rgba_uint8, file.data());
+            auto const levels  = gl::mipmap_levels(image.dimensions());
+            auto const mipmaps = image.generate_mipmaps();
+
+            for (auto level = levels; level-- > gl::uint32_t{ 0u };)
+            {
+                auto const memory     = level == gl::uint32_t{ 0u } ? image.data() : mipmaps[level - 1u].data();
+                auto const allocation = acquire_(stop_token, stream, memory.size());
+                if (!allocation) return;
+
+                std::memcpy(staging_memory_.data() + allocation->index * staging_alignment_, memory.data(), memory.size());
+
+                auto const lock = std::scoped_lock{ upload_mutex_ };
+                uploads_.emplace(handle, upload_sequence_++, level, image.dimensions(), memory.size(), *allocation);
+            }
+        }
+        //Blocks until the ring has room for the level, returns nothing when the stream is cancelled or the streamer stops
+        auto acquire_(std::stop_token stop_token, gl::texture_stream& stream, gl::size_t size) -> std::optional<gl::range_allocator::allocation>
+        {
+            auto const block_count = gl::align_up(size, staging_alignment_) / staging_alignment_;
+            if (block_count > staging_allocator_.capacity()) throw std::runtime_error{ "texture level exceeds staging capacity" };
+
+            auto allocation = std::optional<gl::range_allocator::allocation>{};
+            auto lock       = std::unique_lock{ staging_mutex_ };
+            staging_condition_.wait(lock, stop_token, [&]
+                {
+                    if (stream.is_cancelled()) return gl::true_;
+
+                    allocation = staging_allocator_.allocate(block_count);
+                    return allocation.has_value();
+                });
+
+            return allocation;
+        }
+        void upload_ (pending_upload const& upload)
+        {
+            auto& stream = *upload.stream;
+            if (!stream.texture_) stream.texture_.emplace(gl::texture_2d::format_e::rgba_uint8_n, upload.dimensions);
+
+            auto const texture_data_descriptor = gl::texture_data_descriptor{ gl::texture_base_format_e::rgba, gl::pixel_data_type_e::byte };
+            stream.texture_->upload(upload.level, gl::rectangle{ level_dimensions_(upload.dimensions, upload.level) }, texture_data_descriptor, upload.allocation.index * staging_alignment_);
+            stream.texture_->apply<gl::texture_parameter_e::base_level>(upload.level);
+
+            stream.resident_level_ = upload.level;
+            stream.transition_(upload.level == gl::uint32_t{ 0u } ? gl::texture_stream::status_e::complete : gl::texture_stream::status_e::resident);
+        }
+        void retire_ ()
+        {
+            auto released_streams = std::vector<std::shared_ptr<gl::texture_stream>>{};
+            {
+                auto const lock = std::scoped_lock{ upload_mutex_ };
+                released_streams = std::exchange(released_streams_, {});
+            }
+
+            auto is_released = gl::false_;
+            while (!retirements_.empty() && retirements_.front().fence.is_signaled())
+            {
+                {
+                    auto const lock = std::scoped_lock{ staging_mutex_ };
+                    std::ranges::for_each(retirements_.front().allocations, [this](auto const& allocation) { staging_allocator_.free(allocation); });
+                }
+
+                retirements_.pop_front();
+                is_released = gl::true_;
+            }
+
+            if (is_released) staging_condition_.notify_all();
+        }
+
+        static auto level_dimensions_(gl::vector_2u dimensions, gl::uint32_t level) -> gl::vector_2u
+        {
+            return gl::vector_2u{ std::max(dimensions.x >> level, gl::uint32_t{ 1u }), std::max(dimensions.y >> level, gl::uint32_t{ 1u }) };
+        }
+
+        gl::pixel_unpack_buffer                                                              staging_buffer_;
+        std::span<gl::byte_t>                                                                staging_memory_;
+        gl::range_allocator                                                                  staging_allocator_;
+        std::mutex                                                                           staging_mutex_;
+        std::condition_variable_any                                                          staging_condition_;
+        std::priority_queue<load_job, std::vector<load_job>, priority_order>                 jobs_;
+        gl::uint64_t                                                                         job_sequence_;
+        std::mutex                                                                           job_mutex_;
+        std::condition_variable_any                                                          job_condition_;
+        std::priority_queue<pending_upload, std::vector<pending_upload>, priority_order>     uploads_;
+        gl::uint64_t                                                                         upload_sequence_;
+        std::mutex                                                                           upload_mutex_;
+        std::vector<std::shared_ptr<gl::texture_stream>>                                     released_streams_;
+        std::deque<retirement>                                                               retirements_;
+        std::vector<std::jthread>                                                            workers_;
+    };
+}
@@ -37,13 +37,13 @@ export namespace gl
         }
 
         template<typename layout_t>
-        void attach     (gl::buffer& vertex_buffer, std::optional<gl::index_t> target_location = std::nullopt)
+        void attach     (gl::buffer& vertex_buffer, std::optional<gl::index_t> target_location = std::nullopt, gl::offset_t buffer_offset = 0u)
         {
             using tuple_t         = typename layout_t::tuple_t;
             attribute_location_   = target_location.value_or(attribute_location_);
             auto attribute_offset = gl::ptrdiff_t{ 0 };
 
-            gl::vertex_array_vertex_buffer(handle(), vertex_buffer.handle(), binding_point_, gl::ptrdiff_t{ 0 }, layout_t::stride);
+            gl::vertex_array_vertex_buffer(handle(), vertex_buffer.handle(), binding_point_, static_cast<gl::ptrdiff_t>(buffer_offset), layout_t::stride);
             std::apply([&](auto... attributes)
                 {
                     (std::invoke([&](auto attribute)
@@ -54,7 +54,7 @@ export namespace gl
                             gl::vertex_array_binding_divisor(handle(), binding_point_, attribute_t::divisor);
                             for (auto index = gl::index_t{ 0u }; index < attribute_t::locations; ++index)
                             {
-                                auto const location_offset = attribute_offset + (index * attribute_t::count * sizeof(component_t));
+                                auto const location_offset = attribute_offset + static_cast<gl::ptrdiff_t>(index * gl::location_size<component_t>(attribute_t::count));
 
                                 gl::enable_vertex_array_attribute (handle(), attribute_location_);
                                 gl::vertex_array_attribute_format (handle(), gl::map_attribute_type<component_t>(), attribute_location_, attribute_t::count, location_offset, attribute_t::is_normalized);
@@ -33,6 +33,28 @@ import opengl;
         static auto constexpr count     = gl::size_t{ 4u };
         static auto constexpr locations = gl::size_t{ 1u };
     };
+    template<typename component_t, gl::size_t components_v>
+    struct component_traits<std::array<component_t, components_v>>
+    {
+        using type = component_t; 
+        static auto constexpr count     = gl::size_t{ components_v };
+        static auto constexpr locations = gl::size_t{ 1u           };
+    };
+    template<>
+    struct component_traits<gl::int32_2_10_10_10_r_t>
+    {
+        using type = gl::int32_2_10_10_10_r_t; 
+        static auto constexpr count     = gl::size_t{ 4u };
+        static auto constexpr locations = gl::size_t{ 1u };
+    };
+
+    //Packed components hold every component of a location in one element
+    template<typename component_t>
+    auto constexpr location_size(gl::size_t count) -> gl::size_t
+    {
+        if constexpr (std::is_same_v<component_t, gl::int32_2_10_10_10_r_t>) return sizeof(component_t);
+        else                                                                 return sizeof(component_t) * count;
+    }
 }
 export namespace gl
 {
@@ -45,8 +67,8 @@ export namespace gl
         static auto constexpr locations     = locations_v;
         static auto constexpr divisor       = divisor_v;
         static auto constexpr is_normalized = is_normalized_v;
-        static auto constexpr size          = count_v * locations_v * sizeof(component_t);
+        static auto constexpr size          = locations_v * gl::location_size<component_t>(count_v);
         
-        static_assert(std::is_integral_v<component_t> || std::is_floating_point_v<component_t>, "invalid vertex attribute type");
+        static_assert(std::is_integral_v<component_t> || std::is_floating_point_v<component_t> || std::is_same_v<component_t, gl::half_t> || std::is_same_v<component_t, gl::int32_2_10_10_10_r_t>, "invalid vertex attribute type");
     };
 }
@@ -0,0 +1,337 @@
+export module opengl:barrier;
+
+import std;
+import <glad/gl.h>;
+import :constants;
+import :flags;
+import :types;
+import :utility;
+
+export namespace gl::barrier
+{
+    //Tracks incoherent shader writes to buffers and textures of the context that is current on the calling thread
+    //Buffers bound to shader storage or atomic counter units and images with write access count as written by every draw and dispatch
+    //Draws, dispatches and pixel transfers resolve the bindings they read right before they are issued, transfers and maps of objects request their bits directly
+    //Bits whose last barrier was issued after the latest write of a resource are not issued again
+    enum class resource_e
+    {
+        buffer ,
+        texture,
+    };
+    enum class binding_e
+    {
+        atomic_counter_buffer   ,
+        shader_storage_buffer   ,
+        uniform_buffer          ,
+        image_unit              ,
+        texture_unit            ,
+        draw_indirect_buffer    ,
+        dispatch_indirect_buffer,
+        parameter_buffer        ,
+        pixel_pack_buffer       ,
+        pixel_unpack_buffer     ,
+    };
+    enum class command_e
+    {
+        draw        ,
+        dispatch    ,
+        pixel_pack  ,
+        pixel_unpack,
+    };
+
+    struct statistics
+    {
+        gl::uint64_t issued  = 0u; //Barriers issued for uses of written resources
+        gl::uint64_t avoided = 0u; //Barrier bits an earlier barrier already covered
+        gl::uint64_t manual  = 0u; //Barriers issued directly through memory_barrier
+    };
+
+    class context
+    {
+    public:
+        //Uniform, shader storage and atomic counter bindings are read by draws and dispatches, other targets are ignored
+        //Only bindings with write access count as written, uniform buffers can not be written by shaders
+        void bind_buffer          (gl::buffer_base_target_e target, gl::binding_t unit, gl::handle_t buffer, gl::image_access_e access = gl::image_access_e::read_only )
+        {
+            switch (target)
+            {
+                case gl::buffer_base_target_e::atomic_counter_buffer: bind_(gl::barrier::binding_e::atomic_counter_buffer, unit, buffer, access                        ); break;
+                case gl::buffer_base_target_e::shader_storage_buffer: bind_(gl::barrier::binding_e::shader_storage_buffer, unit, buffer, access                        ); break;
+                case gl::buffer_base_target_e::uniform_buffer       : bind_(gl::barrier::binding_e::uniform_buffer       , unit, buffer, gl::image_access_e::read_only); break;
+
+                default: return;
+            }
+        }
+        //Indirect, parameter and pixel transfer buffers are read by the commands that source from them, other targets are ignored
+        void bind_buffer          (gl::buffer_target_e target, gl::handle_t buffer)
+        {
+            auto binding = gl::barrier::binding_e{};
+            switch (target)
+            {
+                case gl::buffer_target_e::draw_indirect_buffer    : binding = gl::barrier::binding_e::draw_indirect_buffer    ; break;
+                case gl::buffer_target_e::dispatch_indirect_buffer: binding = gl::barrier::binding_e::dispatch_indirect_buffer; break;
+                case gl::buffer_target_e::parameter_buffer        : binding = gl::barrier::binding_e::parameter_buffer        ; break;
+                case gl::buffer_target_e::pixel_pack_buffer       : binding = gl::barrier::binding_e::pixel_pack_buffer       ; break;
+                case gl::buffer_target_e::pixel_unpack_buffer     : binding = gl::barrier::binding_e::pixel_unpack_buffer     ; break;
+
+                default: return;
+            }
+
+            bind_(binding, gl::binding_t{ 0u }, buffer, gl::image_access_e::read_only);
+        }
+        void bind_texture         (gl::binding_t unit, gl::handle_t texture)
+        {
+            bind_(gl::barrier::binding_e::texture_unit, unit, texture, gl::image_access_e::read_only);
+        }
+        void bind_image           (gl::binding_t unit, gl::handle_t texture, gl::image_access_e access)
+        {
+            bind_(gl::barrier::binding_e::image_unit  , unit, texture, access                        );
+        }
+        //The vertex and index buffers of the bound vertex array are read by draws
+        void bind_vertex_array    (gl::handle_t vertex_array)
+        {
+            if (vertex_array_ == vertex_array) return;
+
+            vertex_array_ = vertex_array;
+            ++generation_;
+        }
+        void attach_vertex_buffer (gl::handle_t vertex_array, gl::binding_t binding, gl::handle_t buffer)
+        {
+            auto& vertex_buffers = vertex_arrays_[vertex_array].vertex_buffers;
+            std::erase_if(vertex_buffers, [&](auto const& value) { return value.first == binding; });
+            if (buffer != gl::null_object) vertex_buffers.emplace_back(binding, buffer);
+            ++generation_;
+        }
+        void attach_element_buffer(gl::handle_t vertex_array, gl::handle_t buffer)
+        {
+            vertex_arrays_[vertex_array].element_buffer = buffer;
+            ++generation_;
+        }
+
+        //Called after every draw and dispatch, each writable binding may have been written by it
+        void submit               ()
+        {
+            if (writable_bindings_.empty()) return;
+
+            ++serial_;
+            ++generation_;
+            for (auto const& [key, handle] : writable_bindings_)
+            {
+                writes_.insert_or_assign(resource_key_(resource_(binding_(key)), handle), serial_);
+            }
+        }
+        //Returns the bits that have to be issued before the command reads its bindings, they are recorded as issued
+        //Nothing is looked up again until a binding changes or a command writes
+        auto resolve              (gl::barrier::command_e command) -> gl::memory_barrier_e
+        {
+            auto& resolved = resolved_[gl::to_underlying(command)];
+            if (resolved == generation_) return gl::memory_barrier_e{};
+            resolved = generation_;
+            if (writes_.empty()) return gl::memory_barrier_e{};
+
+            auto required = gl::memory_barrier_e{};
+            for (auto const& [key, binding] : bindings_)
+            {
+                if (!binding.is_read) continue;
+
+                auto const barrier = read_barrier_(binding_(key), command);
+                if (barrier != gl::memory_barrier_e{}) required |= pending_(resource_(binding_(key)), binding.handle, barrier);
+            }
+            if (command == gl::barrier::command_e::draw && vertex_array_ != gl::null_object)
+            {
+                if (auto const iterator = vertex_arrays_.find(vertex_array_); iterator != vertex_arrays_.end())
+                {
+                    for (auto const& [binding, buffer] : iterator->second.vertex_buffers) required |= pending_(gl::barrier::resource_e::buffer, buffer, gl::memory_barrier_e::vertex_attribute_array);
+                    if (iterator->second.element_buffer != gl::null_object) required |= pending_(gl::barrier::resource_e::buffer, iterator->second.element_buffer, gl::memory_barrier_e::element_array);
+                }
+            }
+
+            return issue_(required);
+        }
+        //Returns the bits that have to be issued before the resource is used, they are recorded as issued
+        auto require              (gl::barrier::resource_e resource, gl::handle_t handle, gl::memory_barrier_e barrier) -> gl::memory_barrier_e
+        {
+            return issue_(pending_(resource, handle, barrier));
+        }
+        void record_barrier       (gl::memory_barrier_e barrier)
+        {
+            ++statistics_.manual;
+            cover_(barrier);
+        }
+
+        //Deleted objects release their handle, which may be reused by a new object
+        void erase                (gl::barrier::resource_e resource, gl::handle_t handle)
+        {
+            writes_.erase(resource_key_(resource, handle));
+
+            auto const is_bound = [&](auto const& value) { return resource_(binding_(value.first)) == resource && handle_(value.second) == handle; };
+            std::erase_if(bindings_         , is_bound);
+            std::erase_if(writable_bindings_, is_bound);
+            if (resource == gl::barrier::resource_e::buffer)
+            {
+                for (auto& [vertex_array, state] : vertex_arrays_)
+                {
+                    std::erase_if(state.vertex_buffers, [&](auto const& value) { return value.second == handle; });
+                    if (state.element_buffer == handle) state.element_buffer = gl::null_object;
+                }
+            }
+            ++generation_;
+        }
+        void erase_vertex_array   (gl::handle_t vertex_array)
+        {
+            vertex_arrays_.erase(vertex_array);
+            if (vertex_array_ == vertex_array) vertex_array_ = gl::null_object;
+            ++generation_;
+        }
+        void invalidate           ()
+        {
+            bindings_         .clear();
+            writable_bindings_.clear();
+            vertex_arrays_    .clear();
+            writes_           .clear();
+            covered_.fill(0u);
+            vertex_array_ = gl::null_object;
+            serial_       = 0u;
+            ++generation_;
+        }
+
+        auto statistics           () const -> gl::barrier::statistics
+        {
+            return statistics_;
+        }
+
+    private:
+        struct binding
+        {
+            gl::handle_t handle;
+            gl::bool_t   is_read;
+        };
+        struct vertex_array
+        {
+            std::vector<std::pair<gl::binding_t, gl::handle_t>> vertex_buffers{};
+            gl::handle_t                                        element_buffer{ gl::null_object };
+        };
+
+        static auto binding_key_ (gl::barrier::binding_e  binding , gl::binding_t unit  ) -> gl::uint64_t
+        {
+            return (static_cast<gl::uint64_t>(binding ) << 32u) | static_cast<gl::uint64_t>(unit);
+        }
+        static auto resource_key_(gl::barrier::resource_e resource, gl::handle_t  handle) -> gl::uint64_t
+        {
+            return (static_cast<gl::uint64_t>(resource) << 32u) | static_cast<gl::uint64_t>(gl::to_underlying(handle));
+        }
+        static auto binding_     (gl::uint64_t key) -> gl::barrier::binding_e
+        {
+            return static_cast<gl::barrier::binding_e>(key >> 32u);
+        }
+        static auto resource_    (gl::barrier::binding_e binding) -> gl::barrier::resource_e
+        {
+            return binding == gl::barrier::binding_e::image_unit || binding == gl::barrier::binding_e::texture_unit ? gl::barrier::resource_e::texture : gl::barrier::resource_e::buffer;
+        }
+        static auto handle_      (gl::handle_t                  value) -> gl::handle_t
+        {
+            return value;
+        }
+        static auto handle_      (gl::barrier::context::binding value) -> gl::handle_t
+        {
+            return value.handle;
+        }
+        //The barrier bit that makes shader writes visible to the command's reads through the binding, none if the command does not read it
+        static auto read_barrier_(gl::barrier::binding_e binding, gl::barrier::command_e command) -> gl::memory_barrier_e
+        {
+            auto const is_shader = command == gl::barrier::command_e::draw || command == gl::barrier::command_e::dispatch;
+            switch (binding)
+            {
+                case gl::barrier::binding_e::atomic_counter_buffer   : return is_shader                                     ? gl::memory_barrier_e::atomic_counter      : gl::memory_barrier_e{};
+                case gl::barrier::binding_e::shader_storage_buffer   : return is_shader                                     ? gl::memory_barrier_e::shader_storage      : gl::memory_barrier_e{};
+                case gl::barrier::binding_e::uniform_buffer          : return is_shader                                     ? gl::memory_barrier_e::uniform             : gl::memory_barrier_e{};
+                case gl::barrier::binding_e::image_unit              : return is_shader                                     ? gl::memory_barrier_e::shader_image_access : gl::memory_barrier_e{};
+                case gl::barrier::binding_e::texture_unit            : return is_shader                                     ? gl::memory_barrier_e::texture_fetch       : gl::memory_barrier_e{};
+                case gl::barrier::binding_e::draw_indirect_buffer    :
+                case gl::barrier::binding_e::parameter_buffer        : return command == gl::barrier::command_e::draw        ? gl::memory_barrier_e::command             : gl::memory_barrier_e{};
+                case gl::barrier::binding_e::dispatch_indirect_buffer: return command == gl::barrier::command_e::dispatch    ? gl::memory_barrier_e::command             : gl::memory_barrier_e{};
+                case gl::barrier::binding_e::pixel_pack_buffer       : return command == gl::barrier::command_e::pixel_pack  ? gl::memory_barrier_e::pixel_buffer        : gl::memory_barrier_e{};
+                case gl::barrier::binding_e::pixel_unpack_buffer     : return command == gl::barrier::command_e::pixel_unpack? gl::memory_barrier_e::pixel_buffer        : gl::memory_barrier_e{};
+
+                default: return gl::memory_barrier_e{};
+            }
+        }
+
+        void bind_   (gl::barrier::binding_e binding, gl::binding_t unit, gl::handle_t handle, gl::image_access_e access)
+        {
+            auto const key     = binding_key_(binding, unit);
+            auto const is_read = access != gl::image_access_e::write_only;
+            if (auto const iterator = bindings_.find(key); iterator != bindings_.end() && iterator->second.handle == handle && iterator->second.is_read == is_read && writable_bindings_.contains(key) == (access != gl::image_access_e::read_only)) return;
+
+            if (handle != gl::null_object) bindings_.insert_or_assign(key, gl::barrier::context::binding{ handle, is_read });
+            else                           bindings_.erase           (key);
+
+            if (handle != gl::null_object && access != gl::image_access_e::read_only) writable_bindings_.insert_or_assign(key, handle);
+            else                                                                       writable_bindings_.erase           (key        );
+            ++generation_;
+        }
+        auto pending_(gl::barrier::resource_e resource, gl::handle_t handle, gl::memory_barrier_e barrier) -> gl::memory_barrier_e
+        {
+            auto const iterator = writes_.find(resource_key_(resource, handle));
+            if (iterator == writes_.end()) return gl::memory_barrier_e{};
+
+            auto required = gl::memory_barrier_e{};
+            for (auto bits = gl::to_underlying(barrier); bits != 0u; bits &= bits - 1u)
+            {
+                auto const index = static_cast<gl::size_t>(std::countr_zero(bits));
+                if (covered_[index] >= iterator->second) ++statistics_.avoided;
+                else                                     required |= static_cast<gl::memory_barrier_e>(bits & (~bits + 1u));
+            }
+
+            return required;
+        }
+        auto issue_  (gl::memory_barrier_e required) -> gl::memory_barrier_e
+        {
+            if (required == gl::memory_barrier_e{}) return required;
+
+            ++statistics_.issued;
+            cover_(required);
+            return required;
+        }
+        void cover_  (gl::memory_barrier_e barrier)
+        {
+            for (auto bits = gl::to_underlying(barrier); bits != 0u; bits &= bits - 1u)
+            {
+                covered_[static_cast<gl::size_t>(std::countr_zero(bits))] = serial_;
+            }
+        }
+
+        std::unordered_map<gl::uint64_t, gl::barrier::context::binding>      bindings_{};
+        std::unordered_map<gl::uint64_t, gl::handle_t>                       writable_bindings_{};
+        std::unordered_map<gl::handle_t, gl::barrier::context::vertex_array> vertex_arrays_{};
+        std::unordered_map<gl::uint64_t, gl::uint64_t>                       writes_{};
+        std::array<gl::uint64_t, 32u>                                        covered_{};
+        std::array<gl::uint64_t, 4u>                                         resolved_{};
+        gl::handle_t                                                         vertex_array_{ gl::null_object };
+        gl::uint64_t                                                         serial_{ 0u };
+        gl::uint64_t                                                         generation_{ 1u };
+        gl::barrier::statistics                                              statistics_{};
+    };
+
+
+
+    auto current   () -> gl::barrier::context&
+    {
+        thread_local auto context = gl::barrier::context{};
+        return context;
+    }
+    //Issues the bits the bindings read by the command depend on, the opengl functions call it right before the command
+    void resolve   (gl::barrier::command_e command)
+    {
+        auto const required = gl::barrier::current().resolve(command);
+        if (required != gl::memory_barrier_e{}) ::glMemoryBarrier(gl::to_underlying(required));
+    }
+    void invalidate()
+    {
+        gl::barrier::current().invalidate();
+    }
+    auto statistics() -> gl::barrier::statistics
+    {
+        return gl::barrier::current().statistics();
+    }
+}
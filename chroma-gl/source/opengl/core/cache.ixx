@@ -0,0 +1,264 @@
+export module opengl:cache;
+
+import std;
+import :constants;
+import :domain;
+import :flags;
+import :types;
+import :utility;
+
+export namespace gl::cache
+{
+    //Shadow copy of the binding state of the context that is current on the calling thread
+    //Every update returns whether the driver call is required; calls that change nothing are counted as elided
+    //Entries are "unknown" until they are first set, call invalidate after foreign code has modified the context
+    struct statistics
+    {
+        gl::uint64_t issued = 0u;
+        gl::uint64_t elided = 0u;
+    };
+
+    class context
+    {
+    public:
+        auto update_buffer      (gl::buffer_target_e target, gl::handle_t buffer) -> gl::bool_t
+        {
+            if (target == gl::buffer_target_e::element_array_buffer) return record_(gl::true_);
+
+            return update_(buffer_slot_(gl::to_underlying(target)), buffer);
+        }
+        auto update_buffer_base (gl::buffer_base_target_e target, gl::binding_t binding, gl::handle_t buffer) -> gl::bool_t
+        {
+            auto& indexed_bindings = indexed_buffers_[gl::to_underlying(target)];
+            if (binding >= indexed_bindings.size()) indexed_bindings.resize(binding + 1u, unknown_);
+
+            auto const is_required = update_(indexed_bindings[binding], buffer);
+            if (is_required) buffer_slot_(gl::to_underlying(target)) = buffer;
+
+            return is_required;
+        }
+        void forget_buffer_base (gl::buffer_base_target_e target, gl::binding_t binding, gl::count_t count = 1u)
+        {
+            auto& indexed_bindings = indexed_buffers_[gl::to_underlying(target)];
+            auto const last        = std::min<gl::size_t>(binding + count, indexed_bindings.size());
+            for (auto index = gl::size_t{ binding }; index < last; ++index) indexed_bindings[index] = unknown_;
+
+            buffer_slot_(gl::to_underlying(target)) = unknown_;
+        }
+        auto update_texture_unit(gl::binding_t binding, gl::handle_t texture) -> gl::bool_t
+        {
+            return update_(unit_slot_(texture_units_, binding), texture);
+        }
+        auto update_sampler     (gl::binding_t binding, gl::handle_t sampler) -> gl::bool_t
+        {
+            return update_(unit_slot_(sampler_units_, binding), sampler);
+        }
+        auto update_pipeline    (gl::handle_t pipeline) -> gl::bool_t
+        {
+            return update_(pipeline_, pipeline);
+        }
+        auto update_vertex_array(gl::handle_t vertex_array) -> gl::bool_t
+        {
+            return update_(vertex_array_, vertex_array);
+        }
+        auto update_frame_buffer(gl::frame_buffer_target_e target, gl::handle_t frame_buffer) -> gl::bool_t
+        {
+            switch (target)
+            {
+                case gl::frame_buffer_target_e::read      : return update_(read_frame_buffer_, frame_buffer);
+                case gl::frame_buffer_target_e::write     : return update_(draw_frame_buffer_, frame_buffer);
+                case gl::frame_buffer_target_e::read_write:
+                {
+                    auto const is_required = read_frame_buffer_ != frame_buffer || draw_frame_buffer_ != frame_buffer;
+                    read_frame_buffer_ = frame_buffer;
+                    draw_frame_buffer_ = frame_buffer;
+
+                    return record_(is_required);
+                }
+
+                default: throw std::invalid_argument{ "invalid frame buffer target" };
+            }
+        }
+        auto update_feature     (gl::feature_e feature, gl::bool_t state) -> gl::bool_t
+        {
+            auto const [iterator, is_inserted] = features_.try_emplace(feature, state);
+            if (is_inserted) return record_(gl::true_);
+
+            auto const is_required = iterator->second != state;
+            iterator->second = state;
+
+            return record_(is_required);
+        }
+        void forget_feature     (gl::feature_e feature)
+        {
+            features_.erase(feature);
+        }
+        auto update_viewport    (gl::rectangle const& region) -> gl::bool_t
+        {
+            auto const is_required = viewport_ != region;
+            viewport_ = region;
+
+            return record_(is_required);
+        }
+        void forget_viewport    ()
+        {
+            viewport_.reset();
+        }
+        auto update_clear_color (gl::vector_4f const& color) -> gl::bool_t
+        {
+            auto const is_required = clear_color_ != color;
+            clear_color_ = color;
+
+            return record_(is_required);
+        }
+
+        //Buffers use immutable storage, their size never changes once it has been specified
+        void record_buffer_size (gl::handle_t buffer, gl::size_t size)
+        {
+            buffer_sizes_.insert_or_assign(buffer, size);
+        }
+        auto buffer_size        (gl::handle_t buffer) const -> std::optional<gl::size_t>
+        {
+            auto const iterator = buffer_sizes_.find(buffer);
+            if (iterator == buffer_sizes_.end()) return std::nullopt;
+
+            return iterator->second;
+        }
+
+        auto buffer             (gl::buffer_target_e target) const -> std::optional<gl::handle_t>
+        {
+            auto const iterator = buffers_.find(gl::to_underlying(target));
+            if (iterator == buffers_.end() || iterator->second == unknown_) return std::nullopt;
+
+            return iterator->second;
+        }
+        auto texture_unit       (gl::binding_t binding) const -> std::optional<gl::handle_t>
+        {
+            if (binding >= texture_units_.size() || texture_units_[binding] == unknown_) return std::nullopt;
+
+            return texture_units_[binding];
+        }
+        auto vertex_array       () const -> std::optional<gl::handle_t>
+        {
+            if (vertex_array_ == unknown_) return std::nullopt;
+
+            return vertex_array_;
+        }
+
+        //Deleting a bound object reverts its bindings to zero
+        void erase_buffer       (gl::handle_t buffer)
+        {
+            buffer_sizes_.erase(buffer);
+            for (auto& [target, binding]          : buffers_        ) replace_(binding, buffer);
+            for (auto& [target, indexed_bindings] : indexed_buffers_) for (auto& binding : indexed_bindings) replace_(binding, buffer);
+        }
+        void erase_texture      (gl::handle_t texture)
+        {
+            for (auto& binding : texture_units_) replace_(binding, texture);
+        }
+        void erase_sampler      (gl::handle_t sampler)
+        {
+            for (auto& binding : sampler_units_) replace_(binding, sampler);
+        }
+        void erase_pipeline     (gl::handle_t pipeline)
+        {
+            replace_(pipeline_, pipeline);
+        }
+        void erase_vertex_array (gl::handle_t vertex_array)
+        {
+            replace_(vertex_array_, vertex_array);
+        }
+        void erase_frame_buffer (gl::handle_t frame_buffer)
+        {
+            replace_(read_frame_buffer_, frame_buffer);
+            replace_(draw_frame_buffer_, frame_buffer);
+        }
+
+        void invalidate         ()
+        {
+            buffers_          .clear();
+            indexed_buffers_  .clear();
+            texture_units_    .clear();
+            sampler_units_    .clear();
+            features_         .clear();
+            viewport_         .reset();
+            clear_color_      .reset();
+            buffer_sizes_     .clear();
+
+            pipeline_          = unknown_;
+            vertex_array_      = unknown_;
+            read_frame_buffer_ = unknown_;
+            draw_frame_buffer_ = unknown_;
+        }
+        void reset_statistics   ()
+        {
+            statistics_ = {};
+        }
+
+        auto statistics         () const -> gl::cache::statistics
+        {
+            return statistics_;
+        }
+
+    private:
+        static auto constexpr unknown_ = gl::handle_t{ std::numeric_limits<gl::uint32_t>::max() };
+
+        auto record_            (gl::bool_t is_required) -> gl::bool_t
+        {
+            if (is_required) ++statistics_.issued;
+            else             ++statistics_.elided;
+
+            return is_required;
+        }
+        auto update_            (gl::handle_t& slot, gl::handle_t value) -> gl::bool_t
+        {
+            auto const is_required = slot != value;
+            slot = value;
+
+            return record_(is_required);
+        }
+        void replace_           (gl::handle_t& slot, gl::handle_t value)
+        {
+            if (slot == value) slot = gl::null_object;
+        }
+        auto buffer_slot_       (gl::enum_t target) -> gl::handle_t&
+        {
+            return buffers_.try_emplace(target, unknown_).first->second;
+        }
+        auto unit_slot_         (std::vector<gl::handle_t>& units, gl::binding_t binding) -> gl::handle_t&
+        {
+            if (binding >= units.size()) units.resize(binding + 1u, unknown_);
+            return units[binding];
+        }
+
+        std::unordered_map<gl::enum_t, gl::handle_t>              buffers_{};
+        std::unordered_map<gl::enum_t, std::vector<gl::handle_t>> indexed_buffers_{};
+        std::vector<gl::handle_t>                                 texture_units_{};
+        std::vector<gl::handle_t>                                 sampler_units_{};
+        std::unordered_map<gl::feature_e, gl::bool_t>             features_{};
+        std::optional<gl::rectangle>                              viewport_{};
+        std::optional<gl::vector_4f>                              clear_color_{};
+        std::unordered_map<gl::handle_t, gl::size_t>              buffer_sizes_{};
+        gl::handle_t                                              pipeline_{ unknown_ };
+        gl::handle_t                                              vertex_array_{ unknown_ };
+        gl::handle_t                                              read_frame_buffer_{ unknown_ };
+        gl::handle_t                                              draw_frame_buffer_{ unknown_ };
+        gl::cache::statistics                                     statistics_{};
+    };
+
+
+
+    auto current   () -> gl::cache::context&
+    {
+        thread_local auto context = gl::cache::context{};
+        return context;
+    }
+    void invalidate()
+    {
+        gl::cache::current().invalidate();
+    }
+    auto statistics() -> gl::cache::statistics
+    {
+        return gl::cache::current().statistics();
+    }
+}
@@ -194,6 +194,7 @@ export namespace gl
         dispatch_indirect_buffer  = GL_DISPATCH_INDIRECT_BUFFER , 
         draw_indirect_buffer      = GL_DRAW_INDIRECT_BUFFER     , 
         element_array_buffer      = GL_ELEMENT_ARRAY_BUFFER     , 
+        parameter_buffer          = GL_PARAMETER_BUFFER         , 
         pixel_pack_buffer         = GL_PIXEL_PACK_BUFFER        , 
         pixel_unpack_buffer       = GL_PIXEL_UNPACK_BUFFER      , 
         query_buffer              = GL_QUERY_BUFFER             , 
@@ -1215,6 +1216,7 @@ export namespace gl
         active_uniforms                           = GL_ACTIVE_UNIFORMS                      , 
         attached_shaders                          = GL_ATTACHED_SHADERS                     , 
         binary_length                             = GL_PROGRAM_BINARY_LENGTH                , 
+        completion_status                         = GL_COMPLETION_STATUS_KHR                , //extension
         compute_work_group_size                   = GL_COMPUTE_WORK_GROUP_SIZE              , 
         delete_status                             = GL_DELETE_STATUS                        , 
         geometry_input_type                       = GL_GEOMETRY_INPUT_TYPE                  , 
@@ -1416,12 +1418,13 @@ export namespace gl
     };
     enum class shader_parameter_e : gl::enum_t
     {
-        compile_status  = GL_COMPILE_STATUS      , 
-        delete_status   = GL_DELETE_STATUS       , 
-        info_log_length = GL_INFO_LOG_LENGTH     , 
-        source_length   = GL_SHADER_SOURCE_LENGTH, 
-        spir_v_binary   = GL_SPIR_V_BINARY       , 
-        type            = GL_SHADER_TYPE         , 
+        compile_status    = GL_COMPILE_STATUS        , 
+        completion_status = GL_COMPLETION_STATUS_KHR , //extension
+        delete_status     = GL_DELETE_STATUS         , 
+        info_log_length   = GL_INFO_LOG_LENGTH       , 
+        source_length     = GL_SHADER_SOURCE_LENGTH  , 
+        spir_v_binary     = GL_SPIR_V_BINARY         , 
+        type              = GL_SHADER_TYPE           , 
     };
     enum class shader_precision_format_e : gl::enum_t
     {
@@ -1477,6 +1480,7 @@ export namespace gl
     };
     enum class synchronization_command_e : gl::bitfield_t
     {
+        none  = GL_NONE                   , 
         flush = GL_SYNC_FLUSH_COMMANDS_BIT, 
     };
     enum class synchronization_object_condition_e : gl::enum_t
@@ -1569,6 +1573,14 @@ export namespace gl
         srgba_s3tc_dxt1 = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT, 
         srgba_s3tc_dxt3 = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT, 
         srgba_s3tc_dxt5 = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT, 
+        r_rgtc1         = GL_COMPRESSED_RED_RGTC1               , 
+        r_rgtc1_n       = GL_COMPRESSED_SIGNED_RED_RGTC1        , 
+        rg_rgtc2        = GL_COMPRESSED_RG_RGTC2                , 
+        rg_rgtc2_n      = GL_COMPRESSED_SIGNED_RG_RGTC2         , 
+        rgba_bptc       = GL_COMPRESSED_RGBA_BPTC_UNORM         , 
+        srgba_bptc      = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM   , 
+        rgb_bptc_float  = GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT   , 
+        rgb_bptc_ufloat = GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT , 
     };
     enum class texture_format_e : gl::enum_t
     {
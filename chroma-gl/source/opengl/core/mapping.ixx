@@ -10,14 +10,51 @@ export namespace gl
     template<typename attribute_t>
     auto map_attribute_type                     () -> gl::vertex_array_attribute_type_e
     {
-             if constexpr (std::is_same_v<attribute_t, gl::int8_t   >) return gl::vertex_array_attribute_type_e::int8   ;
-        else if constexpr (std::is_same_v<attribute_t, gl::int16_t  >) return gl::vertex_array_attribute_type_e::int16  ;
-        else if constexpr (std::is_same_v<attribute_t, gl::int32_t  >) return gl::vertex_array_attribute_type_e::int32  ;
-        else if constexpr (std::is_same_v<attribute_t, gl::uint8_t  >) return gl::vertex_array_attribute_type_e::uint8  ;
-        else if constexpr (std::is_same_v<attribute_t, gl::uint16_t >) return gl::vertex_array_attribute_type_e::uint16 ;
-        else if constexpr (std::is_same_v<attribute_t, gl::uint32_t >) return gl::vertex_array_attribute_type_e::uint32 ;
-        else if constexpr (std::is_same_v<attribute_t, gl::float32_t>) return gl::vertex_array_attribute_type_e::float32;
-        else if constexpr (std::is_same_v<attribute_t, gl::float64_t>) return gl::vertex_array_attribute_type_e::float64;
+             if constexpr (std::is_same_v<attribute_t, gl::int8_t              >) return gl::vertex_array_attribute_type_e::int8              ;
+        else if constexpr (std::is_same_v<attribute_t, gl::int16_t             >) return gl::vertex_array_attribute_type_e::int16             ;
+        else if constexpr (std::is_same_v<attribute_t, gl::int32_t             >) return gl::vertex_array_attribute_type_e::int32             ;
+        else if constexpr (std::is_same_v<attribute_t, gl::uint8_t             >) return gl::vertex_array_attribute_type_e::uint8             ;
+        else if constexpr (std::is_same_v<attribute_t, gl::uint16_t            >) return gl::vertex_array_attribute_type_e::uint16            ;
+        else if constexpr (std::is_same_v<attribute_t, gl::uint32_t            >) return gl::vertex_array_attribute_type_e::uint32            ;
+        else if constexpr (std::is_same_v<attribute_t, gl::half_t              >) return gl::vertex_array_attribute_type_e::float16           ;
+        else if constexpr (std::is_same_v<attribute_t, gl::float32_t           >) return gl::vertex_array_attribute_type_e::float32           ;
+        else if constexpr (std::is_same_v<attribute_t, gl::float64_t           >) return gl::vertex_array_attribute_type_e::float64           ;
+        else if constexpr (std::is_same_v<attribute_t, gl::int32_2_10_10_10_r_t>) return gl::vertex_array_attribute_type_e::int32_2_10_10_10_r;
+    }
+    auto map_buffer_barrier                     (gl::buffer_target_e        buffer_target       ) -> gl::memory_barrier_e
+    {
+        switch (buffer_target)
+        {
+            case gl::buffer_target_e::array_buffer             : return gl::memory_barrier_e::vertex_attribute_array;
+            case gl::buffer_target_e::atomic_counter_buffer    : return gl::memory_barrier_e::atomic_counter        ;
+            case gl::buffer_target_e::copy_read_buffer         : 
+            case gl::buffer_target_e::copy_write_buffer        : return gl::memory_barrier_e::buffer_update         ;
+            case gl::buffer_target_e::dispatch_indirect_buffer : 
+            case gl::buffer_target_e::draw_indirect_buffer     : 
+            case gl::buffer_target_e::parameter_buffer         : return gl::memory_barrier_e::command               ;
+            case gl::buffer_target_e::element_array_buffer     : return gl::memory_barrier_e::element_array         ;
+            case gl::buffer_target_e::pixel_pack_buffer        : 
+            case gl::buffer_target_e::pixel_unpack_buffer      : return gl::memory_barrier_e::pixel_buffer          ;
+            case gl::buffer_target_e::query_buffer             : return gl::memory_barrier_e::query_buffer          ;
+            case gl::buffer_target_e::shader_storage_buffer    : return gl::memory_barrier_e::shader_storage        ;
+            case gl::buffer_target_e::texture_buffer           : return gl::memory_barrier_e::texture_fetch         ;
+            case gl::buffer_target_e::transform_feedback_buffer: return gl::memory_barrier_e::transform_feedback    ;
+            case gl::buffer_target_e::uniform_buffer           : return gl::memory_barrier_e::uniform               ;
+
+            default: throw std::invalid_argument{ "invalid buffer target" };
+        }
+    }
+    auto map_buffer_barrier                     (gl::buffer_base_target_e   buffer_base_target  ) -> gl::memory_barrier_e
+    {
+        switch (buffer_base_target)
+        {
+            case gl::buffer_base_target_e::uniform_buffer           : return gl::memory_barrier_e::uniform           ;
+            case gl::buffer_base_target_e::transform_feedback_buffer: return gl::memory_barrier_e::transform_feedback;
+            case gl::buffer_base_target_e::shader_storage_buffer    : return gl::memory_barrier_e::shader_storage    ;
+            case gl::buffer_base_target_e::atomic_counter_buffer    : return gl::memory_barrier_e::atomic_counter    ;
+
+            default: throw std::invalid_argument{ "invalid buffer base target" };
+        }
     }
     auto map_buffer_base_format_component_count (gl::buffer_base_format_e   buffer_base_format  ) -> gl::count_t
     {
@@ -392,4 +429,34 @@ export namespace gl
             default: throw std::invalid_argument{ "invalid dimensions" };
         }
     }
+    template<typename uniform_t>
+    auto constexpr map_uniform_type             () -> gl::uniform_type_e
+    {
+             if constexpr (std::is_same_v<uniform_t, gl::int32_t   >) return gl::uniform_type_e::int32      ;
+        else if constexpr (std::is_same_v<uniform_t, gl::uint32_t  >) return gl::uniform_type_e::uint32     ;
+        else if constexpr (std::is_same_v<uniform_t, gl::float32_t >) return gl::uniform_type_e::float32    ;
+        else if constexpr (std::is_same_v<uniform_t, gl::float64_t >) return gl::uniform_type_e::float64    ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_2i >) return gl::uniform_type_e::vector_2i  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_3i >) return gl::uniform_type_e::vector_3i  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_4i >) return gl::uniform_type_e::vector_4i  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_2u >) return gl::uniform_type_e::vector_2u  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_3u >) return gl::uniform_type_e::vector_3u  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_4u >) return gl::uniform_type_e::vector_4u  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_2f >) return gl::uniform_type_e::vector_2f  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_3f >) return gl::uniform_type_e::vector_3f  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_4f >) return gl::uniform_type_e::vector_4f  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_2d >) return gl::uniform_type_e::vector_2d  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_3d >) return gl::uniform_type_e::vector_3d  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::vector_4d >) return gl::uniform_type_e::vector_4d  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::matrix_2f >) return gl::uniform_type_e::matrix_2f  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::matrix_3f >) return gl::uniform_type_e::matrix_3f  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::matrix_4f >) return gl::uniform_type_e::matrix_4f  ;
+        else if constexpr (std::is_same_v<uniform_t, gl::matrix_2x3f>) return gl::uniform_type_e::matrix_2x3f;
+        else if constexpr (std::is_same_v<uniform_t, gl::matrix_2x4f>) return gl::uniform_type_e::matrix_2x4f;
+        else if constexpr (std::is_same_v<uniform_t, gl::matrix_3x2f>) return gl::uniform_type_e::matrix_3x2f;
+        else if constexpr (std::is_same_v<uniform_t, gl::matrix_3x4f>) return gl::uniform_type_e::matrix_3x4f;
+        else if constexpr (std::is_same_v<uniform_t, gl::matrix_4x2f>) return gl::uniform_type_e::matrix_4x2f;
+        else if constexpr (std::is_same_v<uniform_t, gl::matrix_4x3f>) return gl::uniform_type_e::matrix_4x3f;
+        else static_assert(gl::false_ && sizeof(uniform_t), "invalid uniform type");
+    }
 }
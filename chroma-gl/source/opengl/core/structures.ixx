@@ -56,23 +56,29 @@ export namespace gl
         gl::size_t    size;
         gl::count_t   active_uniforms;
     };
+    //Indirect commands are read by the driver as tightly packed 32-bit values
     struct draw_elements_indirect_command
     {
-        gl::count_t count          = {};
-        gl::count_t instance_count = {};
-        gl::index_t first          = {};
-        gl::index_t base_vertex    = {};
-        gl::index_t base_instance  = {};
+        gl::uint32_t count          = {};
+        gl::uint32_t instance_count = {};
+        gl::uint32_t first          = {};
+        gl::int32_t  base_vertex    = {};
+        gl::uint32_t base_instance  = {};
     };
     struct draw_arrays_indirect_command
     {
-        gl::count_t count          = {};
-        gl::count_t instance_count = {};
-        gl::index_t first          = {};
-        gl::index_t base_instance  = {};
+        gl::uint32_t count          = {};
+        gl::uint32_t instance_count = {};
+        gl::uint32_t first          = {};
+        gl::uint32_t base_instance  = {};
     };
     struct dispatch_indirect_command
     {
         gl::vector_3u groups = {};
     };
+
+
+    static_assert(sizeof(gl::draw_elements_indirect_command) == 5u * sizeof(gl::uint32_t), "draw elements indirect command must be tightly packed");
+    static_assert(sizeof(gl::draw_arrays_indirect_command  ) == 4u * sizeof(gl::uint32_t), "draw arrays indirect command must be tightly packed"  );
+    static_assert(sizeof(gl::dispatch_indirect_command     ) == 3u * sizeof(gl::uint32_t), "dispatch indirect command must be tightly packed"     );
 }
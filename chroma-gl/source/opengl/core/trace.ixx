@@ -0,0 +1,978 @@
+export module opengl:trace;
+
+import std;
+import <glad/gl.h>;
+import :types;
+
+export namespace gl::trace
+{
+    //Compile-time switch of the trace layer, define GL_TRACE (premake --trace) to enable it
+    //Without it install does nothing, glad keeps pointing at the driver and the byte counters compile away
+#ifdef GL_TRACE
+    auto constexpr is_enabled = gl::true_;
+#else
+    auto constexpr is_enabled = gl::false_;
+#endif
+
+    enum class category_e
+    {
+        command        , 
+        draw           , 
+        dispatch       , 
+        state_query    , 
+    };
+
+    struct function_statistics
+    {
+        std::string_view         name;
+        gl::trace::category_e    category;
+        gl::uint64_t             call_count;
+        std::chrono::nanoseconds time;
+    };
+    //Counters of the calls made on the calling thread, time is the CPU time spent inside the driver
+    //Sync points are counted where the library makes the CPU wait for the GPU: finish, client waits with a timeout, blocking query results,
+    //reads into client memory and maps that are neither unsynchronized nor persistent, blocked time is the part spent in glClientWaitSync
+    //Uploaded and downloaded bytes only cover transfers from and to client memory, writes through mapped pointers are not seen
+    struct statistics
+    {
+        std::vector<gl::trace::function_statistics> functions{};
+        gl::uint64_t                                call_count{};
+        gl::uint64_t                                draw_count{};
+        gl::uint64_t                                dispatch_count{};
+        gl::uint64_t                                state_query_count{};
+        gl::uint64_t                                sync_count{};
+        gl::size_t                                  uploaded_bytes{};
+        gl::size_t                                  downloaded_bytes{};
+        std::chrono::nanoseconds                    time{};
+        std::chrono::nanoseconds                    blocked_time{};
+    };
+}
+namespace gl::trace
+{
+    struct function
+    {
+        std::string_view      name;
+        gl::trace::category_e category;
+        void                (*install  )(gl::uint16_t index);
+        void                (*load_null)();
+        void                (*replay   )(std::span<gl::byte_t const> payload, gl::byte_t* scratch);
+    };
+
+    //Per thread counters of the current, the last and all completed frames, and the records of an active capture
+    //A record is the function index, the payload size and the arguments by value, advancing a frame during a capture appends a marker
+    class context
+    {
+    public:
+        struct frame
+        {
+            explicit frame(gl::count_t function_count)
+                : call_counts(function_count), times(function_count), sync_count{}, uploaded_bytes{}, downloaded_bytes{} {}
+
+            std::vector<gl::uint64_t>             call_counts;
+            std::vector<std::chrono::nanoseconds> times;
+            gl::uint64_t                          sync_count;
+            gl::size_t                            uploaded_bytes;
+            gl::size_t                            downloaded_bytes;
+        };
+
+        explicit context(gl::count_t function_count)
+            : function_count_{ function_count }, current_{ function_count }, last_{ function_count }, total_{ function_count }, records_{}, is_capturing_{ gl::false_ } {}
+
+        void record_call    (gl::uint16_t index, std::chrono::nanoseconds time)
+        {
+            ++current_.call_counts[index];
+            current_.times[index] += time;
+        }
+        void record_sync    ()
+        {
+            ++current_.sync_count;
+        }
+        void record_upload  (gl::size_t bytes)
+        {
+            current_.uploaded_bytes   += bytes;
+        }
+        void record_download(gl::size_t bytes)
+        {
+            current_.downloaded_bytes += bytes;
+        }
+        template<typename... argument_t>
+        void capture        (gl::uint16_t index, argument_t... arguments)
+        {
+            if (!is_capturing_) return;
+
+            append_(index);
+            append_(static_cast<gl::uint16_t>((gl::size_t{ 0u } + ... + sizeof(argument_t))));
+            (append_(arguments), ...);
+        }
+        void advance        ()
+        {
+            if (is_capturing_)
+            {
+                append_(frame_marker);
+                append_(gl::uint16_t{ 0u });
+            }
+
+            for (auto index = gl::size_t{ 0u }; index < function_count_; ++index)
+            {
+                total_.call_counts[index] += current_.call_counts[index];
+                total_.times      [index] += current_.times      [index];
+            }
+            total_.sync_count       += current_.sync_count;
+            total_.uploaded_bytes   += current_.uploaded_bytes;
+            total_.downloaded_bytes += current_.downloaded_bytes;
+            last_                    = std::exchange(current_, frame{ function_count_ });
+        }
+        void begin_capture  ()
+        {
+            records_.clear();
+            is_capturing_ = gl::true_;
+        }
+        auto end_capture    () -> std::vector<gl::byte_t>
+        {
+            is_capturing_ = gl::false_;
+            return std::exchange(records_, {});
+        }
+
+        auto last_frame     () const -> frame const&
+        {
+            return last_;
+        }
+        auto total          () const -> frame const&
+        {
+            return total_;
+        }
+
+        static auto constexpr frame_marker = gl::uint16_t{ 0xFFFFu };
+
+    private:
+        template<typename value_t>
+        void append_(value_t value)
+        {
+            auto const bytes = std::bit_cast<std::array<gl::byte_t, sizeof(value_t)>>(value);
+            records_.insert(records_.end(), bytes.begin(), bytes.end());
+        }
+
+        gl::count_t             function_count_;
+        frame                   current_;
+        frame                   last_;
+        frame                   total_;
+        std::vector<gl::byte_t> records_;
+        gl::bool_t              is_capturing_;
+    };
+
+    auto current       () -> gl::trace::context&;
+    auto functions     () -> std::span<gl::trace::function const>;
+
+    void count_sync    ()
+    {
+        if constexpr (gl::trace::is_enabled) gl::trace::current().record_sync    ();
+    }
+    void count_upload  (gl::size_t bytes)
+    {
+        if constexpr (gl::trace::is_enabled) gl::trace::current().record_upload  (bytes);
+    }
+    void count_download(gl::size_t bytes)
+    {
+        if constexpr (gl::trace::is_enabled) gl::trace::current().record_download(bytes);
+    }
+
+    template<typename value_t>
+    auto read    (std::span<gl::byte_t const> bytes, gl::size_t& offset) -> value_t
+    {
+        if (offset + sizeof(value_t) > bytes.size()) throw std::runtime_error{ "trace capture is truncated" };
+
+        auto value = std::array<gl::byte_t, sizeof(value_t)>{};
+        std::ranges::copy(bytes.subspan(offset, sizeof(value_t)), value.begin());
+        offset += sizeof(value_t);
+
+        return std::bit_cast<value_t>(value);
+    }
+    //Replayed pointer arguments point into this much zeroed memory, enough for the names and parameters the null backend writes
+    auto constexpr scratch_size = gl::size_t{ 1u } << 20u;
+
+    //Synchronization objects keep their recorded value and callbacks are dropped, every other non-null pointer is redirected to scratch memory
+    template<typename value_t>
+    auto read_argument(std::span<gl::byte_t const> bytes, gl::size_t& offset, gl::byte_t* scratch) -> value_t
+    {
+        auto const value = gl::trace::read<value_t>(bytes, offset);
+
+        if      constexpr (std::is_same_v<value_t, gl::sync_t>)                     return value;
+        else if constexpr (std::is_function_v<std::remove_pointer_t<value_t>>)      return nullptr;
+        else if constexpr (std::is_pointer_v<value_t>)                              return value == nullptr ? nullptr : reinterpret_cast<value_t>(scratch);
+        else                                                                        return value;
+    }
+
+    //Takes the place of the glad function pointer, calls are captured, timed and counted before being forwarded to the next function
+    template<auto* pointer_v, typename = std::remove_pointer_t<decltype(pointer_v)>>
+    struct hook;
+    template<auto* pointer_v, typename return_t, typename... argument_t>
+    struct hook<pointer_v, return_t(*)(argument_t...)>
+    {
+        using function_t = return_t(*)(argument_t...);
+
+        static auto invoke(argument_t... arguments) -> return_t
+        {
+            auto&      context    = gl::trace::current();
+            context.capture(index, arguments...);
+
+            auto const start_time = std::chrono::steady_clock::now();
+            if constexpr (std::is_void_v<return_t>)
+            {
+                next(arguments...);
+                context.record_call(index, std::chrono::steady_clock::now() - start_time);
+            }
+            else
+            {
+                auto const result = next(arguments...);
+                context.record_call(index, std::chrono::steady_clock::now() - start_time);
+
+                return result;
+            }
+        }
+        static auto null  (argument_t...) -> return_t
+        {
+            if constexpr (!std::is_void_v<return_t>) return return_t{};
+        }
+        static void replay(std::span<gl::byte_t const> payload, gl::byte_t* scratch)
+        {
+            if (payload.size() != (gl::size_t{ 0u } + ... + sizeof(argument_t))) throw std::runtime_error{ "trace record does not match the function signature" };
+
+            if constexpr (sizeof...(argument_t) == 0u) (*pointer_v)();
+            else
+            {
+                auto offset    = gl::size_t{ 0u };
+                auto arguments = std::tuple<argument_t...>{ gl::trace::read_argument<argument_t>(payload, offset, scratch)... };
+                std::apply(*pointer_v, arguments);
+            }
+        }
+
+        static inline function_t   next  = nullptr;
+        static inline gl::uint16_t index = 0u;
+    };
+
+    //Whether a call synchronizes depends on its arguments, e.g. a download into a pixel pack buffer does not, so sync points are counted by the opengl functions instead
+    constexpr auto categorize(std::string_view name) -> gl::trace::category_e
+    {
+        if (name.starts_with("glDraw") || name.starts_with("glMultiDraw"))                            return gl::trace::category_e::draw;
+        if (name.starts_with("glDispatch"))                                                           return gl::trace::category_e::dispatch;
+        if (name.starts_with("glGet") || name.starts_with("glIs") || name.starts_with("glCheck"))    return gl::trace::category_e::state_query;
+
+        return gl::trace::category_e::command;
+    }
+    template<auto* pointer_v, auto null_v = &gl::trace::hook<pointer_v>::null>
+    auto make_function(std::string_view name) -> gl::trace::function
+    {
+        using hook_t = gl::trace::hook<pointer_v>;
+
+        return gl::trace::function
+        {
+            .name      = name, 
+            .category  = gl::trace::categorize(name), 
+            .install   = [](gl::uint16_t index)
+                {
+                    hook_t::index = index;
+                    if (*pointer_v == nullptr || *pointer_v == &hook_t::invoke) return;
+
+                    hook_t::next = *pointer_v;
+                    *pointer_v   = &hook_t::invoke;
+                }, 
+            .load_null = []()
+                {
+                    if (*pointer_v == &hook_t::invoke) hook_t::next = null_v;
+                    else                               *pointer_v   = null_v;
+                }, 
+            .replay    = &hook_t::replay, 
+        };
+    }
+}
+namespace gl::trace::null
+{
+    //Object state the null backend keeps so that the validation of the opengl functions passes
+    //Names are handed out in increasing order, buffers own memory to map and textures remember their base extent
+    //Loaded stays set until the process ends, reloading glad afterwards is not detected
+    struct backend
+    {
+        gl::bool_t                                          is_loaded{ gl::false_ };
+        GLuint                                              next_name{};
+        std::unordered_map<GLuint, std::vector<gl::byte_t>> buffers{};
+        std::unordered_map<GLuint, std::array<GLsizei, 3u>> textures{};
+    };
+
+    auto current_backend               () -> gl::trace::null::backend&
+    {
+        static auto backend = gl::trace::null::backend{};
+        return backend;
+    }
+
+    void create_objects                (GLsizei count, GLuint* names)
+    {
+        for (auto index = GLsizei{ 0 }; index < count; ++index) names[index] = ++gl::trace::null::current_backend().next_name;
+    }
+    void create_target_objects         (GLenum, GLsizei count, GLuint* names)
+    {
+        gl::trace::null::create_objects(count, names);
+    }
+    auto create_program                () -> GLuint
+    {
+        return ++gl::trace::null::current_backend().next_name;
+    }
+    auto create_shader                 (GLenum) -> GLuint
+    {
+        return ++gl::trace::null::current_backend().next_name;
+    }
+    auto create_shader_program         (GLenum, GLsizei, GLchar const* const*) -> GLuint
+    {
+        return ++gl::trace::null::current_backend().next_name;
+    }
+    void delete_buffers                (GLsizei count, GLuint const* names)
+    {
+        for (auto index = GLsizei{ 0 }; index < count; ++index) gl::trace::null::current_backend().buffers .erase(names[index]);
+    }
+    void delete_textures               (GLsizei count, GLuint const* names)
+    {
+        for (auto index = GLsizei{ 0 }; index < count; ++index) gl::trace::null::current_backend().textures.erase(names[index]);
+    }
+
+    auto fence_sync                    (GLenum, GLbitfield) -> GLsync
+    {
+        return reinterpret_cast<GLsync>(static_cast<std::uintptr_t>(++gl::trace::null::current_backend().next_name));
+    }
+    auto client_wait_sync              (GLsync, GLbitfield, GLuint64) -> GLenum
+    {
+        return GL_ALREADY_SIGNALED;
+    }
+    void get_sync                      (GLsync, GLenum parameter, GLsizei count, GLsizei* length, GLint* values)
+    {
+        if (length != nullptr) *length = GLsizei{ 1 };
+        if (values != nullptr && count > 0) *values = parameter == GL_SYNC_STATUS ? GLint{ GL_SIGNALED } : GLint{ 0 };
+    }
+    auto check_frame_buffer_status     (GLuint, GLenum) -> GLenum
+    {
+        return GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    auto get_string                    (GLenum name) -> GLubyte const*
+    {
+        switch (name)
+        {
+            case GL_VERSION                 : return reinterpret_cast<GLubyte const*>("4.6.0 null");
+            case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<GLubyte const*>("4.60"      );
+            default                         : return reinterpret_cast<GLubyte const*>("null"      );
+        }
+    }
+    auto get_string_index              (GLenum, GLuint) -> GLubyte const*
+    {
+        return reinterpret_cast<GLubyte const*>("");
+    }
+    //Implementation limits the opengl functions divide by or compare against, everything else reads as zero
+    template<typename value_t>
+    void get_integer                   (GLenum parameter, value_t* values)
+    {
+        if (values == nullptr) return;
+
+        switch (parameter)
+        {
+            case GL_MAJOR_VERSION                         : *values = value_t{     4 }; break;
+            case GL_MINOR_VERSION                         : *values = value_t{     6 }; break;
+            case GL_MAX_COLOR_ATTACHMENTS                 : 
+            case GL_MAX_DRAW_BUFFERS                      : *values = value_t{     8 }; break;
+            case GL_MAX_DEBUG_MESSAGE_LENGTH              : *values = value_t{  1024 }; break;
+            case GL_MAX_LABEL_LENGTH                      : *values = value_t{   256 }; break;
+            case GL_MAX_TEXTURE_SIZE                      : *values = value_t{ 16384 }; break;
+            case GL_MAX_ARRAY_TEXTURE_LAYERS              : *values = value_t{  2048 }; break;
+            case GL_MIN_MAP_BUFFER_ALIGNMENT              : *values = value_t{    64 }; break;
+            case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT       : 
+            case GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT: 
+            case GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT       : *values = value_t{   256 }; break;
+            case GL_PACK_ALIGNMENT                        : 
+            case GL_UNPACK_ALIGNMENT                      : *values = value_t{     4 }; break;
+            default                                       : *values = value_t{     0 }; break;
+        }
+    }
+    //Compilation, linking, validation and query results always report success
+    template<typename value_t>
+    void get_status                    (GLuint, GLenum parameter, value_t* values)
+    {
+        if (values == nullptr) return;
+
+        switch (parameter)
+        {
+            case GL_COMPILE_STATUS          : 
+            case GL_LINK_STATUS             : 
+            case GL_VALIDATE_STATUS         : 
+            case GL_COMPLETION_STATUS_KHR   : 
+            case GL_QUERY_RESULT_AVAILABLE  : *values = value_t{ 1 }; break;
+            default                         : *values = value_t{ 0 }; break;
+        }
+    }
+
+    void buffer_storage                (GLuint buffer, GLsizeiptr size, void const*, GLbitfield)
+    {
+        gl::trace::null::current_backend().buffers.insert_or_assign(buffer, std::vector<gl::byte_t>(static_cast<gl::size_t>(size)));
+    }
+    template<typename value_t>
+    void get_buffer_parameter          (GLuint buffer, GLenum parameter, value_t* values)
+    {
+        if (values == nullptr) return;
+
+        auto const& buffers  = gl::trace::null::current_backend().buffers;
+        auto const  iterator = buffers.find(buffer);
+        *values = parameter == GL_BUFFER_SIZE && iterator != buffers.end() ? static_cast<value_t>(iterator->second.size()) : value_t{ 0 };
+    }
+    auto map_buffer_range              (GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield) -> void*
+    {
+        auto& memory = gl::trace::null::current_backend().buffers[buffer];
+        if (memory.size() < static_cast<gl::size_t>(offset + length)) memory.resize(static_cast<gl::size_t>(offset + length));
+
+        return memory.data() + offset;
+    }
+    auto unmap_buffer                  (GLuint) -> GLboolean
+    {
+        return GL_TRUE;
+    }
+
+    void texture_storage_1d            (GLuint texture, GLsizei, GLenum, GLsizei width)
+    {
+        gl::trace::null::current_backend().textures.insert_or_assign(texture, std::array<GLsizei, 3u>{ width, 1, 1 });
+    }
+    void texture_storage_2d            (GLuint texture, GLsizei, GLenum, GLsizei width, GLsizei height)
+    {
+        gl::trace::null::current_backend().textures.insert_or_assign(texture, std::array<GLsizei, 3u>{ width, height, 1 });
+    }
+    void texture_storage_3d            (GLuint texture, GLsizei, GLenum, GLsizei width, GLsizei height, GLsizei depth)
+    {
+        gl::trace::null::current_backend().textures.insert_or_assign(texture, std::array<GLsizei, 3u>{ width, height, depth });
+    }
+    void texture_storage_2d_multisample(GLuint texture, GLsizei, GLenum, GLsizei width, GLsizei height, GLboolean)
+    {
+        gl::trace::null::current_backend().textures.insert_or_assign(texture, std::array<GLsizei, 3u>{ width, height, 1 });
+    }
+    void texture_storage_3d_multisample(GLuint texture, GLsizei, GLenum, GLsizei width, GLsizei height, GLsizei depth, GLboolean)
+    {
+        gl::trace::null::current_backend().textures.insert_or_assign(texture, std::array<GLsizei, 3u>{ width, height, depth });
+    }
+    //The depth is not reduced per level since it holds the layer count of array textures
+    void get_texture_level_parameter   (GLuint texture, GLint level, GLenum parameter, GLint* values)
+    {
+        if (values == nullptr) return;
+
+        auto const& textures = gl::trace::null::current_backend().textures;
+        auto const  iterator = textures.find(texture);
+        auto const  extent   = iterator != textures.end() ? iterator->second : std::array<GLsizei, 3u>{};
+        switch (parameter)
+        {
+            case GL_TEXTURE_WIDTH : *values = std::max(extent[0] >> level, std::min(extent[0], GLsizei{ 1 })); break;
+            case GL_TEXTURE_HEIGHT: *values = std::max(extent[1] >> level, std::min(extent[1], GLsizei{ 1 })); break;
+            case GL_TEXTURE_DEPTH : *values = extent[2];                                                          break;
+            default               : *values = GLint{ 0 };                                                         break;
+        }
+    }
+}
+namespace gl::trace
+{
+    //Every function the opengl module calls, the position in the table is the index used by the counters and captures
+    auto functions() -> std::span<gl::trace::function const>
+    {
+        static auto const functions = std::to_array<gl::trace::function>(
+        {
+            gl::trace::make_function<&::glActiveShaderProgram                                                                          >("glActiveShaderProgram"                        ),
+            gl::trace::make_function<&::glAttachShader                                                                                 >("glAttachShader"                               ),
+            gl::trace::make_function<&::glBeginConditionalRender                                                                       >("glBeginConditionalRender"                     ),
+            gl::trace::make_function<&::glBeginQuery                                                                                   >("glBeginQuery"                                 ),
+            gl::trace::make_function<&::glBeginQueryIndexed                                                                            >("glBeginQueryIndexed"                          ),
+            gl::trace::make_function<&::glBindBuffer                                                                                   >("glBindBuffer"                                 ),
+            gl::trace::make_function<&::glBindBufferBase                                                                               >("glBindBufferBase"                             ),
+            gl::trace::make_function<&::glBindBufferRange                                                                              >("glBindBufferRange"                            ),
+            gl::trace::make_function<&::glBindBuffersBase                                                                              >("glBindBuffersBase"                            ),
+            gl::trace::make_function<&::glBindBuffersRange                                                                             >("glBindBuffersRange"                           ),
+            gl::trace::make_function<&::glBindFramebuffer                                                                              >("glBindFramebuffer"                            ),
+            gl::trace::make_function<&::glBindImageTexture                                                                             >("glBindImageTexture"                           ),
+            gl::trace::make_function<&::glBindImageTextures                                                                            >("glBindImageTextures"                          ),
+            gl::trace::make_function<&::glBindProgramPipeline                                                                          >("glBindProgramPipeline"                        ),
+            gl::trace::make_function<&::glBindSampler                                                                                  >("glBindSampler"                                ),
+            gl::trace::make_function<&::glBindSamplers                                                                                 >("glBindSamplers"                               ),
+            gl::trace::make_function<&::glBindTextureUnit                                                                              >("glBindTextureUnit"                            ),
+            gl::trace::make_function<&::glBindVertexArray                                                                              >("glBindVertexArray"                            ),
+            gl::trace::make_function<&::glBlendColor                                                                                   >("glBlendColor"                                 ),
+            gl::trace::make_function<&::glBlendEquation                                                                                >("glBlendEquation"                              ),
+            gl::trace::make_function<&::glBlendEquationSeparate                                                                        >("glBlendEquationSeparate"                      ),
+            gl::trace::make_function<&::glBlendEquationSeparatei                                                                       >("glBlendEquationSeparatei"                     ),
+            gl::trace::make_function<&::glBlendEquationi                                                                               >("glBlendEquationi"                             ),
+            gl::trace::make_function<&::glBlendFunc                                                                                    >("glBlendFunc"                                  ),
+            gl::trace::make_function<&::glBlendFuncSeparate                                                                            >("glBlendFuncSeparate"                          ),
+            gl::trace::make_function<&::glBlendFuncSeparatei                                                                           >("glBlendFuncSeparatei"                         ),
+            gl::trace::make_function<&::glBlitNamedFramebuffer                                                                         >("glBlitNamedFramebuffer"                       ),
+            gl::trace::make_function<&::glCheckNamedFramebufferStatus                , &gl::trace::null::check_frame_buffer_status     >("glCheckNamedFramebufferStatus"                ),
+            gl::trace::make_function<&::glClampColor                                                                                   >("glClampColor"                                 ),
+            gl::trace::make_function<&::glClear                                                                                        >("glClear"                                      ),
+            gl::trace::make_function<&::glClearColor                                                                                   >("glClearColor"                                 ),
+            gl::trace::make_function<&::glClearDepthf                                                                                  >("glClearDepthf"                                ),
+            gl::trace::make_function<&::glClearNamedBufferData                                                                         >("glClearNamedBufferData"                       ),
+            gl::trace::make_function<&::glClearNamedBufferSubData                                                                      >("glClearNamedBufferSubData"                    ),
+            gl::trace::make_function<&::glClearNamedFramebufferfi                                                                      >("glClearNamedFramebufferfi"                    ),
+            gl::trace::make_function<&::glClearNamedFramebufferfv                                                                      >("glClearNamedFramebufferfv"                    ),
+            gl::trace::make_function<&::glClearNamedFramebufferiv                                                                      >("glClearNamedFramebufferiv"                    ),
+            gl::trace::make_function<&::glClearNamedFramebufferuiv                                                                     >("glClearNamedFramebufferuiv"                   ),
+            gl::trace::make_function<&::glClearStencil                                                                                 >("glClearStencil"                               ),
+            gl::trace::make_function<&::glClearTexImage                                                                                >("glClearTexImage"                              ),
+            gl::trace::make_function<&::glClearTexSubImage                                                                             >("glClearTexSubImage"                           ),
+            gl::trace::make_function<&::glClientWaitSync                             , &gl::trace::null::client_wait_sync              >("glClientWaitSync"                             ),
+            gl::trace::make_function<&::glClipControl                                                                                  >("glClipControl"                                ),
+            gl::trace::make_function<&::glColorMask                                                                                    >("glColorMask"                                  ),
+            gl::trace::make_function<&::glColorMaski                                                                                   >("glColorMaski"                                 ),
+            gl::trace::make_function<&::glCompileShader                                                                                >("glCompileShader"                              ),
+            gl::trace::make_function<&::glCompressedTextureSubImage1D                                                                  >("glCompressedTextureSubImage1D"                ),
+            gl::trace::make_function<&::glCompressedTextureSubImage2D                                                                  >("glCompressedTextureSubImage2D"                ),
+            gl::trace::make_function<&::glCompressedTextureSubImage3D                                                                  >("glCompressedTextureSubImage3D"                ),
+            gl::trace::make_function<&::glCopyImageSubData                                                                             >("glCopyImageSubData"                           ),
+            gl::trace::make_function<&::glCopyNamedBufferSubData                                                                       >("glCopyNamedBufferSubData"                     ),
+            gl::trace::make_function<&::glCopyTextureSubImage1D                                                                        >("glCopyTextureSubImage1D"                      ),
+            gl::trace::make_function<&::glCopyTextureSubImage2D                                                                        >("glCopyTextureSubImage2D"                      ),
+            gl::trace::make_function<&::glCopyTextureSubImage3D                                                                        >("glCopyTextureSubImage3D"                      ),
+            gl::trace::make_function<&::glCreateBuffers                              , &gl::trace::null::create_objects                >("glCreateBuffers"                              ),
+            gl::trace::make_function<&::glCreateFramebuffers                         , &gl::trace::null::create_objects                >("glCreateFramebuffers"                         ),
+            gl::trace::make_function<&::glCreateProgram                              , &gl::trace::null::create_program                >("glCreateProgram"                              ),
+            gl::trace::make_function<&::glCreateProgramPipelines                     , &gl::trace::null::create_objects                >("glCreateProgramPipelines"                     ),
+            gl::trace::make_function<&::glCreateQueries                              , &gl::trace::null::create_target_objects         >("glCreateQueries"                              ),
+            gl::trace::make_function<&::glCreateRenderbuffers                        , &gl::trace::null::create_objects                >("glCreateRenderbuffers"                        ),
+            gl::trace::make_function<&::glCreateSamplers                             , &gl::trace::null::create_objects                >("glCreateSamplers"                             ),
+            gl::trace::make_function<&::glCreateShader                               , &gl::trace::null::create_shader                 >("glCreateShader"                               ),
+            gl::trace::make_function<&::glCreateShaderProgramv                       , &gl::trace::null::create_shader_program         >("glCreateShaderProgramv"                       ),
+            gl::trace::make_function<&::glCreateTextures                             , &gl::trace::null::create_target_objects         >("glCreateTextures"                             ),
+            gl::trace::make_function<&::glCreateVertexArrays                         , &gl::trace::null::create_objects                >("glCreateVertexArrays"                         ),
+            gl::trace::make_function<&::glCullFace                                                                                     >("glCullFace"                                   ),
+            gl::trace::make_function<&::glDebugMessageCallback                                                                         >("glDebugMessageCallback"                       ),
+            gl::trace::make_function<&::glDebugMessageControl                                                                          >("glDebugMessageControl"                        ),
+            gl::trace::make_function<&::glDebugMessageInsert                                                                           >("glDebugMessageInsert"                         ),
+            gl::trace::make_function<&::glDeleteBuffers                              , &gl::trace::null::delete_buffers                >("glDeleteBuffers"                              ),
+            gl::trace::make_function<&::glDeleteFramebuffers                                                                           >("glDeleteFramebuffers"                         ),
+            gl::trace::make_function<&::glDeleteProgram                                                                                >("glDeleteProgram"                              ),
+            gl::trace::make_function<&::glDeleteProgramPipelines                                                                       >("glDeleteProgramPipelines"                     ),
+            gl::trace::make_function<&::glDeleteQueries                                                                                >("glDeleteQueries"                              ),
+            gl::trace::make_function<&::glDeleteRenderbuffers                                                                          >("glDeleteRenderbuffers"                        ),
+            gl::trace::make_function<&::glDeleteSamplers                                                                               >("glDeleteSamplers"                             ),
+            gl::trace::make_function<&::glDeleteShader                                                                                 >("glDeleteShader"                               ),
+            gl::trace::make_function<&::glDeleteSync                                                                                   >("glDeleteSync"                                 ),
+            gl::trace::make_function<&::glDeleteTextures                             , &gl::trace::null::delete_textures               >("glDeleteTextures"                             ),
+            gl::trace::make_function<&::glDeleteVertexArrays                                                                           >("glDeleteVertexArrays"                         ),
+            gl::trace::make_function<&::glDepthFunc                                                                                    >("glDepthFunc"                                  ),
+            gl::trace::make_function<&::glDepthMask                                                                                    >("glDepthMask"                                  ),
+            gl::trace::make_function<&::glDepthRangeArrayv                                                                             >("glDepthRangeArrayv"                           ),
+            gl::trace::make_function<&::glDepthRangeIndexed                                                                            >("glDepthRangeIndexed"                          ),
+            gl::trace::make_function<&::glDepthRangef                                                                                  >("glDepthRangef"                                ),
+            gl::trace::make_function<&::glDetachShader                                                                                 >("glDetachShader"                               ),
+            gl::trace::make_function<&::glDisable                                                                                      >("glDisable"                                    ),
+            gl::trace::make_function<&::glDisableVertexArrayAttrib                                                                     >("glDisableVertexArrayAttrib"                   ),
+            gl::trace::make_function<&::glDisablei                                                                                     >("glDisablei"                                   ),
+            gl::trace::make_function<&::glDispatchCompute                                                                              >("glDispatchCompute"                            ),
+            gl::trace::make_function<&::glDispatchComputeIndirect                                                                      >("glDispatchComputeIndirect"                    ),
+            gl::trace::make_function<&::glDrawArrays                                                                                   >("glDrawArrays"                                 ),
+            gl::trace::make_function<&::glDrawArraysIndirect                                                                           >("glDrawArraysIndirect"                         ),
+            gl::trace::make_function<&::glDrawArraysInstanced                                                                          >("glDrawArraysInstanced"                        ),
+            gl::trace::make_function<&::glDrawArraysInstancedBaseInstance                                                              >("glDrawArraysInstancedBaseInstance"            ),
+            gl::trace::make_function<&::glDrawElements                                                                                 >("glDrawElements"                               ),
+            gl::trace::make_function<&::glDrawElementsBaseVertex                                                                       >("glDrawElementsBaseVertex"                     ),
+            gl::trace::make_function<&::glDrawElementsIndirect                                                                         >("glDrawElementsIndirect"                       ),
+            gl::trace::make_function<&::glDrawElementsInstanced                                                                        >("glDrawElementsInstanced"                      ),
+            gl::trace::make_function<&::glDrawElementsInstancedBaseInstance                                                            >("glDrawElementsInstancedBaseInstance"          ),
+            gl::trace::make_function<&::glDrawElementsInstancedBaseVertex                                                              >("glDrawElementsInstancedBaseVertex"            ),
+            gl::trace::make_function<&::glDrawElementsInstancedBaseVertexBaseInstance                                                  >("glDrawElementsInstancedBaseVertexBaseInstance"),
+            gl::trace::make_function<&::glDrawRangeElements                                                                            >("glDrawRangeElements"                          ),
+            gl::trace::make_function<&::glDrawRangeElementsBaseVertex                                                                  >("glDrawRangeElementsBaseVertex"                ),
+            gl::trace::make_function<&::glEnable                                                                                       >("glEnable"                                     ),
+            gl::trace::make_function<&::glEnableVertexArrayAttrib                                                                      >("glEnableVertexArrayAttrib"                    ),
+            gl::trace::make_function<&::glEnablei                                                                                      >("glEnablei"                                    ),
+            gl::trace::make_function<&::glEndConditionalRender                                                                         >("glEndConditionalRender"                       ),
+            gl::trace::make_function<&::glEndQuery                                                                                     >("glEndQuery"                                   ),
+            gl::trace::make_function<&::glEndQueryIndexed                                                                              >("glEndQueryIndexed"                            ),
+            gl::trace::make_function<&::glFenceSync                                  , &gl::trace::null::fence_sync                    >("glFenceSync"                                  ),
+            gl::trace::make_function<&::glFinish                                                                                       >("glFinish"                                     ),
+            gl::trace::make_function<&::glFlush                                                                                        >("glFlush"                                      ),
+            gl::trace::make_function<&::glFlushMappedNamedBufferRange                                                                  >("glFlushMappedNamedBufferRange"                ),
+            gl::trace::make_function<&::glFrontFace                                                                                    >("glFrontFace"                                  ),
+            gl::trace::make_function<&::glGenerateTextureMipmap                                                                        >("glGenerateTextureMipmap"                      ),
+            gl::trace::make_function<&::glGetAttachedShaders                                                                           >("glGetAttachedShaders"                         ),
+            gl::trace::make_function<&::glGetBooleani_v                                                                                >("glGetBooleani_v"                              ),
+            gl::trace::make_function<&::glGetBooleanv                                                                                  >("glGetBooleanv"                                ),
+            gl::trace::make_function<&::glGetCompressedTextureImage                                                                    >("glGetCompressedTextureImage"                  ),
+            gl::trace::make_function<&::glGetCompressedTextureSubImage                                                                 >("glGetCompressedTextureSubImage"               ),
+            gl::trace::make_function<&::glGetDebugMessageLog                                                                           >("glGetDebugMessageLog"                         ),
+            gl::trace::make_function<&::glGetDoublei_v                                                                                 >("glGetDoublei_v"                               ),
+            gl::trace::make_function<&::glGetDoublev                                                                                   >("glGetDoublev"                                 ),
+            gl::trace::make_function<&::glGetError                                                                                     >("glGetError"                                   ),
+            gl::trace::make_function<&::glGetFloati_v                                                                                  >("glGetFloati_v"                                ),
+            gl::trace::make_function<&::glGetFloatv                                                                                    >("glGetFloatv"                                  ),
+            gl::trace::make_function<&::glGetGraphicsResetStatus                                                                       >("glGetGraphicsResetStatus"                     ),
+            gl::trace::make_function<&::glGetInteger64i_v                                                                              >("glGetInteger64i_v"                            ),
+            gl::trace::make_function<&::glGetInteger64v                              , &gl::trace::null::get_integer<GLint64>          >("glGetInteger64v"                              ),
+            gl::trace::make_function<&::glGetIntegeri_v                                                                                >("glGetIntegeri_v"                              ),
+            gl::trace::make_function<&::glGetIntegerv                                , &gl::trace::null::get_integer<GLint>            >("glGetIntegerv"                                ),
+            gl::trace::make_function<&::glGetInternalformati64v                                                                        >("glGetInternalformati64v"                      ),
+            gl::trace::make_function<&::glGetInternalformativ                                                                          >("glGetInternalformativ"                        ),
+            gl::trace::make_function<&::glGetMultisamplefv                                                                             >("glGetMultisamplefv"                           ),
+            gl::trace::make_function<&::glGetNamedBufferParameteri64v                , &gl::trace::null::get_buffer_parameter<GLint64> >("glGetNamedBufferParameteri64v"                ),
+            gl::trace::make_function<&::glGetNamedBufferParameteriv                  , &gl::trace::null::get_buffer_parameter<GLint>   >("glGetNamedBufferParameteriv"                  ),
+            gl::trace::make_function<&::glGetNamedBufferSubData                                                                        >("glGetNamedBufferSubData"                      ),
+            gl::trace::make_function<&::glGetNamedFramebufferAttachmentParameteriv                                                     >("glGetNamedFramebufferAttachmentParameteriv"   ),
+            gl::trace::make_function<&::glGetNamedFramebufferParameteriv                                                               >("glGetNamedFramebufferParameteriv"             ),
+            gl::trace::make_function<&::glGetNamedRenderbufferParameteriv                                                              >("glGetNamedRenderbufferParameteriv"            ),
+            gl::trace::make_function<&::glGetPointerv                                                                                  >("glGetPointerv"                                ),
+            gl::trace::make_function<&::glGetProgramBinary                                                                             >("glGetProgramBinary"                           ),
+            gl::trace::make_function<&::glGetProgramInfoLog                                                                            >("glGetProgramInfoLog"                          ),
+            gl::trace::make_function<&::glGetProgramInterfaceiv                                                                        >("glGetProgramInterfaceiv"                      ),
+            gl::trace::make_function<&::glGetProgramPipelineInfoLog                                                                    >("glGetProgramPipelineInfoLog"                  ),
+            gl::trace::make_function<&::glGetProgramPipelineiv                       , &gl::trace::null::get_status<GLint>             >("glGetProgramPipelineiv"                       ),
+            gl::trace::make_function<&::glGetProgramResourceIndex                                                                      >("glGetProgramResourceIndex"                    ),
+            gl::trace::make_function<&::glGetProgramResourceLocation                                                                   >("glGetProgramResourceLocation"                 ),
+            gl::trace::make_function<&::glGetProgramResourceLocationIndex                                                              >("glGetProgramResourceLocationIndex"            ),
+            gl::trace::make_function<&::glGetProgramResourceName                                                                       >("glGetProgramResourceName"                     ),
+            gl::trace::make_function<&::glGetProgramResourceiv                                                                         >("glGetProgramResourceiv"                       ),
+            gl::trace::make_function<&::glGetProgramiv                               , &gl::trace::null::get_status<GLint>             >("glGetProgramiv"                               ),
+            gl::trace::make_function<&::glGetQueryBufferObjectiv                                                                       >("glGetQueryBufferObjectiv"                     ),
+            gl::trace::make_function<&::glGetQueryBufferObjectuiv                                                                      >("glGetQueryBufferObjectuiv"                    ),
+            gl::trace::make_function<&::glGetQueryIndexediv                                                                            >("glGetQueryIndexediv"                          ),
+            gl::trace::make_function<&::glGetQueryObjectiv                           , &gl::trace::null::get_status<GLint>             >("glGetQueryObjectiv"                           ),
+            gl::trace::make_function<&::glGetQueryObjectui64v                        , &gl::trace::null::get_status<GLuint64>          >("glGetQueryObjectui64v"                        ),
+            gl::trace::make_function<&::glGetQueryObjectuiv                          , &gl::trace::null::get_status<GLuint>            >("glGetQueryObjectuiv"                          ),
+            gl::trace::make_function<&::glGetQueryiv                                                                                   >("glGetQueryiv"                                 ),
+            gl::trace::make_function<&::glGetSamplerParameterIuiv                                                                      >("glGetSamplerParameterIuiv"                    ),
+            gl::trace::make_function<&::glGetSamplerParameterfv                                                                        >("glGetSamplerParameterfv"                      ),
+            gl::trace::make_function<&::glGetSamplerParameteriv                                                                        >("glGetSamplerParameteriv"                      ),
+            gl::trace::make_function<&::glGetShaderInfoLog                                                                             >("glGetShaderInfoLog"                           ),
+            gl::trace::make_function<&::glGetShaderPrecisionFormat                                                                     >("glGetShaderPrecisionFormat"                   ),
+            gl::trace::make_function<&::glGetShaderSource                                                                              >("glGetShaderSource"                            ),
+            gl::trace::make_function<&::glGetShaderiv                                , &gl::trace::null::get_status<GLint>             >("glGetShaderiv"                                ),
+            gl::trace::make_function<&::glGetString                                  , &gl::trace::null::get_string                    >("glGetString"                                  ),
+            gl::trace::make_function<&::glGetStringi                                 , &gl::trace::null::get_string_index              >("glGetStringi"                                 ),
+            gl::trace::make_function<&::glGetSynciv                                  , &gl::trace::null::get_sync                      >("glGetSynciv"                                  ),
+            gl::trace::make_function<&::glGetTextureImage                                                                              >("glGetTextureImage"                            ),
+            gl::trace::make_function<&::glGetTextureLevelParameteriv                 , &gl::trace::null::get_texture_level_parameter   >("glGetTextureLevelParameteriv"                 ),
+            gl::trace::make_function<&::glGetTextureParameterfv                                                                        >("glGetTextureParameterfv"                      ),
+            gl::trace::make_function<&::glGetTextureParameteriv                                                                        >("glGetTextureParameteriv"                      ),
+            gl::trace::make_function<&::glGetTextureSubImage                                                                           >("glGetTextureSubImage"                         ),
+            gl::trace::make_function<&::glGetVertexArrayIndexed64iv                                                                    >("glGetVertexArrayIndexed64iv"                  ),
+            gl::trace::make_function<&::glGetVertexArrayIndexediv                                                                      >("glGetVertexArrayIndexediv"                    ),
+            gl::trace::make_function<&::glGetVertexArrayiv                                                                             >("glGetVertexArrayiv"                           ),
+            gl::trace::make_function<&::glHint                                                                                         >("glHint"                                       ),
+            gl::trace::make_function<&::glInvalidateBufferData                                                                         >("glInvalidateBufferData"                       ),
+            gl::trace::make_function<&::glInvalidateBufferSubData                                                                      >("glInvalidateBufferSubData"                    ),
+            gl::trace::make_function<&::glInvalidateNamedFramebufferData                                                               >("glInvalidateNamedFramebufferData"             ),
+            gl::trace::make_function<&::glInvalidateNamedFramebufferSubData                                                            >("glInvalidateNamedFramebufferSubData"          ),
+            gl::trace::make_function<&::glInvalidateTexImage                                                                           >("glInvalidateTexImage"                         ),
+            gl::trace::make_function<&::glInvalidateTexSubImage                                                                        >("glInvalidateTexSubImage"                      ),
+            gl::trace::make_function<&::glIsBuffer                                                                                     >("glIsBuffer"                                   ),
+            gl::trace::make_function<&::glIsEnabled                                                                                    >("glIsEnabled"                                  ),
+            gl::trace::make_function<&::glIsEnabledi                                                                                   >("glIsEnabledi"                                 ),
+            gl::trace::make_function<&::glIsFramebuffer                                                                                >("glIsFramebuffer"                              ),
+            gl::trace::make_function<&::glIsProgram                                                                                    >("glIsProgram"                                  ),
+            gl::trace::make_function<&::glIsProgramPipeline                                                                            >("glIsProgramPipeline"                          ),
+            gl::trace::make_function<&::glIsQuery                                                                                      >("glIsQuery"                                    ),
+            gl::trace::make_function<&::glIsRenderbuffer                                                                               >("glIsRenderbuffer"                             ),
+            gl::trace::make_function<&::glIsSampler                                                                                    >("glIsSampler"                                  ),
+            gl::trace::make_function<&::glIsShader                                                                                     >("glIsShader"                                   ),
+            gl::trace::make_function<&::glIsSync                                                                                       >("glIsSync"                                     ),
+            gl::trace::make_function<&::glIsTexture                                                                                    >("glIsTexture"                                  ),
+            gl::trace::make_function<&::glIsTransformFeedback                                                                          >("glIsTransformFeedback"                        ),
+            gl::trace::make_function<&::glIsVertexArray                                                                                >("glIsVertexArray"                              ),
+            gl::trace::make_function<&::glLineWidth                                                                                    >("glLineWidth"                                  ),
+            gl::trace::make_function<&::glLinkProgram                                                                                  >("glLinkProgram"                                ),
+            gl::trace::make_function<&::glLogicOp                                                                                      >("glLogicOp"                                    ),
+            gl::trace::make_function<&::glMapNamedBufferRange                        , &gl::trace::null::map_buffer_range              >("glMapNamedBufferRange"                        ),
+            gl::trace::make_function<&::glMaxShaderCompilerThreadsKHR                                                                  >("glMaxShaderCompilerThreadsKHR"                ),
+            gl::trace::make_function<&::glMemoryBarrier                                                                                >("glMemoryBarrier"                              ),
+            gl::trace::make_function<&::glMemoryBarrierByRegion                                                                        >("glMemoryBarrierByRegion"                      ),
+            gl::trace::make_function<&::glMinSampleShading                                                                             >("glMinSampleShading"                           ),
+            gl::trace::make_function<&::glMultiDrawArrays                                                                              >("glMultiDrawArrays"                            ),
+            gl::trace::make_function<&::glMultiDrawArraysIndirect                                                                      >("glMultiDrawArraysIndirect"                    ),
+            gl::trace::make_function<&::glMultiDrawArraysIndirectCount                                                                 >("glMultiDrawArraysIndirectCount"               ),
+            gl::trace::make_function<&::glMultiDrawElements                                                                            >("glMultiDrawElements"                          ),
+            gl::trace::make_function<&::glMultiDrawElementsBaseVertex                                                                  >("glMultiDrawElementsBaseVertex"                ),
+            gl::trace::make_function<&::glMultiDrawElementsIndirect                                                                    >("glMultiDrawElementsIndirect"                  ),
+            gl::trace::make_function<&::glMultiDrawElementsIndirectCount                                                               >("glMultiDrawElementsIndirectCount"             ),
+            gl::trace::make_function<&::glNamedBufferStorage                         , &gl::trace::null::buffer_storage                >("glNamedBufferStorage"                         ),
+            gl::trace::make_function<&::glNamedBufferSubData                                                                           >("glNamedBufferSubData"                         ),
+            gl::trace::make_function<&::glNamedFramebufferDrawBuffer                                                                   >("glNamedFramebufferDrawBuffer"                 ),
+            gl::trace::make_function<&::glNamedFramebufferDrawBuffers                                                                  >("glNamedFramebufferDrawBuffers"                ),
+            gl::trace::make_function<&::glNamedFramebufferParameteri                                                                   >("glNamedFramebufferParameteri"                 ),
+            gl::trace::make_function<&::glNamedFramebufferReadBuffer                                                                   >("glNamedFramebufferReadBuffer"                 ),
+            gl::trace::make_function<&::glNamedFramebufferRenderbuffer                                                                 >("glNamedFramebufferRenderbuffer"               ),
+            gl::trace::make_function<&::glNamedFramebufferTexture                                                                      >("glNamedFramebufferTexture"                    ),
+            gl::trace::make_function<&::glNamedFramebufferTextureLayer                                                                 >("glNamedFramebufferTextureLayer"               ),
+            gl::trace::make_function<&::glNamedRenderbufferStorage                                                                     >("glNamedRenderbufferStorage"                   ),
+            gl::trace::make_function<&::glNamedRenderbufferStorageMultisample                                                          >("glNamedRenderbufferStorageMultisample"        ),
+            gl::trace::make_function<&::glObjectLabel                                                                                  >("glObjectLabel"                                ),
+            gl::trace::make_function<&::glObjectPtrLabel                                                                               >("glObjectPtrLabel"                             ),
+            gl::trace::make_function<&::glPatchParameterfv                                                                             >("glPatchParameterfv"                           ),
+            gl::trace::make_function<&::glPatchParameteri                                                                              >("glPatchParameteri"                            ),
+            gl::trace::make_function<&::glPixelStorei                                                                                  >("glPixelStorei"                                ),
+            gl::trace::make_function<&::glPointParameterf                                                                              >("glPointParameterf"                            ),
+            gl::trace::make_function<&::glPointParameteri                                                                              >("glPointParameteri"                            ),
+            gl::trace::make_function<&::glPointSize                                                                                    >("glPointSize"                                  ),
+            gl::trace::make_function<&::glPolygonMode                                                                                  >("glPolygonMode"                                ),
+            gl::trace::make_function<&::glPolygonOffsetClamp                                                                           >("glPolygonOffsetClamp"                         ),
+            gl::trace::make_function<&::glPopDebugGroup                                                                                >("glPopDebugGroup"                              ),
+            gl::trace::make_function<&::glPrimitiveRestartIndex                                                                        >("glPrimitiveRestartIndex"                      ),
+            gl::trace::make_function<&::glProgramBinary                                                                                >("glProgramBinary"                              ),
+            gl::trace::make_function<&::glProgramParameteri                                                                            >("glProgramParameteri"                          ),
+            gl::trace::make_function<&::glProgramUniform1fv                                                                            >("glProgramUniform1fv"                          ),
+            gl::trace::make_function<&::glProgramUniform1iv                                                                            >("glProgramUniform1iv"                          ),
+            gl::trace::make_function<&::glProgramUniform1uiv                                                                           >("glProgramUniform1uiv"                         ),
+            gl::trace::make_function<&::glProgramUniform2fv                                                                            >("glProgramUniform2fv"                          ),
+            gl::trace::make_function<&::glProgramUniform2iv                                                                            >("glProgramUniform2iv"                          ),
+            gl::trace::make_function<&::glProgramUniform2uiv                                                                           >("glProgramUniform2uiv"                         ),
+            gl::trace::make_function<&::glProgramUniform3fv                                                                            >("glProgramUniform3fv"                          ),
+            gl::trace::make_function<&::glProgramUniform3iv                                                                            >("glProgramUniform3iv"                          ),
+            gl::trace::make_function<&::glProgramUniform3uiv                                                                           >("glProgramUniform3uiv"                         ),
+            gl::trace::make_function<&::glProgramUniform4fv                                                                            >("glProgramUniform4fv"                          ),
+            gl::trace::make_function<&::glProgramUniform4iv                                                                            >("glProgramUniform4iv"                          ),
+            gl::trace::make_function<&::glProgramUniform4uiv                                                                           >("glProgramUniform4uiv"                         ),
+            gl::trace::make_function<&::glProgramUniformMatrix2fv                                                                      >("glProgramUniformMatrix2fv"                    ),
+            gl::trace::make_function<&::glProgramUniformMatrix2x3fv                                                                    >("glProgramUniformMatrix2x3fv"                  ),
+            gl::trace::make_function<&::glProgramUniformMatrix2x4fv                                                                    >("glProgramUniformMatrix2x4fv"                  ),
+            gl::trace::make_function<&::glProgramUniformMatrix3fv                                                                      >("glProgramUniformMatrix3fv"                    ),
+            gl::trace::make_function<&::glProgramUniformMatrix3x2fv                                                                    >("glProgramUniformMatrix3x2fv"                  ),
+            gl::trace::make_function<&::glProgramUniformMatrix3x4fv                                                                    >("glProgramUniformMatrix3x4fv"                  ),
+            gl::trace::make_function<&::glProgramUniformMatrix4fv                                                                      >("glProgramUniformMatrix4fv"                    ),
+            gl::trace::make_function<&::glProgramUniformMatrix4x2fv                                                                    >("glProgramUniformMatrix4x2fv"                  ),
+            gl::trace::make_function<&::glProgramUniformMatrix4x3fv                                                                    >("glProgramUniformMatrix4x3fv"                  ),
+            gl::trace::make_function<&::glProvokingVertex                                                                              >("glProvokingVertex"                            ),
+            gl::trace::make_function<&::glPushDebugGroup                                                                               >("glPushDebugGroup"                             ),
+            gl::trace::make_function<&::glQueryCounter                                                                                 >("glQueryCounter"                               ),
+            gl::trace::make_function<&::glReadnPixels                                                                                  >("glReadnPixels"                                ),
+            gl::trace::make_function<&::glReleaseShaderCompiler                                                                        >("glReleaseShaderCompiler"                      ),
+            gl::trace::make_function<&::glSampleCoverage                                                                               >("glSampleCoverage"                             ),
+            gl::trace::make_function<&::glSampleMaski                                                                                  >("glSampleMaski"                                ),
+            gl::trace::make_function<&::glSamplerParameterIiv                                                                          >("glSamplerParameterIiv"                        ),
+            gl::trace::make_function<&::glSamplerParameterIuiv                                                                         >("glSamplerParameterIuiv"                       ),
+            gl::trace::make_function<&::glSamplerParameterfv                                                                           >("glSamplerParameterfv"                         ),
+            gl::trace::make_function<&::glScissor                                                                                      >("glScissor"                                    ),
+            gl::trace::make_function<&::glScissorArrayv                                                                                >("glScissorArrayv"                              ),
+            gl::trace::make_function<&::glScissorIndexed                                                                               >("glScissorIndexed"                             ),
+            gl::trace::make_function<&::glShaderBinary                                                                                 >("glShaderBinary"                               ),
+            gl::trace::make_function<&::glShaderSource                                                                                 >("glShaderSource"                               ),
+            gl::trace::make_function<&::glSpecializeShader                                                                             >("glSpecializeShader"                           ),
+            gl::trace::make_function<&::glStencilFunc                                                                                  >("glStencilFunc"                                ),
+            gl::trace::make_function<&::glStencilFuncSeparate                                                                          >("glStencilFuncSeparate"                        ),
+            gl::trace::make_function<&::glStencilMask                                                                                  >("glStencilMask"                                ),
+            gl::trace::make_function<&::glStencilMaskSeparate                                                                          >("glStencilMaskSeparate"                        ),
+            gl::trace::make_function<&::glStencilOp                                                                                    >("glStencilOp"                                  ),
+            gl::trace::make_function<&::glStencilOpSeparate                                                                            >("glStencilOpSeparate"                          ),
+            gl::trace::make_function<&::glTextureBarrier                                                                               >("glTextureBarrier"                             ),
+            gl::trace::make_function<&::glTextureBuffer                                                                                >("glTextureBuffer"                              ),
+            gl::trace::make_function<&::glTextureBufferRange                                                                           >("glTextureBufferRange"                         ),
+            gl::trace::make_function<&::glTextureParameterIiv                                                                          >("glTextureParameterIiv"                        ),
+            gl::trace::make_function<&::glTextureParameterIuiv                                                                         >("glTextureParameterIuiv"                       ),
+            gl::trace::make_function<&::glTextureParameterfv                                                                           >("glTextureParameterfv"                         ),
+            gl::trace::make_function<&::glTextureParameteri                                                                            >("glTextureParameteri"                          ),
+            gl::trace::make_function<&::glTextureStorage1D                           , &gl::trace::null::texture_storage_1d            >("glTextureStorage1D"                           ),
+            gl::trace::make_function<&::glTextureStorage2D                           , &gl::trace::null::texture_storage_2d            >("glTextureStorage2D"                           ),
+            gl::trace::make_function<&::glTextureStorage2DMultisample                , &gl::trace::null::texture_storage_2d_multisample>("glTextureStorage2DMultisample"                ),
+            gl::trace::make_function<&::glTextureStorage3D                           , &gl::trace::null::texture_storage_3d            >("glTextureStorage3D"                           ),
+            gl::trace::make_function<&::glTextureStorage3DMultisample                , &gl::trace::null::texture_storage_3d_multisample>("glTextureStorage3DMultisample"                ),
+            gl::trace::make_function<&::glTextureSubImage1D                                                                            >("glTextureSubImage1D"                          ),
+            gl::trace::make_function<&::glTextureSubImage2D                                                                            >("glTextureSubImage2D"                          ),
+            gl::trace::make_function<&::glTextureSubImage3D                                                                            >("glTextureSubImage3D"                          ),
+            gl::trace::make_function<&::glTextureView                                                                                  >("glTextureView"                                ),
+            gl::trace::make_function<&::glUnmapNamedBuffer                           , &gl::trace::null::unmap_buffer                  >("glUnmapNamedBuffer"                           ),
+            gl::trace::make_function<&::glUseProgramStages                                                                             >("glUseProgramStages"                           ),
+            gl::trace::make_function<&::glValidateProgram                                                                              >("glValidateProgram"                            ),
+            gl::trace::make_function<&::glValidateProgramPipeline                                                                      >("glValidateProgramPipeline"                    ),
+            gl::trace::make_function<&::glVertexArrayAttribBinding                                                                     >("glVertexArrayAttribBinding"                   ),
+            gl::trace::make_function<&::glVertexArrayAttribFormat                                                                      >("glVertexArrayAttribFormat"                    ),
+            gl::trace::make_function<&::glVertexArrayAttribIFormat                                                                     >("glVertexArrayAttribIFormat"                   ),
+            gl::trace::make_function<&::glVertexArrayAttribLFormat                                                                     >("glVertexArrayAttribLFormat"                   ),
+            gl::trace::make_function<&::glVertexArrayBindingDivisor                                                                    >("glVertexArrayBindingDivisor"                  ),
+            gl::trace::make_function<&::glVertexArrayElementBuffer                                                                     >("glVertexArrayElementBuffer"                   ),
+            gl::trace::make_function<&::glVertexArrayVertexBuffer                                                                      >("glVertexArrayVertexBuffer"                    ),
+            gl::trace::make_function<&::glVertexArrayVertexBuffers                                                                     >("glVertexArrayVertexBuffers"                   ),
+            gl::trace::make_function<&::glVertexAttrib1f                                                                               >("glVertexAttrib1f"                             ),
+            gl::trace::make_function<&::glVertexAttrib1s                                                                               >("glVertexAttrib1s"                             ),
+            gl::trace::make_function<&::glVertexAttrib2f                                                                               >("glVertexAttrib2f"                             ),
+            gl::trace::make_function<&::glVertexAttrib2s                                                                               >("glVertexAttrib2s"                             ),
+            gl::trace::make_function<&::glVertexAttrib3f                                                                               >("glVertexAttrib3f"                             ),
+            gl::trace::make_function<&::glVertexAttrib3s                                                                               >("glVertexAttrib3s"                             ),
+            gl::trace::make_function<&::glVertexAttrib4Nub                                                                             >("glVertexAttrib4Nub"                           ),
+            gl::trace::make_function<&::glVertexAttrib4f                                                                               >("glVertexAttrib4f"                             ),
+            gl::trace::make_function<&::glVertexAttrib4s                                                                               >("glVertexAttrib4s"                             ),
+            gl::trace::make_function<&::glVertexAttribI1i                                                                              >("glVertexAttribI1i"                            ),
+            gl::trace::make_function<&::glVertexAttribI1ui                                                                             >("glVertexAttribI1ui"                           ),
+            gl::trace::make_function<&::glVertexAttribI2i                                                                              >("glVertexAttribI2i"                            ),
+            gl::trace::make_function<&::glVertexAttribI2ui                                                                             >("glVertexAttribI2ui"                           ),
+            gl::trace::make_function<&::glVertexAttribI3i                                                                              >("glVertexAttribI3i"                            ),
+            gl::trace::make_function<&::glVertexAttribI3ui                                                                             >("glVertexAttribI3ui"                           ),
+            gl::trace::make_function<&::glVertexAttribI4i                                                                              >("glVertexAttribI4i"                            ),
+            gl::trace::make_function<&::glVertexAttribI4ui                                                                             >("glVertexAttribI4ui"                           ),
+            gl::trace::make_function<&::glVertexAttribL1d                                                                              >("glVertexAttribL1d"                            ),
+            gl::trace::make_function<&::glVertexAttribL2d                                                                              >("glVertexAttribL2d"                            ),
+            gl::trace::make_function<&::glVertexAttribL3d                                                                              >("glVertexAttribL3d"                            ),
+            gl::trace::make_function<&::glVertexAttribL4d                                                                              >("glVertexAttribL4d"                            ),
+            gl::trace::make_function<&::glViewport                                                                                     >("glViewport"                                   ),
+            gl::trace::make_function<&::glViewportArrayv                                                                               >("glViewportArrayv"                             ),
+            gl::trace::make_function<&::glViewportIndexedf                                                                             >("glViewportIndexedf"                           ),
+            gl::trace::make_function<&::glWaitSync                                                                                     >("glWaitSync"                                   )
+        });
+
+        return functions;
+    }
+    auto current  () -> gl::trace::context&
+    {
+        thread_local auto context = gl::trace::context{ gl::trace::functions().size() };
+        return context;
+    }
+
+    auto summarize(gl::trace::context::frame const& frame) -> gl::trace::statistics
+    {
+        auto const functions  = gl::trace::functions();
+        auto       statistics = gl::trace::statistics{ .sync_count = frame.sync_count, .uploaded_bytes = frame.uploaded_bytes, .downloaded_bytes = frame.downloaded_bytes };
+        for (auto index = gl::size_t{ 0u }; index < functions.size(); ++index)
+        {
+            auto const  call_count = frame.call_counts[index];
+            if (call_count == 0u) continue;
+
+            auto const& function   = functions  [index];
+            auto const  time       = frame.times[index];
+            statistics.functions.emplace_back(function.name, function.category, call_count, time);
+            statistics.call_count += call_count;
+            statistics.time       += time;
+
+            switch (function.category)
+            {
+                case gl::trace::category_e::draw       : statistics.draw_count        += call_count; break;
+                case gl::trace::category_e::dispatch   : statistics.dispatch_count    += call_count; break;
+                case gl::trace::category_e::state_query: statistics.state_query_count += call_count; break;
+                default                                :                                             break;
+            }
+            if (function.name == "glClientWaitSync") statistics.blocked_time += time;
+        }
+        std::ranges::stable_sort(statistics.functions, std::greater{}, &gl::trace::function_statistics::call_count);
+
+        return statistics;
+    }
+}
+
+
+
+export namespace gl::trace
+{
+    //Wraps every function the opengl module calls, install after glad has loaded and again whenever it is reloaded
+    //Counters are kept per thread, advance marks the end of a frame on the thread that renders it
+    void install          ()
+    {
+        if constexpr (gl::trace::is_enabled)
+        {
+            auto const functions = gl::trace::functions();
+            for (auto index = gl::size_t{ 0u }; index < functions.size(); ++index) functions[index].install(static_cast<gl::uint16_t>(index));
+        }
+    }
+    //Replaces the driver with functions that do nothing, works with or without the trace layer installed
+    //Objects get names and status queries succeed, which lets the opengl functions and captures run without a GPU to measure their CPU cost
+    void load_null_backend()
+    {
+        for (auto const& function : gl::trace::functions()) function.load_null();
+        gl::trace::null::current_backend().is_loaded = gl::true_;
+    }
+
+    void advance          ()
+    {
+        gl::trace::current().advance();
+    }
+    auto last_frame       () -> gl::trace::statistics
+    {
+        return gl::trace::summarize(gl::trace::current().last_frame());
+    }
+    auto total            () -> gl::trace::statistics
+    {
+        return gl::trace::summarize(gl::trace::current().total());
+    }
+
+    //Records the calls of the calling thread until the capture is ended
+    //The capture starts with "GLTR", the version and a table of function names, followed by the records of every call
+    //Arguments are stored by value, the memory behind pointer arguments is not part of the capture
+    void begin_capture    ()
+    {
+        gl::trace::current().begin_capture();
+    }
+    auto end_capture      () -> std::vector<gl::byte_t>
+    {
+        auto const records   = gl::trace::current().end_capture();
+        auto       capture   = std::vector<gl::byte_t>{};
+        auto const append    = [&]<typename value_t>(value_t value)
+            {
+                auto const bytes = std::bit_cast<std::array<gl::byte_t, sizeof(value_t)>>(value);
+                capture.insert(capture.end(), bytes.begin(), bytes.end());
+            };
+
+        auto const functions = gl::trace::functions();
+        append(std::array<char, 4u>{ 'G', 'L', 'T', 'R' });
+        append(gl::uint32_t{ 1u });
+        append(static_cast<gl::uint32_t>(functions.size()));
+        for (auto const& function : functions)
+        {
+            append(static_cast<gl::uint16_t>(function.name.size()));
+            capture.insert(capture.end(), function.name.begin(), function.name.end());
+        }
+        capture.insert(capture.end(), records.begin(), records.end());
+
+        return capture;
+    }
+    //Calls every recorded function through the pointers glad currently holds, frame markers advance the frame
+    //Pointer arguments are redirected to zeroed scratch memory, which a driver would read or write past by the recorded sizes
+    //Replaying therefore requires the null backend, whose functions write at most a handful of values through them
+    void replay           (std::span<gl::byte_t const> capture)
+    {
+        if (!gl::trace::null::current_backend().is_loaded) throw std::runtime_error{ "trace captures can only be replayed against the null backend" };
+
+        auto offset = gl::size_t{ 0u };
+        if (gl::trace::read<std::array<char, 4u>>(capture, offset) != std::array<char, 4u>{ 'G', 'L', 'T', 'R' }) throw std::invalid_argument{ "data is not a trace capture" };
+        if (gl::trace::read<gl::uint32_t        >(capture, offset) != gl::uint32_t{ 1u }                        ) throw std::invalid_argument{ "unsupported trace capture version" };
+
+        auto const functions      = gl::trace::functions();
+        auto const function_count = gl::trace::read<gl::uint32_t>(capture, offset);
+        auto       mapping        = std::vector<gl::trace::function const*>(function_count);
+        for (auto& function : mapping)
+        {
+            auto const length   = gl::trace::read<gl::uint16_t>(capture, offset);
+            if (offset + length > capture.size()) throw std::runtime_error{ "trace capture is truncated" };
+
+            auto const name     = std::string_view{ reinterpret_cast<char const*>(capture.data() + offset), length };
+            auto const iterator = std::ranges::find(functions, name, &gl::trace::function::name);
+            if (iterator == functions.end()) throw std::runtime_error{ std::format("trace capture references unknown function {}", name) };
+
+            function = std::to_address(iterator);
+            offset  += length;
+        }
+
+        auto scratch = std::vector<gl::byte_t>(gl::trace::scratch_size);
+        while (offset < capture.size())
+        {
+            auto const index = gl::trace::read<gl::uint16_t>(capture, offset);
+            auto const size  = gl::trace::read<gl::uint16_t>(capture, offset);
+            if (index == gl::trace::context::frame_marker)
+            {
+                gl::trace::advance();
+                continue;
+            }
+            if (index >= mapping.size()          ) throw std::runtime_error{ "trace record references an unknown function" };
+            if (offset + size > capture.size()   ) throw std::runtime_error{ "trace capture is truncated" };
+
+            mapping[index]->replay(capture.subspan(offset, size), scratch.data());
+            offset += size;
+        }
+    }
+
+    //Writes the counters as one JSON object, functions are ordered by call count
+    auto to_json          (gl::trace::statistics const& statistics) -> std::string
+    {
+        auto json = std::format(R"({{ "calls": {}, "draws": {}, "dispatches": {}, "state_queries": {}, "sync_points": {}, "uploaded_bytes": {}, "downloaded_bytes": {}, "time_ns": {}, "blocked_time_ns": {}, "functions": [)", 
+            statistics.call_count, statistics.draw_count, statistics.dispatch_count, statistics.state_query_count, statistics.sync_count, 
+            statistics.uploaded_bytes, statistics.downloaded_bytes, statistics.time.count(), statistics.blocked_time.count());
+        for (auto index = gl::size_t{ 0u }; index < statistics.functions.size(); ++index)
+        {
+            auto const& function = statistics.functions[index];
+            json += std::format(R"({}{{ "name": "{}", "calls": {}, "time_ns": {} }})", index == 0u ? " " : ", ", function.name, function.call_count, function.time.count());
+        }
+        json += " ] }";
+
+        return json;
+    }
+}
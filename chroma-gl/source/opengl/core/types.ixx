@@ -48,6 +48,8 @@ export namespace gl
     
     enum class none_t                   : decltype(GL_NONE);
     enum class handle_t                 : gl::uint32_t;
+    enum class half_t                   : gl::uint16_t; //Half float vertex attribute component, distinct from the integer the bits are stored in
+    enum class int32_2_10_10_10_r_t     : gl::uint32_t; //Four signed vertex attribute components packed into 10, 10, 10 and 2 bits
 
 
 
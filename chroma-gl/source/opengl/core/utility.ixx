@@ -45,6 +45,10 @@ export namespace gl
     }
 
 
+    auto align_up             (gl::size_t value, gl::size_t alignment) -> gl::size_t
+    {
+        return (value + alignment - 1u) / alignment * alignment;
+    }
     
     template<typename element_t>
     auto convert_range        (gl::index_range range                               ) -> gl::byte_range
@@ -88,11 +92,11 @@ export namespace gl
     }
     auto range_overlaps       (gl::index_range alpha, gl::index_range beta    ) -> gl::bool_t
     {
-        return (alpha.index < beta.index + beta.count) && (beta.index < alpha.index + beta.count);
+        return (alpha.index < beta.index + beta.count) && (beta.index < alpha.index + alpha.count);
     }
     auto range_overlaps       (gl::byte_range  alpha, gl::byte_range  beta    ) -> gl::bool_t
     {
-        return (alpha.offset < beta.offset + beta.size) && (beta.offset < alpha.offset + beta.size);
+        return (alpha.offset < beta.offset + beta.size) && (beta.offset < alpha.offset + alpha.size);
     }
     template<typename element_t, gl::uint32_t component_v>
     auto clamp_region         (gl::region<element_t, component_v> region, gl::vector_t<element_t, component_v> boundary) -> gl::region<element_t, component_v>
@@ -248,6 +248,13 @@ export namespace gl::legacy
 
         return value;
     };
+    auto get_query_object_uint64_value                    (gl::handle_t query, gl::query_parameter_e parameter) -> gl::uint64_t
+    {
+        auto value = gl::uint64_t{};
+        ::glGetQueryObjectui64v(gl::to_underlying(query), gl::to_underlying(parameter), &value);
+
+        return value;
+    };
     auto get_query_buffer_object_int32_value              (gl::handle_t query, gl::handle_t buffer, gl::query_parameter_e query_parameter, gl::ptrdiff_t offset)
         {
             ::glGetQueryBufferObjectiv(gl::to_underlying(query), gl::to_underlying(buffer), gl::to_underlying(query_parameter), offset);
@@ -728,8 +735,6 @@ export namespace gl::legacy
     //glIsVertexArray
     //glMapBuffer
     //glMapBufferRange
-    //glMultiDrawArraysIndirectCount
-    //glMultiDrawElementsIndirectCount
     //glNamedBufferData
     //glPauseTransformFeedback
     //glPixelStoref
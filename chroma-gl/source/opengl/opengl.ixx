@@ -1,4 +1,6 @@
 export module opengl;
+export import :barrier;
+export import :cache;
 export import :constants;
 export import :domain;
 export import :flags;
@@ -7,6 +9,7 @@ export import :meta;
 export import :parameters;
 export import :state;
 export import :structures;
+export import :trace;
 export import :types;
 export import :utility;
 #ifdef GL_LEGACY_EXPORT
@@ -151,22 +154,26 @@ export namespace gl
     template<gl::feature_e feature_v>
     void enable                                           ()
     {
+        if (!gl::cache::current().update_feature(feature_v, gl::true_ )) return;
         ::glEnable(gl::to_underlying(feature_v));
     }
     template<gl::feature_e feature_v>
     void enable                                           (gl::index_t index)
     {
-        ::glEnablei(gl::to_underlying(feature_v), index);
+        gl::cache::current().forget_feature(feature_v);
+        ::glEnablei(gl::to_underlying(feature_v), static_cast<gl::uint32_t>(index));
     }
     template<gl::feature_e feature_v>
     void disable                                          ()
     {
+        if (!gl::cache::current().update_feature(feature_v, gl::false_)) return;
         ::glDisable(gl::to_underlying(feature_v));
     }
     template<gl::feature_e feature_v>
     void disable                                          (gl::index_t index)
     {
-        ::glDisablei(gl::to_underlying(feature_v), index);
+        gl::cache::current().forget_feature(feature_v);
+        ::glDisablei(gl::to_underlying(feature_v), static_cast<gl::uint32_t>(index));
     }
     template<gl::feature_e feature_v>
     auto is_enabled                                       () -> gl::bool_t
@@ -198,6 +205,16 @@ export namespace gl
         auto const* c_string = reinterpret_cast<gl::c_string>(::glGetStringi(gl::to_underlying(property_v), static_cast<gl::uint32_t>(index)));
         return std::string{ c_string };
     }
+    auto is_extension_supported                           (std::string_view extension) -> gl::bool_t
+    {
+        auto const extension_count = gl::get<gl::data_e::number_extensions>();
+        for (auto index = gl::index_t{ 0u }; index < extension_count; ++index)
+        {
+            if (gl::get_string<gl::context_property_e::extensions>(index) == extension) return gl::true_;
+        }
+
+        return gl::false_;
+    }
     template<gl::internal_format_parameter_e parameter_v>
     auto get_internal_format                              (gl::enum_t internal_format, gl::internal_format_target_e internal_format_target) -> auto
     {
@@ -231,9 +248,13 @@ export namespace gl
     {
         using enum gl::query_parameter_e;
         if constexpr (parameter_v == target          ) return static_cast<gl::query_target_e>(legacy::get_query_object_int32_value (query, parameter_v));
-        if constexpr (parameter_v == result          ) return                                 legacy::get_query_object_uint32_value(query, parameter_v) ;
+        if constexpr (parameter_v == result          )
+        {
+            gl::trace::count_sync();
+            return legacy::get_query_object_uint64_value(query, parameter_v);
+        }
         if constexpr (parameter_v == result_available) return static_cast<gl::bool_t        >(legacy::get_query_object_int32_value( query, parameter_v));
-        if constexpr (parameter_v == result_no_wait  ) return                                 legacy::get_query_object_uint32_value(query, parameter_v) ;
+        if constexpr (parameter_v == result_no_wait  ) return                                 legacy::get_query_object_uint64_value(query, parameter_v) ;
     }
     template<gl::query_parameter_e parameter_v>
     void get_query_buffer_object_parameter                (gl::handle_t query, gl::handle_t buffer, gl::ptrdiff_t offset)
@@ -258,7 +279,11 @@ export namespace gl
         if constexpr (parameter_v == is_mapped    ) return static_cast<gl::bool_t                       >(legacy::get_buffer_parameter_int32_value(buffer, parameter_v));
         if constexpr (parameter_v == map_length   ) return static_cast<gl::size_t                       >(legacy::get_buffer_parameter_int64_value(buffer, parameter_v));
         if constexpr (parameter_v == map_offset   ) return static_cast<gl::size_t                       >(legacy::get_buffer_parameter_int64_value(buffer, parameter_v));
-        if constexpr (parameter_v == size         ) return static_cast<gl::size_t                       >(legacy::get_buffer_parameter_int64_value(buffer, parameter_v));
+        if constexpr (parameter_v == size         )
+        {
+            if (auto const buffer_size = gl::cache::current().buffer_size(buffer)) return *buffer_size;
+            return static_cast<gl::size_t>(legacy::get_buffer_parameter_int64_value(buffer, parameter_v));
+        }
         if constexpr (parameter_v == storage_flags) return static_cast<gl::buffer_storage_flags_e       >(legacy::get_buffer_parameter_int32_value(buffer, parameter_v));
         if constexpr (parameter_v == usage        ) return static_cast<gl::buffer_usage_e               >(legacy::get_buffer_parameter_int32_value(buffer, parameter_v));
     }
@@ -270,6 +295,8 @@ export namespace gl
 
         auto       vector      = std::vector<element_t>(buffer_size / sizeof(element_t));
         ::glGetNamedBufferSubData(gl::to_underlying(buffer), gl::intptr_t{ 0 }, static_cast<gl::sizeiptr_t>(buffer_size), vector.data());
+        gl::trace::count_sync    ();
+        gl::trace::count_download(buffer_size);
         
         return vector;
     }
@@ -282,6 +309,8 @@ export namespace gl
 
         auto       vector      = std::vector<element_t>(range.count);
         ::glGetNamedBufferSubData(gl::to_underlying(buffer), static_cast<gl::intptr_t>(byte_range.offset), static_cast<gl::sizeiptr_t>(byte_range.size), vector.data());
+        gl::trace::count_sync    ();
+        gl::trace::count_download(byte_range.size);
         
         return vector;
     }
@@ -293,11 +322,12 @@ export namespace gl
     auto get_shader_parameter                             (gl::handle_t shader) -> auto
     {
         using enum gl::shader_parameter_e;
-        if constexpr (parameter_v == compile_status ) return static_cast<gl::bool_t       >(legacy::get_shader_value(shader, parameter_v));
-        if constexpr (parameter_v == delete_status  ) return static_cast<gl::bool_t       >(legacy::get_shader_value(shader, parameter_v));
-        if constexpr (parameter_v == info_log_length) return static_cast<gl::size_t       >(legacy::get_shader_value(shader, parameter_v));
-        if constexpr (parameter_v == source_length  ) return static_cast<gl::size_t       >(legacy::get_shader_value(shader, parameter_v));
-        if constexpr (parameter_v == type           ) return static_cast<gl::shader_type_e>(legacy::get_shader_value(shader, parameter_v));
+        if constexpr (parameter_v == compile_status   ) return static_cast<gl::bool_t       >(legacy::get_shader_value(shader, parameter_v));
+        if constexpr (parameter_v == completion_status) return static_cast<gl::bool_t       >(legacy::get_shader_value(shader, parameter_v));
+        if constexpr (parameter_v == delete_status    ) return static_cast<gl::bool_t       >(legacy::get_shader_value(shader, parameter_v));
+        if constexpr (parameter_v == info_log_length  ) return static_cast<gl::size_t       >(legacy::get_shader_value(shader, parameter_v));
+        if constexpr (parameter_v == source_length    ) return static_cast<gl::size_t       >(legacy::get_shader_value(shader, parameter_v));
+        if constexpr (parameter_v == type             ) return static_cast<gl::shader_type_e>(legacy::get_shader_value(shader, parameter_v));
     }
     template<gl::program_parameter_e parameter_v>
     auto get_program_parameter                            (gl::handle_t program) -> auto
@@ -312,6 +342,7 @@ export namespace gl
         if constexpr (parameter_v == active_uniforms                          ) return static_cast<gl::uint32_t                        >(legacy::get_program_value(program, parameter_v));
         if constexpr (parameter_v == attached_shaders                         ) return static_cast<gl::uint32_t                        >(legacy::get_program_value(program, parameter_v));
         if constexpr (parameter_v == binary_length                            ) return static_cast<gl::size_t                          >(legacy::get_program_value(program, parameter_v));
+        if constexpr (parameter_v == completion_status                        ) return static_cast<gl::bool_t                          >(legacy::get_program_value(program, parameter_v));
         if constexpr (parameter_v == compute_work_group_size                  ) return static_cast<gl::size_t                          >(legacy::get_program_value(program, parameter_v));
         if constexpr (parameter_v == delete_status                            ) return static_cast<gl::bool_t                          >(legacy::get_program_value(program, parameter_v));
         if constexpr (parameter_v == geometry_input_type                      ) return static_cast<gl::draw_mode_e                     >(legacy::get_program_value(program, parameter_v));
@@ -505,6 +536,8 @@ export namespace gl
             static_cast<gl::int32_t>(image_level)                       , 
             gl::to_underlying       (buffer_data_descriptor.base_format), gl::to_underlying(buffer_data_descriptor.data_type), 
             static_cast<gl::sizei_t>(image_size)                        , vector.data()                                     );
+        gl::trace::count_sync    ();
+        gl::trace::count_download(image_size);
 
         return vector;
     }
@@ -532,9 +565,32 @@ export namespace gl
             static_cast<gl::sizei_t>(image_volume.extent.x)             , static_cast<gl::sizei_t>(image_volume.extent.y)           , static_cast<gl::sizei_t>(image_volume.extent.z), 
             gl::to_underlying       (buffer_data_descriptor.base_format), gl::to_underlying       (buffer_data_descriptor.data_type), 
             static_cast<gl::sizei_t>(image_size)                        , vector.data()                                            );
+        gl::trace::count_sync    ();
+        gl::trace::count_download(image_size);
 
         return vector;
     }
+    //Writes the image into the bound pixel pack buffer and returns without waiting for it, the offset is in bytes
+    void get_texture_sub_image                            (gl::handle_t texture, gl::uint32_t image_level, gl::box image_volume, gl::buffer_data_descriptor buffer_data_descriptor, gl::offset_t buffer_offset, gl::size_t buffer_size)
+    {
+        auto const pixel_pack_buffer_binding = gl::get<gl::data_e::pixel_pack_buffer_binding>();
+        if (pixel_pack_buffer_binding == gl::null_object) throw std::runtime_error{ "no pixel pack buffer bound" };
+        auto const image_width               = gl::get_texture_level_parameter<gl::texture_level_parameter_e::width >(texture, image_level);
+        auto const image_height              = gl::get_texture_level_parameter<gl::texture_level_parameter_e::height>(texture, image_level);
+        auto const image_depth               = gl::get_texture_level_parameter<gl::texture_level_parameter_e::depth >(texture, image_level);
+        if (image_volume.origin.x + image_volume.extent.x > image_width ) throw std::invalid_argument{ "volume width exceeds image width"   };
+        if (image_volume.origin.y + image_volume.extent.y > image_height) throw std::invalid_argument{ "volume height exceeds image height" };
+        if (image_volume.origin.z                         > image_depth ) throw std::invalid_argument{ "volume depth exceeds image depth"   };
+
+        gl::barrier::resolve(gl::barrier::command_e::pixel_pack);
+        ::glGetTextureSubImage(
+            gl::to_underlying       (texture)                           , 
+            static_cast<gl::int32_t>(image_level)                       , 
+            static_cast<gl::int32_t>(image_volume.origin.x)             , static_cast<gl::int32_t>(image_volume.origin.y)           , static_cast<gl::int32_t>(image_volume.origin.z), 
+            static_cast<gl::sizei_t>(image_volume.extent.x)             , static_cast<gl::sizei_t>(image_volume.extent.y)           , static_cast<gl::sizei_t>(image_volume.extent.z), 
+            gl::to_underlying       (buffer_data_descriptor.base_format), gl::to_underlying       (buffer_data_descriptor.data_type), 
+            static_cast<gl::sizei_t>(buffer_size)                       , reinterpret_cast<gl::void_t*>(buffer_offset)             );
+    }
     template<typename element_t = gl::byte_t>
     auto get_compressed_texture_image                     (gl::handle_t texture, gl::uint32_t image_level) -> std::vector<element_t>
     {
@@ -546,6 +602,8 @@ export namespace gl
             gl::to_underlying       (texture)              , 
             static_cast<gl::int32_t>(image_level)          , 
             static_cast<gl::sizei_t>(compressed_image_size), vector.data());
+        gl::trace::count_sync    ();
+        gl::trace::count_download(compressed_image_size);
 
         return vector;
     }
@@ -576,6 +634,8 @@ export namespace gl
             static_cast<gl::int32_t>(image_volume.origin.x), static_cast<gl::int32_t>(image_volume.origin.y), static_cast<gl::int32_t>(image_volume.origin.z), 
             static_cast<gl::sizei_t>(image_volume.extent.x), static_cast<gl::sizei_t>(image_volume.extent.y), static_cast<gl::sizei_t>(image_volume.extent.z), 
             static_cast<gl::sizei_t>(compressed_image_size), vector.data()                                 );
+        gl::trace::count_sync    ();
+        gl::trace::count_download(compressed_image_size);
 
         return vector;
     }
@@ -717,6 +777,7 @@ export namespace gl
     }
     void finish                                           ()
     {
+        gl::trace::count_sync();
         ::glFinish();
     }
 
@@ -733,6 +794,8 @@ export namespace gl
     }
     auto client_wait_sync                                 (gl::sync_t sync, gl::synchronization_command_e synchronization_command, gl::time_t timeout) -> gl::synchronization_status_e
     {
+        //A timeout of zero only polls the sync object
+        if (timeout != gl::time_t{ 0u }) gl::trace::count_sync();
         return static_cast<gl::synchronization_status_e>(::glClientWaitSync(sync, gl::to_underlying(synchronization_command), timeout));
     }
     void server_wait_sync                                 (gl::sync_t sync)
@@ -801,53 +864,73 @@ export namespace gl
     }
     void delete_buffer                                    (gl::handle_t buffer)
     {
+        gl::cache::current().erase_buffer(buffer);
+        gl::barrier::current().erase(gl::barrier::resource_e::buffer, buffer);
         ::glDeleteBuffers(gl::sizei_t{ 1 }, gl::to_underlying_pointer(&buffer));
     }
     void delete_buffers                                   (std::span<gl::handle_t const> buffers)
     {
+        for (auto const buffer : buffers) gl::cache::current().erase_buffer(buffer);
+        for (auto const buffer : buffers) gl::barrier::current().erase(gl::barrier::resource_e::buffer, buffer);
         ::glDeleteBuffers(static_cast<gl::sizei_t>(buffers.size()), gl::to_underlying_pointer(buffers.data()));
     }
     void bind_buffer                                      (gl::handle_t buffer, gl::buffer_target_e           target                       )
     {
+        gl::barrier::current().bind_buffer(target, buffer);
+        if (!gl::cache::current().update_buffer(target, buffer)) return;
         ::glBindBuffer(gl::to_underlying(target), gl::to_underlying(buffer));
     }
-    void bind_buffer_base                                 (gl::handle_t buffer, gl::buffer_base_target_e base_target, gl::binding_t binding)
+    //The access declares how shaders use shader storage and atomic counter bindings, only bindings with write access count as written
+    void bind_buffer_base                                 (gl::handle_t buffer, gl::buffer_base_target_e base_target, gl::binding_t binding, gl::image_access_e access = gl::image_access_e::read_only)
     {
+        gl::barrier::current().bind_buffer(base_target, binding, buffer, access);
+        if (!gl::cache::current().update_buffer_base(base_target, binding, buffer)) return;
         ::glBindBufferBase(gl::to_underlying(base_target), binding, gl::to_underlying(buffer));
     }
-    void bind_buffers_base                                (std::span<gl::handle_t const> buffers, gl::buffer_base_target_e target, gl::binding_t start_binding)
+    void bind_buffers_base                                (std::span<gl::handle_t const> buffers, gl::buffer_base_target_e target, gl::binding_t start_binding, gl::image_access_e access = gl::image_access_e::read_only)
     {
+        gl::cache::current().forget_buffer_base(target, start_binding, buffers.size());
+        for (auto const [index, buffer] : std::views::enumerate(buffers)) gl::barrier::current().bind_buffer(target, start_binding + static_cast<gl::binding_t>(index), buffer, access);
         ::glBindBuffersBase(gl::to_underlying(target), start_binding, static_cast<gl::sizei_t>(buffers.size()), gl::to_underlying_pointer(buffers.data()));
     }
     template<typename element_t = gl::byte_t>
-    void bind_buffer_range                                (gl::handle_t                  buffer , gl::buffer_base_target_e base_target, gl::binding_t binding,                 gl::index_range  range )
+    void bind_buffer_range                                (gl::handle_t                  buffer , gl::buffer_base_target_e base_target, gl::binding_t binding,                 gl::index_range  range , gl::image_access_e access = gl::image_access_e::read_only)
     {
         auto const buffer_size = gl::get_buffer_parameter<gl::buffer_parameter_e::size>(buffer);
         auto const byte_range  = gl::convert_range<element_t>(range);
         if (byte_range.offset + byte_range.size > buffer_size) throw std::invalid_argument{ "range exceeds buffer bounds" };
 
+        gl::cache::current().forget_buffer_base(base_target, binding);
+        gl::barrier::current().bind_buffer(base_target, binding, buffer, access);
         ::glBindBufferRange(
             gl::to_underlying        (base_target)      , gl::to_underlying          (binding)         , gl::to_underlying(buffer), 
             static_cast<gl::intptr_t>(byte_range.offset), static_cast<gl::sizeiptr_t>(byte_range.size));
     }
     template<typename element_t = gl::byte_t>
-    void bind_buffers_range                               (std::span<gl::handle_t const> buffers, gl::buffer_base_target_e base_target, gl::binding_t binding, std::span<gl::index_range const> ranges)
+    void bind_buffers_range                               (std::span<gl::handle_t const> buffers, gl::buffer_base_target_e base_target, gl::binding_t binding, std::span<gl::index_range const> ranges, gl::image_access_e access = gl::image_access_e::read_only)
     {
-        auto const buffer_sizes   = std::vector<gl::size_t  >(ranges.size());
-        auto const buffer_offsets = std::vector<gl::intptr_t>(ranges.size());
-        for (std::tuple<gl::handle_t&, gl::index_range&> value : std::views::zip(buffers, ranges))
+        if (buffers.size() != ranges.size()) throw std::invalid_argument{ "buffer and range count mismatch" };
+
+        auto buffer_sizes   = std::vector<gl::sizeiptr_t>{};
+        auto buffer_offsets = std::vector<gl::intptr_t  >{};
+        buffer_sizes  .reserve(ranges.size());
+        buffer_offsets.reserve(ranges.size());
+        for (auto const& [buffer, range] : std::views::zip(buffers, ranges))
         {
-            auto const buffer_size = gl::get_buffer_parameter<gl::buffer_parameter_e::size>(std::get<0u>(value));
-            auto const byte_range  = gl::convert_range<element_t>(std::get<1u>(value));
+            auto const buffer_size = gl::get_buffer_parameter<gl::buffer_parameter_e::size>(buffer);
+            auto const byte_range  = gl::convert_range<element_t>(range);
+            if (byte_range.offset + byte_range.size > buffer_size) throw std::invalid_argument{ "range exceeds buffer bounds" };
             
-            buffer_sizes  .emplace_back(byte_range.size  );
-            buffer_offsets.emplace_back(byte_range.offset);
+            buffer_sizes  .emplace_back(static_cast<gl::sizeiptr_t>(byte_range.size  ));
+            buffer_offsets.emplace_back(static_cast<gl::intptr_t  >(byte_range.offset));
         }
 
+        gl::cache::current().forget_buffer_base(base_target, binding, buffers.size());
+        for (auto const [index, buffer] : std::views::enumerate(buffers)) gl::barrier::current().bind_buffer(base_target, binding + static_cast<gl::binding_t>(index), buffer, access);
         ::glBindBuffersRange(
-            gl::to_underlying        (base_target)   , gl::to_underlying        (binding)                    , 
-            static_cast<gl::sizei_t >(buffers.size()), gl::to_underlying_pointer(buffers.data())             , 
-            static_cast<gl::intptr_t>(buffer_offsets.data()), static_cast<gl::intptr_t>(buffer_sizes.data()));
+            gl::to_underlying        (base_target)   , binding                                , 
+            static_cast<gl::sizei_t >(buffers.size()), gl::to_underlying_pointer(buffers.data()), 
+            buffer_offsets.data()                    , buffer_sizes.data()                    );
     }
     template<typename element_t = gl::byte_t>
     void buffer_storage                                   (gl::handle_t buffer, gl::buffer_storage_flags_e flags, gl::count_t element_count)
@@ -855,6 +938,7 @@ export namespace gl
         ::glNamedBufferStorage(
             gl::to_underlying(buffer), static_cast<gl::sizeiptr_t>(element_count * sizeof(element_t)), 
             nullptr                  , gl::to_underlying          (flags)                           );
+        gl::cache::current().record_buffer_size(buffer, element_count * sizeof(element_t));
     }
     template<typename element_t = gl::byte_t>
     void buffer_storage                                   (gl::handle_t buffer, gl::buffer_storage_flags_e flags, std::span<element_t const> memory)
@@ -862,6 +946,8 @@ export namespace gl
         ::glNamedBufferStorage(
             gl::to_underlying(buffer), static_cast<gl::sizeiptr_t>(memory.size_bytes()), 
             memory.data()            , gl::to_underlying          (flags)             );
+        gl::trace::count_upload(memory.size_bytes());
+        gl::cache::current().record_buffer_size(buffer, memory.size_bytes());
     }
     template<typename element_t = gl::byte_t>
     void buffer_sub_data                                  (gl::handle_t buffer, gl::index_t index, std::span<element_t const> memory)
@@ -874,6 +960,7 @@ export namespace gl
             gl::to_underlying          (buffer)           , 
             static_cast<gl::intptr_t  >(byte_range.offset), 
             static_cast<gl::sizeiptr_t>(byte_range.size)  , memory.data());
+        gl::trace::count_upload(byte_range.size);
     }
     template<typename element_t = gl::byte_t>
     void clear_buffer_data                                (gl::handle_t buffer, gl::buffer_base_format_e base_format, gl::buffer_format_e format, gl::data_type_e data_type,                        element_t value)
@@ -912,6 +999,7 @@ export namespace gl
         
         auto      * pointer     = ::glMapNamedBufferRange(gl::to_underlying(buffer), gl::intptr_t{ 0 }, static_cast<gl::sizeiptr_t>(buffer_size), gl::to_underlying(range_access_flags));
         if (!pointer) throw std::runtime_error{ "failed to map buffer" };
+        if ((range_access_flags & (gl::buffer_mapping_range_access_flags_e::persistent | gl::buffer_mapping_range_access_flags_e::unsynchronized)) == gl::buffer_mapping_range_access_flags_e{}) gl::trace::count_sync();
         
         return std::span{ reinterpret_cast<element_t*>(pointer), buffer_size / sizeof(element_t) };
     }
@@ -924,6 +1012,7 @@ export namespace gl
 
         auto      * pointer     = ::glMapNamedBufferRange(gl::to_underlying(buffer), static_cast<gl::intptr_t>(byte_range.offset), static_cast<gl::sizeiptr_t>(byte_range.size), gl::to_underlying(range_access_flags));
         if (!pointer) throw std::runtime_error{ "failed to map buffer" };
+        if ((range_access_flags & (gl::buffer_mapping_range_access_flags_e::persistent | gl::buffer_mapping_range_access_flags_e::unsynchronized)) == gl::buffer_mapping_range_access_flags_e{}) gl::trace::count_sync();
 
         return std::span{ reinterpret_cast<element_t*>(pointer), range.count };
     }
@@ -970,7 +1059,7 @@ export namespace gl
         auto const destination_buffer_size = gl::get_buffer_parameter<gl::buffer_parameter_e::size>(destination_buffer);
         auto const source_byte_range       = gl::convert_range<element_t>(source_range);
         if (source_byte_range.offset + source_byte_range.size > source_buffer_size     ) throw std::invalid_argument{ "range exceeds source buffer bounds"      };
-        if (source_byte_range.offset + source_byte_range.size > destination_buffer_size) throw std::invalid_argument{ "range exceeds destination buffer bounds" };
+        if (destination_index * sizeof(element_t) + source_byte_range.size > destination_buffer_size) throw std::invalid_argument{ "range exceeds destination buffer bounds" };
 
         ::glCopyNamedBufferSubData(
             gl::to_underlying          (source_buffer)           , gl::to_underlying        (destination_buffer)                   , 
@@ -998,6 +1087,11 @@ export namespace gl
     {
         ::glReleaseShaderCompiler();
     }
+    //Requires KHR_parallel_shader_compile, a count of zero disables parallel compilation
+    void maximum_shader_compiler_threads                  (gl::uint32_t count)
+    {
+        ::glMaxShaderCompilerThreadsKHR(count);
+    }
     void delete_shader                                    (gl::handle_t shader)
     {
         ::glDeleteShader(gl::to_underlying(shader));
@@ -1112,14 +1206,14 @@ export namespace gl
         else if constexpr (std::is_same_v<gl::uint32_t   , uniform_t>) ::glProgramUniform1uiv       (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,                              &value );
         else if constexpr (std::is_same_v<gl::float32_t  , uniform_t>) ::glProgramUniform1fv        (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,                              &value );
 
-        else if constexpr (std::is_same_v<gl::vector_1i  , uniform_t>) ::glProgramUniform4iv        (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
-        else if constexpr (std::is_same_v<gl::vector_2i  , uniform_t>) ::glProgramUniform4iv        (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
-        else if constexpr (std::is_same_v<gl::vector_3i  , uniform_t>) ::glProgramUniform4iv        (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
+        else if constexpr (std::is_same_v<gl::vector_1i  , uniform_t>) ::glProgramUniform1iv        (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
+        else if constexpr (std::is_same_v<gl::vector_2i  , uniform_t>) ::glProgramUniform2iv        (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
+        else if constexpr (std::is_same_v<gl::vector_3i  , uniform_t>) ::glProgramUniform3iv        (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
         else if constexpr (std::is_same_v<gl::vector_4i  , uniform_t>) ::glProgramUniform4iv        (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
 
-        else if constexpr (std::is_same_v<gl::vector_1u  , uniform_t>) ::glProgramUniform4uiv       (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
-        else if constexpr (std::is_same_v<gl::vector_2u  , uniform_t>) ::glProgramUniform4uiv       (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
-        else if constexpr (std::is_same_v<gl::vector_3u  , uniform_t>) ::glProgramUniform4uiv       (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
+        else if constexpr (std::is_same_v<gl::vector_1u  , uniform_t>) ::glProgramUniform1uiv       (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
+        else if constexpr (std::is_same_v<gl::vector_2u  , uniform_t>) ::glProgramUniform2uiv       (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
+        else if constexpr (std::is_same_v<gl::vector_3u  , uniform_t>) ::glProgramUniform3uiv       (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
         else if constexpr (std::is_same_v<gl::vector_4u  , uniform_t>) ::glProgramUniform4uiv       (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
         
         else if constexpr (std::is_same_v<gl::vector_1f  , uniform_t>) ::glProgramUniform1fv        (gl::to_underlying(program), static_cast<gl::int32_t>(location), count,             gl::value_pointer(value));
@@ -1156,14 +1250,17 @@ export namespace gl
     }
     void delete_pipeline                                  (gl::handle_t pipeline)
     {
+        gl::cache::current().erase_pipeline(pipeline);
         ::glDeleteProgramPipelines(gl::sizei_t{ 1 }, gl::to_underlying_pointer(&pipeline));
     }
     void delete_pipelines                                 (std::span<gl::handle_t const> pipeline)
     {
+        for (auto const handle : pipeline) gl::cache::current().erase_pipeline(handle);
         ::glDeleteProgramPipelines(static_cast<gl::sizei_t>(pipeline.size()), gl::to_underlying_pointer(pipeline.data()));
     }
     void bind_pipeline                                    (gl::handle_t pipeline)
     {
+        if (!gl::cache::current().update_pipeline(pipeline)) return;
         ::glBindProgramPipeline(gl::to_underlying(pipeline));
     }
     void use_program_stage                                (gl::handle_t pipeline, gl::handle_t program, gl::program_stage_e program_stage)
@@ -1188,8 +1285,17 @@ export namespace gl
     }
     void memory_barrier                                   (gl::memory_barrier_e                   barrier)
     {
+        gl::barrier::current().record_barrier(barrier);
         ::glMemoryBarrier(gl::to_underlying(barrier));
     }
+    //Issues only the bits a use of the object depends on that no barrier has covered since a shader last wrote to it
+    auto require_memory_barrier                           (gl::barrier::resource_e resource, gl::handle_t object, gl::memory_barrier_e barrier) -> gl::memory_barrier_e
+    {
+        auto const required = gl::barrier::current().require(resource, object, barrier);
+        if (required != gl::memory_barrier_e{}) ::glMemoryBarrier(gl::to_underlying(required));
+
+        return required;
+    }
     void memory_barrier_by_region                         (gl::memory_regional_barrier_e regional_barrier)
     {
         ::glMemoryBarrierByRegion(gl::to_underlying(regional_barrier));
@@ -1214,14 +1320,20 @@ export namespace gl
     }
     void delete_texture                                   (gl::handle_t texture)
     {
+        gl::cache::current().erase_texture(texture);
+        gl::barrier::current().erase(gl::barrier::resource_e::texture, texture);
         ::glDeleteTextures(gl::sizei_t{ 1 }, gl::to_underlying_pointer(&texture));
     }
     void delete_textures                                  (std::span<gl::handle_t const> textures)
     {
+        for (auto const texture : textures) gl::cache::current().erase_texture(texture);
+        for (auto const texture : textures) gl::barrier::current().erase(gl::barrier::resource_e::texture, texture);
         ::glDeleteTextures(static_cast<gl::sizei_t>(textures.size()), gl::to_underlying_pointer(textures.data()));
     }
     void bind_texture_unit                                (gl::handle_t texture, gl::binding_t binding)
     {
+        gl::barrier::current().bind_texture(binding, texture);
+        if (!gl::cache::current().update_texture_unit(binding, texture)) return;
         ::glBindTextureUnit(binding, gl::to_underlying(texture));
     }
     auto create_sampler                                   () -> gl::handle_t
@@ -1240,18 +1352,27 @@ export namespace gl
     }
     void delete_sampler                                   (gl::handle_t sampler)
     {
+        gl::cache::current().erase_sampler(sampler);
         ::glDeleteSamplers(gl::sizei_t{ 1 }, gl::to_underlying_pointer(&sampler));
     }
     void delete_samplers                                  (std::span<gl::handle_t const> samplers)
     {
+        for (auto const sampler : samplers) gl::cache::current().erase_sampler(sampler);
         ::glDeleteSamplers(static_cast<gl::sizei_t>(samplers.size()), gl::to_underlying_pointer(samplers.data()));
     }
     void bind_sampler                                     (gl::handle_t sampler, gl::binding_t binding)
     {
+        if (!gl::cache::current().update_sampler(binding, sampler)) return;
         ::glBindSampler(binding, gl::to_underlying(sampler));
     }
     void bind_samplers                                    (std::span<gl::handle_t const> samplers, gl::index_t index)
     {
+        //Every unit is updated so the cache stays in sync, the batched call is only skipped when none of them changed
+        auto is_required = gl::bool_t{ gl::false_ };
+        for (auto offset = gl::size_t{ 0u }; offset < samplers.size(); ++offset)
+            is_required = gl::cache::current().update_sampler(static_cast<gl::binding_t>(index + offset), samplers[offset]) || is_required;
+        if (!is_required) return;
+
         ::glBindSamplers(static_cast<gl::uint32_t>(index), static_cast<gl::sizei_t>(samplers.size()), gl::to_underlying_pointer(samplers.data()));
     }
     template<gl::sampler_parameter_e parameter_v>
@@ -1297,6 +1418,7 @@ export namespace gl
             static_cast<gl::int32_t>(image_region.origin.x)              , static_cast<gl::sizei_t>(image_region.extent.x)            , 
             gl::to_underlying       (texture_data_descriptor.base_format), gl::to_underlying       (texture_data_descriptor.data_type), 
             memory.data()                                               );
+        gl::trace::count_upload(memory.size_bytes());
     }
     void texture_sub_image_2d                             (gl::handle_t texture, gl::uint32_t image_level, gl::rectangle image_region, gl::texture_data_descriptor texture_data_descriptor, std::span<gl::byte_t const> memory)
     {
@@ -1311,6 +1433,7 @@ export namespace gl
             static_cast<gl::sizei_t>(image_region.extent.x)              , static_cast<gl::sizei_t>(image_region.extent.y)            , 
             gl::to_underlying       (texture_data_descriptor.base_format), gl::to_underlying       (texture_data_descriptor.data_type), 
             memory.data()                                               );
+        gl::trace::count_upload(memory.size_bytes());
     }
     void texture_sub_image_3d                             (gl::handle_t texture, gl::uint32_t image_level, gl::box       image_region, gl::texture_data_descriptor texture_data_descriptor, std::span<gl::byte_t const> memory)
     {
@@ -1327,6 +1450,58 @@ export namespace gl
             static_cast<gl::sizei_t>(image_region.extent.x)              , static_cast<gl::sizei_t>(image_region.extent.y)            , static_cast<gl::sizei_t>(image_region.extent.z), 
             gl::to_underlying       (texture_data_descriptor.base_format), gl::to_underlying       (texture_data_descriptor.data_type), 
             memory.data()                                               );
+        gl::trace::count_upload(memory.size_bytes());
+    }
+    //Sources the image from the bound pixel unpack buffer, the offset is in bytes
+    void texture_sub_image_1d                             (gl::handle_t texture, gl::uint32_t image_level, gl::line      image_region, gl::texture_data_descriptor texture_data_descriptor, gl::offset_t buffer_offset)
+    {
+        auto const pixel_unpack_buffer_binding = gl::get<gl::data_e::pixel_unpack_buffer_binding>();
+        if (pixel_unpack_buffer_binding == gl::null_object) throw std::runtime_error{ "no pixel unpack buffer bound" };
+        auto const image_width = gl::get_texture_level_parameter<gl::texture_level_parameter_e::width >(texture, image_level);
+        if (image_region.origin.x + image_region.extent.x > image_width) throw std::invalid_argument{ "region width exceeds image bounds" };
+
+        gl::barrier::resolve(gl::barrier::command_e::pixel_unpack);
+        ::glTextureSubImage1D(
+            gl::to_underlying       (texture)                            , static_cast<gl::int32_t>(image_level)                      ,  
+            static_cast<gl::int32_t>(image_region.origin.x)              , static_cast<gl::sizei_t>(image_region.extent.x)            , 
+            gl::to_underlying       (texture_data_descriptor.base_format), gl::to_underlying       (texture_data_descriptor.data_type), 
+            reinterpret_cast<gl::void_t const*>(buffer_offset)          );
+    }
+    void texture_sub_image_2d                             (gl::handle_t texture, gl::uint32_t image_level, gl::rectangle image_region, gl::texture_data_descriptor texture_data_descriptor, gl::offset_t buffer_offset)
+    {
+        auto const pixel_unpack_buffer_binding = gl::get<gl::data_e::pixel_unpack_buffer_binding>();
+        if (pixel_unpack_buffer_binding == gl::null_object) throw std::runtime_error{ "no pixel unpack buffer bound" };
+        auto const image_width  = gl::get_texture_level_parameter<gl::texture_level_parameter_e::width >(texture, image_level);
+        auto const image_height = gl::get_texture_level_parameter<gl::texture_level_parameter_e::height>(texture, image_level);
+        if (image_region.origin.x + image_region.extent.x > image_width ) throw std::invalid_argument{ "region width exceeds image bounds" };
+        if (image_region.origin.y + image_region.extent.y > image_height) throw std::invalid_argument{ "region height exceeds image bounds" };
+
+        gl::barrier::resolve(gl::barrier::command_e::pixel_unpack);
+        ::glTextureSubImage2D(
+            gl::to_underlying       (texture)                            , static_cast<gl::int32_t>(image_level)                      , 
+            static_cast<gl::int32_t>(image_region.origin.x)              , static_cast<gl::int32_t>(image_region.origin.y)            , 
+            static_cast<gl::sizei_t>(image_region.extent.x)              , static_cast<gl::sizei_t>(image_region.extent.y)            , 
+            gl::to_underlying       (texture_data_descriptor.base_format), gl::to_underlying       (texture_data_descriptor.data_type), 
+            reinterpret_cast<gl::void_t const*>(buffer_offset)          );
+    }
+    void texture_sub_image_3d                             (gl::handle_t texture, gl::uint32_t image_level, gl::box       image_region, gl::texture_data_descriptor texture_data_descriptor, gl::offset_t buffer_offset)
+    {
+        auto const pixel_unpack_buffer_binding = gl::get<gl::data_e::pixel_unpack_buffer_binding>();
+        if (pixel_unpack_buffer_binding == gl::null_object) throw std::runtime_error{ "no pixel unpack buffer bound" };
+        auto const image_width  = gl::get_texture_level_parameter<gl::texture_level_parameter_e::width >(texture, image_level);
+        auto const image_height = gl::get_texture_level_parameter<gl::texture_level_parameter_e::height>(texture, image_level);
+        auto const image_depth  = gl::get_texture_level_parameter<gl::texture_level_parameter_e::depth >(texture, image_level);
+        if (image_region.origin.x + image_region.extent.x > image_width ) throw std::invalid_argument{ "region width exceeds image bounds"  };
+        if (image_region.origin.y + image_region.extent.y > image_height) throw std::invalid_argument{ "region height exceeds image bounds" };
+        if (image_region.origin.z + image_region.extent.z > image_depth ) throw std::invalid_argument{ "region depth exceeds image bounds"  };
+
+        gl::barrier::resolve(gl::barrier::command_e::pixel_unpack);
+        ::glTextureSubImage3D(
+            gl::to_underlying       (texture)                            , static_cast<gl::int32_t>(image_level)                      , 
+            static_cast<gl::int32_t>(image_region.origin.x)              , static_cast<gl::int32_t>(image_region.origin.y)            , static_cast<gl::int32_t>(image_region.origin.z), 
+            static_cast<gl::sizei_t>(image_region.extent.x)              , static_cast<gl::sizei_t>(image_region.extent.y)            , static_cast<gl::sizei_t>(image_region.extent.z), 
+            gl::to_underlying       (texture_data_descriptor.base_format), gl::to_underlying       (texture_data_descriptor.data_type), 
+            reinterpret_cast<gl::void_t const*>(buffer_offset)          );
     }
     void copy_texture_sub_image_1d                        (gl::handle_t texture, gl::uint32_t image_level, gl::line      image_region, gl::vector_2u coordinates)
     {
@@ -1367,7 +1542,7 @@ export namespace gl
             static_cast<gl::int32_t>(coordinates        .x), static_cast<gl::int32_t>(coordinates        .y) , 
             static_cast<gl::sizei_t>(image_region.extent.x), static_cast<gl::sizei_t>(image_region.extent.y));
     }
-    void compressed_texture_sub_image_1d                  (gl::handle_t texture, gl::uint32_t image_level, gl::line      image_region, gl::texture_compressed_base_format_e compressed_base_format, std::span<gl::byte_t const> memory)
+    void compressed_texture_sub_image_1d                  (gl::handle_t texture, gl::uint32_t image_level, gl::line      image_region, gl::texture_compressed_format_e compressed_format, std::span<gl::byte_t const> memory)
     {
         auto const image_width = gl::get_texture_level_parameter<gl::texture_level_parameter_e::width >(texture, image_level);
         if (image_region.origin.x + image_region.extent.x > image_width) throw std::invalid_argument{ "invalid image_region width" };
@@ -1375,10 +1550,11 @@ export namespace gl
         ::glCompressedTextureSubImage1D(
             gl::to_underlying       (texture)               , static_cast<gl::int32_t>(image_level)          , 
             static_cast<gl::int32_t>(image_region.origin.x) , static_cast<gl::sizei_t>(image_region.extent.x), 
-            gl::to_underlying       (compressed_base_format),
+            gl::to_underlying       (compressed_format),
             static_cast<gl::sizei_t>(memory.size())         , memory.data()                                 );
+        gl::trace::count_upload(memory.size_bytes());
     }
-    void compressed_texture_sub_image_2d                  (gl::handle_t texture, gl::uint32_t image_level, gl::rectangle image_region, gl::texture_compressed_base_format_e compressed_base_format, std::span<gl::byte_t const> memory)
+    void compressed_texture_sub_image_2d                  (gl::handle_t texture, gl::uint32_t image_level, gl::rectangle image_region, gl::texture_compressed_format_e compressed_format, std::span<gl::byte_t const> memory)
     {
         auto const image_width  = gl::get_texture_level_parameter<gl::texture_level_parameter_e::width >(texture, image_level);
         auto const image_height = gl::get_texture_level_parameter<gl::texture_level_parameter_e::height>(texture, image_level);
@@ -1389,10 +1565,11 @@ export namespace gl
             gl::to_underlying       (texture)               , static_cast<gl::int32_t>(image_level)          , 
             static_cast<gl::int32_t>(image_region.origin.x) , static_cast<gl::int32_t>(image_region.origin.y), 
             static_cast<gl::sizei_t>(image_region.extent.x) , static_cast<gl::sizei_t>(image_region.extent.y), 
-            gl::to_underlying       (compressed_base_format), 
+            gl::to_underlying       (compressed_format), 
             static_cast<gl::sizei_t>(memory.size())         , memory.data()                                 );
+        gl::trace::count_upload(memory.size_bytes());
     }
-    void compressed_texture_sub_image_3d                  (gl::handle_t texture, gl::uint32_t image_level, gl::box       image_region, gl::texture_compressed_base_format_e compressed_base_format, std::span<gl::byte_t const> memory)
+    void compressed_texture_sub_image_3d                  (gl::handle_t texture, gl::uint32_t image_level, gl::box       image_region, gl::texture_compressed_format_e compressed_format, std::span<gl::byte_t const> memory)
     {
         auto const image_width  = gl::get_texture_level_parameter<gl::texture_level_parameter_e::width >(texture, image_level);
         auto const image_height = gl::get_texture_level_parameter<gl::texture_level_parameter_e::height>(texture, image_level);
@@ -1405,8 +1582,9 @@ export namespace gl
             gl::to_underlying       (texture)               , static_cast<gl::int32_t>(image_level)          , 
             static_cast<gl::int32_t>(image_region.origin.x) , static_cast<gl::int32_t>(image_region.origin.y), static_cast<gl::int32_t>(image_region.origin.z), 
             static_cast<gl::sizei_t>(image_region.extent.x) , static_cast<gl::sizei_t>(image_region.extent.y), static_cast<gl::sizei_t>(image_region.extent.z), 
-            gl::to_underlying       (compressed_base_format),
+            gl::to_underlying       (compressed_format),
             static_cast<gl::sizei_t>(memory.size())         , memory.data()                                 );
+        gl::trace::count_upload(memory.size_bytes());
     }
     void texture_buffer                                   (gl::handle_t texture, gl::handle_t buffer, gl::buffer_format_e format)
     {
@@ -1545,13 +1723,16 @@ export namespace gl
     }
     void bind_image_texture                               (gl::handle_t texture, gl::uint32_t image_level, gl::bool_t is_layered, gl::uint32_t image_layer, gl::index_t image_unit, gl::image_format_e image_format, gl::image_access_e image_access)
     {
+        gl::barrier::current().bind_image(static_cast<gl::binding_t>(image_unit), texture, image_access);
         ::glBindImageTexture(
             static_cast<gl::uint32_t>(image_unit) , gl::to_underlying         (texture)     , 
             static_cast<gl::int32_t> (image_level), static_cast<gl::boolean_t>(is_layered)  , 
             static_cast<gl::int32_t> (image_layer), gl::to_underlying         (image_access), gl::to_underlying(image_format));
     }
-    void bind_image_textures                              (std::span<gl::handle_t const> textures, gl::index_range range)
+    //The units are bound for read and write access, the access declares how shaders use them
+    void bind_image_textures                              (std::span<gl::handle_t const> textures, gl::index_range range, gl::image_access_e image_access = gl::image_access_e::read_only)
     {
+        for (auto const [index, texture] : std::views::enumerate(textures)) gl::barrier::current().bind_image(static_cast<gl::binding_t>(range.index + index), texture, image_access);
         ::glBindImageTextures(static_cast<gl::uint32_t>(range.index), static_cast<gl::sizei_t>(range.count), gl::to_underlying_pointer(textures.data()));
     }
 
@@ -1574,14 +1755,17 @@ export namespace gl
     }
     void delete_frame_buffer                              (gl::handle_t frame_buffer)
     {
+        gl::cache::current().erase_frame_buffer(frame_buffer);
         ::glDeleteFramebuffers(gl::sizei_t{ 1 }, gl::to_underlying_pointer(&frame_buffer));
     }
     void delete_frame_buffers                             (std::span<gl::handle_t const> frame_buffers)
     {
+        for (auto const frame_buffer : frame_buffers) gl::cache::current().erase_frame_buffer(frame_buffer);
         ::glDeleteFramebuffers(static_cast<gl::sizei_t>(frame_buffers.size()), gl::to_underlying_pointer(frame_buffers.data()));
     }
     void bind_frame_buffer                                (gl::handle_t frame_buffer, gl::frame_buffer_target_e target)
     {
+        if (!gl::cache::current().update_frame_buffer(target, frame_buffer)) return;
         ::glBindFramebuffer(gl::to_underlying(target), gl::to_underlying(frame_buffer));
     }
     template<gl::frame_buffer_parameter_e parameter_v>
@@ -1729,20 +1913,28 @@ export namespace gl
     }
     void delete_vertex_array                              (gl::handle_t vertex_array)
     {
+        gl::cache::current().erase_vertex_array(vertex_array);
+        gl::barrier::current().erase_vertex_array(vertex_array);
         ::glDeleteVertexArrays(gl::sizei_t{ 1 }, gl::to_underlying_pointer(&vertex_array));
     }
     void delete_vertex_arrays                             (std::span<gl::handle_t const> vertex_arrays)
     {
+        for (auto const vertex_array : vertex_arrays) gl::cache::current().erase_vertex_array(vertex_array);
+        for (auto const vertex_array : vertex_arrays) gl::barrier::current().erase_vertex_array(vertex_array);
         ::glDeleteVertexArrays(static_cast<gl::sizei_t>(vertex_arrays.size()), gl::to_underlying_pointer(vertex_arrays.data()));
     }
     void bind_vertex_array                                (gl::handle_t vertex_array)
     {
+        gl::barrier::current().bind_vertex_array(vertex_array);
+        if (!gl::cache::current().update_vertex_array(vertex_array)) return;
         ::glBindVertexArray(gl::to_underlying(vertex_array));
     }
     void vertex_array_element_buffer                      (gl::handle_t vertex_array, gl::handle_t element_buffer)
     {
+        gl::barrier::current().attach_element_buffer(vertex_array, element_buffer);
         ::glVertexArrayElementBuffer(gl::to_underlying(vertex_array), gl::to_underlying(element_buffer));
     }
+    //Normalized integer attributes are read as floats, packed attributes can only be read as floats
     void vertex_array_attribute_format                    (gl::handle_t vertex_array, gl::vertex_array_attribute_type_e attribute_type, gl::index_t attribute_index, gl::count_t attribute_count, gl::ptrdiff_t byte_offset, gl::bool_t is_normalized = gl::false_)
     {
         switch (attribute_type)
@@ -1753,10 +1945,11 @@ export namespace gl
             case int16                     : 
             case uint16                    : 
             case int32                     : 
-            case uint32                    : 
+            case uint32                    : if (is_normalized) return legacy::vertex_array_attribute_format_float32(vertex_array, attribute_index, attribute_type, attribute_count, byte_offset, is_normalized);
+                                             else               return legacy::vertex_array_attribute_format_int32  (vertex_array, attribute_index, attribute_type, attribute_count, byte_offset               );
             case int32_2_10_10_10_r        : 
             case uint32_2_10_10_10_r       : 
-            case uint32_10_11_11_11_float_r: return legacy::vertex_array_attribute_format_int32  (vertex_array, attribute_index, attribute_type, attribute_count, byte_offset               );
+            case uint32_10_11_11_11_float_r: 
             case fixed                     : 
             case float16                   : 
             case float32                   : return legacy::vertex_array_attribute_format_float32(vertex_array, attribute_index, attribute_type, attribute_count, byte_offset, is_normalized);
@@ -1765,11 +1958,13 @@ export namespace gl
     }
     void vertex_array_vertex_buffer                       (gl::handle_t vertex_array, gl::handle_t vertex_buffer, gl::binding_t binding, gl::ptrdiff_t element_offset, gl::ptrdiff_t element_stride)
     {
+        gl::barrier::current().attach_vertex_buffer(vertex_array, binding, vertex_buffer);
         ::glVertexArrayVertexBuffer(gl::to_underlying(vertex_array), binding, gl::to_underlying(vertex_buffer), static_cast<gl::intptr_t>(element_offset), static_cast<gl::sizei_t>(element_stride));
     }
     void vertex_array_vertex_buffers                      (gl::handle_t vertex_array, std::span<gl::handle_t const> vertex_buffers, gl::index_t first_binding, std::span<gl::ptrdiff_t const> offsets, std::span<gl::uint32_t const> strides)
     {
         auto const count = std::min(strides.size(), offsets.size());
+        for (auto const [index, vertex_buffer] : std::views::enumerate(vertex_buffers | std::views::take(count))) gl::barrier::current().attach_vertex_buffer(vertex_array, static_cast<gl::binding_t>(first_binding + index), vertex_buffer);
         ::glVertexArrayVertexBuffers(
             gl::to_underlying        (vertex_array)         , 
             static_cast<gl::uint32_t>(first_binding)        , static_cast     <gl::sizei_t        >(count)         , 
@@ -1797,137 +1992,197 @@ export namespace gl
     }
     void draw_arrays                                      (gl::draw_mode_e draw_mode, gl::index_range range )
     {
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawArrays(
             gl::to_underlying       (draw_mode)  , 
             static_cast<gl::int32_t>(range.index), static_cast<gl::sizei_t>(range.count));
+        gl::barrier::current().submit();
     }
     void draw_arrays_indirect                             (gl::draw_mode_e draw_mode, gl::index_t     offset)
     {
         auto const draw_indirect_buffer_binding = gl::get<gl::data_e::draw_indirect_buffer_binding>();
         if (draw_indirect_buffer_binding == gl::null_object) throw std::runtime_error{ "no draw indirect buffer bound" };
 
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawArraysIndirect(
             gl::to_underlying                  (draw_mode)                                         , 
             reinterpret_cast<gl::void_t const*>(offset * sizeof(gl::draw_arrays_indirect_command)));
+        gl::barrier::current().submit();
     }
     void draw_arrays_instanced                            (gl::draw_mode_e draw_mode, gl::index_range range, gl::count_t instance_count)
     {
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawArraysInstanced(
             gl::to_underlying       (draw_mode)  , static_cast<gl::int32_t>(range.index)    , 
             static_cast<gl::sizei_t>(range.count), static_cast<gl::sizei_t>(instance_count));
+        gl::barrier::current().submit();
     }
     void draw_arrays_instanced_base_instance              (gl::draw_mode_e draw_mode, gl::index_range range, gl::index_t base_instance, gl::count_t instance_count)
     {
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawArraysInstancedBaseInstance(
             gl::to_underlying       (draw_mode)  , static_cast<gl::int32_t>(range.index)   , 
             static_cast<gl::sizei_t>(range.count), static_cast<gl::sizei_t>(instance_count), static_cast<gl::uint32_t>(base_instance));
+        gl::barrier::current().submit();
     }
     void draw_elements                                    (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::count_t element_count, gl::index_t offset)
     {
         auto const draw_type_size = gl::map_draw_type_size(draw_type);
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawElements(
             gl::to_underlying(draw_mode), static_cast     <gl::sizei_t      >(element_count)           , 
             gl::to_underlying(draw_type), reinterpret_cast<gl::void_t const*>(offset * draw_type_size));
+        gl::barrier::current().submit();
     }
     void draw_elements_base_vertex                        (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::count_t element_count, gl::index_t offset, gl::int32_t base_vertex)
     {
         auto const draw_type_size = gl::map_draw_type_size(draw_type);
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawElementsBaseVertex(
             gl::to_underlying(draw_mode), static_cast     <gl::sizei_t      >(element_count)          , 
             gl::to_underlying(draw_type), reinterpret_cast<gl::void_t const*>(offset * draw_type_size), base_vertex);
+        gl::barrier::current().submit();
     }
     void draw_elements_indirect                           (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::index_t offset)
     {
         auto const draw_indirect_buffer_binding = gl::get<gl::data_e::draw_indirect_buffer_binding>();
         if (draw_indirect_buffer_binding == gl::null_object) throw std::runtime_error{ "no draw indirect buffer bound" };
 
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawElementsIndirect(
             gl::to_underlying                  (draw_mode)                                           , gl::to_underlying(draw_type), 
             reinterpret_cast<gl::void_t const*>(offset * sizeof(gl::draw_elements_indirect_command)));
+        gl::barrier::current().submit();
     }
     void draw_elements_instanced                          (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::count_t element_count, gl::index_t offset, gl::count_t instance_count)
     {
         auto const draw_type_size = gl::map_draw_type_size(draw_type);
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawElementsInstanced(
             gl::to_underlying(draw_mode),                                                               static_cast<gl::sizei_t>(element_count ) , 
             gl::to_underlying(draw_type), reinterpret_cast<gl::void_t const*>(offset * draw_type_size), static_cast<gl::sizei_t>(instance_count));
+        gl::barrier::current().submit();
     }
     void draw_elements_instanced_base_instance            (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::count_t element_count, gl::index_t offset, gl::count_t instance_count, gl::index_t base_instance)
     {
         auto const draw_type_size = gl::map_draw_type_size(draw_type);
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawElementsInstancedBaseInstance(
             gl::to_underlying(draw_mode),                                                               static_cast<gl::sizei_t>(element_count) , 
             gl::to_underlying(draw_type), reinterpret_cast<gl::void_t const*>(offset * draw_type_size), static_cast<gl::sizei_t>(instance_count), static_cast<gl::uint32_t>(base_instance));
+        gl::barrier::current().submit();
     }
     void draw_elements_instanced_base_vertex              (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::count_t element_count, gl::index_t offset, gl::count_t instance_count, gl::int32_t base_vertex)
     {
         auto const draw_type_size = gl::map_draw_type_size(draw_type);
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawElementsInstancedBaseVertex(
             gl::to_underlying(draw_mode),                                                               static_cast<gl::sizei_t>(element_count) , 
             gl::to_underlying(draw_type), reinterpret_cast<gl::void_t const*>(offset * draw_type_size), static_cast<gl::sizei_t>(instance_count), base_vertex);
+        gl::barrier::current().submit();
     }
     void draw_elements_instanced_base_vertex_base_instance(gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::count_t element_count, gl::index_t offset, gl::count_t instance_count, gl::int32_t base_vertex, gl::index_t base_instance)
     {
         auto const draw_type_size = gl::map_draw_type_size(draw_type);
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawElementsInstancedBaseVertexBaseInstance(
             gl::to_underlying(draw_mode),                                                               static_cast<gl::sizei_t>(element_count) , 
             gl::to_underlying(draw_type), reinterpret_cast<gl::void_t const*>(offset * draw_type_size), static_cast<gl::sizei_t>(instance_count), base_vertex, static_cast<gl::uint32_t>(base_instance));
+        gl::barrier::current().submit();
     }
     void draw_range_elements                              (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::index_t start_index, gl::index_t end_index, gl::count_t element_count, gl::index_t offset)
     {
         auto const draw_type_size = gl::map_draw_type_size(draw_type);
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawRangeElements(
             gl::to_underlying        (draw_mode)    , 
             static_cast<gl::uint32_t>(start_index)  , static_cast<gl::uint32_t>(end_index), 
             static_cast<gl::sizei_t >(element_count), gl::to_underlying        (draw_type), reinterpret_cast<gl::void_t const*>(offset * draw_type_size));
+        gl::barrier::current().submit();
     }
     void draw_range_elements_base_vertex                  (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::index_t start_index, gl::index_t end_index, gl::count_t element_count, gl::index_t offset, gl::int32_t base_vertex)
     {
         auto const draw_type_size = gl::map_draw_type_size(draw_type);
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glDrawRangeElementsBaseVertex(
             gl::to_underlying        (draw_mode)    , 
             static_cast<gl::uint32_t>(start_index)  , static_cast<gl::uint32_t>(end_index), 
             static_cast<gl::sizei_t >(element_count), gl::to_underlying        (draw_type), reinterpret_cast<gl::void_t const*>(offset * draw_type_size), base_vertex);
+        gl::barrier::current().submit();
     }
     void multi_draw_arrays                                (gl::draw_mode_e draw_mode, std::span<const gl::index_t> starting_indices, std::span<const gl::count_t> vertex_counts)
     {
         auto const draw_count = std::min(starting_indices.size(), vertex_counts.size());
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glMultiDrawArrays(
             gl::to_underlying                   (draw_mode)           , reinterpret_cast<gl::int32_t const*>(starting_indices.data()), 
             reinterpret_cast<gl::sizei_t const*>(vertex_counts.data()), static_cast     <gl::sizei_t       >(draw_count)            );
+        gl::barrier::current().submit();
     }
     void multi_draw_arrays_indirect                       (gl::draw_mode_e draw_mode, gl::count_t draw_count, gl::index_t offset)
     {
         auto const draw_indirect_buffer_binding = gl::get<gl::data_e::draw_indirect_buffer_binding>();
         if (draw_indirect_buffer_binding == gl::null_object) throw std::runtime_error{ "no draw indirect buffer bound" };
 
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glMultiDrawArraysIndirect(
             gl::to_underlying                  (draw_mode)                                        , 
             reinterpret_cast<gl::void_t const*>(offset * sizeof(gl::draw_arrays_indirect_command)), 
             static_cast     <gl::sizei_t      >(draw_count)                                       , gl::sizei_t{ 0 });
+        gl::barrier::current().submit();
     }
     void multi_draw_elements                              (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, std::span<gl::count_t const> element_counts, std::span<gl::index_t const> index_offsets)
     {
         auto const draw_count     = std::min(element_counts.size(), index_offsets.size());
         auto const offset_pointer = index_offsets.data();
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glMultiDrawElements(
             gl::to_underlying(draw_mode), reinterpret_cast<gl::sizei_t const*       >(element_counts.data()), 
             gl::to_underlying(draw_type), reinterpret_cast<gl::void_t  const* const*>(&offset_pointer)      , static_cast<gl::sizei_t>(draw_count));
+        gl::barrier::current().submit();
     }
     void multi_draw_elements_indirect                     (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::count_t draw_count, gl::index_t offset)
     {
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glMultiDrawElementsIndirect(
             gl::to_underlying                  (draw_mode)                                          , gl::to_underlying       (draw_type) , 
             reinterpret_cast<gl::void_t const*>(offset * sizeof(gl::draw_elements_indirect_command)), static_cast<gl::sizei_t>(draw_count), gl::sizei_t{ 0 });
+        gl::barrier::current().submit();
+    }
+    void multi_draw_arrays_indirect_count                 (gl::draw_mode_e draw_mode,                            gl::index_t offset, gl::offset_t draw_count_offset, gl::count_t maximum_draw_count)
+    {
+        auto const parameter_buffer_binding = gl::get<gl::data_e::parameter_buffer_binding>();
+        if (parameter_buffer_binding == gl::null_object) throw std::runtime_error{ "no parameter buffer bound" };
+
+        gl::barrier::resolve(gl::barrier::command_e::draw);
+        ::glMultiDrawArraysIndirectCount(
+            gl::to_underlying                  (draw_mode)                                        , 
+            reinterpret_cast<gl::void_t const*>(offset * sizeof(gl::draw_arrays_indirect_command)), 
+            static_cast     <gl::intptr_t     >(draw_count_offset)                                , static_cast<gl::sizei_t>(maximum_draw_count), gl::sizei_t{ 0 });
+        gl::barrier::current().submit();
+    }
+    void multi_draw_elements_indirect_count               (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, gl::index_t offset, gl::offset_t draw_count_offset, gl::count_t maximum_draw_count)
+    {
+        auto const parameter_buffer_binding = gl::get<gl::data_e::parameter_buffer_binding>();
+        if (parameter_buffer_binding == gl::null_object) throw std::runtime_error{ "no parameter buffer bound" };
+
+        gl::barrier::resolve(gl::barrier::command_e::draw);
+        ::glMultiDrawElementsIndirectCount(
+            gl::to_underlying                  (draw_mode)                                          , gl::to_underlying(draw_type)                 , 
+            reinterpret_cast<gl::void_t const*>(offset * sizeof(gl::draw_elements_indirect_command)), 
+            static_cast     <gl::intptr_t     >(draw_count_offset)                                  , static_cast<gl::sizei_t>(maximum_draw_count), gl::sizei_t{ 0 });
+        gl::barrier::current().submit();
     }
     void multi_draw_elements_base_vertex                  (gl::draw_mode_e draw_mode, gl::draw_type_e draw_type, std::span<gl::count_t const> element_counts, std::span<gl::index_t const> index_offsets, std::span<gl::int32_t const> base_vertex_offsets)
     {
         auto const draw_count     = std::min(std::min(element_counts.size(), index_offsets.size()), base_vertex_offsets.size());
         auto const offset_pointer = index_offsets.data();
+        gl::barrier::resolve(gl::barrier::command_e::draw);
         ::glMultiDrawElementsBaseVertex(
             gl::to_underlying       (draw_mode) , reinterpret_cast<gl::sizei_t const*       >(element_counts.data())     , 
             gl::to_underlying       (draw_type) , reinterpret_cast<gl::void_t  const* const*>(&offset_pointer)           , 
             static_cast<gl::sizei_t>(draw_count),                                             base_vertex_offsets.data());
+        gl::barrier::current().submit();
     }
     void begin_conditional_render                         (gl::handle_t query, gl::query_mode_e query_mode)
     {
@@ -1975,14 +2230,17 @@ export namespace gl
     }
     void viewport_array_value                             (gl::index_t index, std::span<gl::vector_2f const> ranges)
     {
+        gl::cache::current().forget_viewport();
         ::glViewportArrayv(static_cast<gl::uint32_t>(index), static_cast<gl::sizei_t>(ranges.size()), gl::value_pointer(*ranges.data()));
     }
     void viewport_indexed                                 (gl::index_t index, gl::region<gl::float32_t, 2u> region)
     {
+        gl::cache::current().forget_viewport();
         ::glViewportIndexedf(static_cast<gl::uint32_t>(index), region.origin.x, region.origin.y, region.extent.x, region.extent.y);
     }
     void viewport                                         (gl::rectangle region)
     {
+        if (!gl::cache::current().update_viewport(region)) return;
         ::glViewport(
             static_cast<gl::int32_t>(region.origin.x), static_cast<gl::int32_t>(region.origin.y) , 
             static_cast<gl::sizei_t>(region.extent.x), static_cast<gl::sizei_t>(region.extent.y));
@@ -2169,6 +2427,7 @@ export namespace gl
     }
     void clear_color                                      (gl::vector_4f color)
     {
+        if (!gl::cache::current().update_clear_color(color)) return;
         ::glClearColor(color.r, color.g, color.b, color.a);
     }
     void clear_depth                                      (gl::float32_t depth)
@@ -2260,14 +2519,29 @@ export namespace gl
         auto const required_size   = region.extent.x * region.extent.y * bytes_per_pixel;
         auto       vector          = std::vector<element_t>(required_size / sizeof(element_t));
 
-        glReadnPixels(
+        ::glReadnPixels(
             static_cast<gl::int32_t>(region.origin.x), static_cast<gl::int32_t>(region.origin.y), 
             static_cast<gl::sizei_t>(region.extent.x), static_cast<gl::sizei_t>(region.extent.y), 
             gl::to_underlying       (format)         , gl::to_underlying       (type)           , 
             static_cast<gl::sizei_t>(required_size)  , vector.data()                           );
+        gl::trace::count_sync    ();
+        gl::trace::count_download(required_size);
         
         return vector;
     }
+    //Writes the pixels into the bound pixel pack buffer and returns without waiting for them, the offset is in bytes
+    void read_pixels                                      (gl::rectangle region, gl::pixel_data_format_e format, gl::pixel_data_type_e type, gl::offset_t buffer_offset, gl::size_t buffer_size)
+    {
+        auto const pixel_pack_buffer_binding = gl::get<gl::data_e::pixel_pack_buffer_binding>();
+        if (pixel_pack_buffer_binding == gl::null_object) throw std::runtime_error{ "no pixel pack buffer bound" };
+
+        gl::barrier::resolve(gl::barrier::command_e::pixel_pack);
+        ::glReadnPixels(
+            static_cast<gl::int32_t>(region.origin.x), static_cast<gl::int32_t>(region.origin.y), 
+            static_cast<gl::sizei_t>(region.extent.x), static_cast<gl::sizei_t>(region.extent.y), 
+            gl::to_underlying       (format)         , gl::to_underlying       (type)           , 
+            static_cast<gl::sizei_t>(buffer_size)    , reinterpret_cast<gl::void_t*>(buffer_offset));
+    }
     void clamp_color                                      (gl::bool_t value)
     {
         ::glClampColor(gl::to_underlying(gl::clamp_color_e::read), value);
@@ -2296,11 +2570,15 @@ export namespace gl
     //Chapter 19 - Compute Shaders
     void dispatch_compute                                 (gl::vector_3u work_groups)
     {
+        gl::barrier::resolve(gl::barrier::command_e::dispatch);
         ::glDispatchCompute(work_groups.x, work_groups.y, work_groups.z);
+        gl::barrier::current().submit();
     }
     void dispatch_compute_indirect                        (gl::index_t   offset     )
     {
+        gl::barrier::resolve(gl::barrier::command_e::dispatch);
         ::glDispatchComputeIndirect(static_cast<gl::intptr_t>(offset * sizeof(gl::dispatch_indirect_command)));
+        gl::barrier::current().submit();
     }
 
 
@@ -0,0 +1,170 @@
+export module chroma_gl:thread.thread_pool;
+
+import std;
+import opengl;
+
+export namespace gl
+{
+    //Work stealing pool, every thread owns a queue of chunks it drains from the back while idle threads steal from the front
+    //The thread that calls parallel_for works on its own queue until the range is done, a pool of one thread runs everything on the caller
+    //parallel_for may only be called by one thread at a time and not from within a chunk
+    class thread_pool
+    {
+    public:
+        explicit
+        thread_pool(gl::count_t thread_count = std::max(std::thread::hardware_concurrency(), 1u))
+            : queues_{}, pending_{ 0u }, mutex_{}, condition_{}, workers_{}
+        {
+            if (thread_count == gl::count_t{ 0u }) throw std::invalid_argument{ "thread count must be greater than zero" };
+
+            queues_.reserve(thread_count);
+            for (auto index = gl::index_t{ 0u }; index < thread_count; ++index) queues_.emplace_back(std::make_unique<queue>());
+
+            workers_.reserve(thread_count - 1u);
+            for (auto index = gl::index_t{ 1u }; index < thread_count; ++index)
+            {
+                workers_.emplace_back([this, index](std::stop_token stop_token) { work_(stop_token, index); });
+            }
+        }
+       ~thread_pool()
+        {
+            std::ranges::for_each(workers_, [](std::jthread& worker) { worker.request_stop(); });
+            workers_.clear();
+        }
+
+        //Splits the range into chunks of at most grain_size elements and invokes the function with each chunk's index range
+        //The first exception a chunk throws is rethrown on the caller once every chunk has finished, chunks that have not started by then are skipped
+        template<typename function_t>
+        void parallel_for(gl::count_t count, gl::count_t grain_size, function_t&& function)
+        {
+            if (count      == gl::count_t{ 0u }) return;
+            if (grain_size == gl::count_t{ 0u }) throw std::invalid_argument{ "grain size must be greater than zero" };
+
+            auto const chunk_count = (count + grain_size - 1u) / grain_size;
+            auto       current     = job
+            {
+                .context   = const_cast<std::remove_cvref_t<function_t>*>(std::addressof(function)),
+                .invoke    = [](gl::void_t* context, gl::index_range range) { std::invoke(*static_cast<std::remove_reference_t<function_t>*>(context), range); },
+                .remaining = chunk_count,
+                .is_failed = {},
+                .exception = {},
+            };
+
+            //Consecutive chunks go to the same queue, a thread that is not stolen from walks its part of the range in order
+            for (auto thread = gl::index_t{ 0u }; thread < queues_.size(); ++thread)
+            {
+                auto const first = chunk_count *  thread       / queues_.size();
+                auto const last  = chunk_count * (thread + 1u) / queues_.size();
+                if (first == last) continue;
+
+                auto const lock = std::scoped_lock{ queues_[thread]->mutex };
+                for (auto chunk = first; chunk < last; ++chunk)
+                {
+                    auto const index = chunk * grain_size;
+                    queues_[thread]->tasks.emplace_back(std::addressof(current), gl::index_range{ index, std::min(grain_size, count - index) });
+                }
+            }
+            {
+                auto const lock = std::scoped_lock{ mutex_ };
+                pending_.fetch_add(chunk_count, std::memory_order_relaxed);
+            }
+            condition_.notify_all();
+
+            while (current.remaining.load(std::memory_order_acquire) != gl::count_t{ 0u })
+            {
+                if (!try_run_(gl::index_t{ 0u })) std::this_thread::yield();
+            }
+
+            if (current.exception) std::rethrow_exception(current.exception);
+        }
+
+        auto thread_count() const -> gl::count_t
+        {
+            return queues_.size();
+        }
+
+    private:
+        struct job
+        {
+            gl::void_t*              context;
+            void                   (*invoke)(gl::void_t*, gl::index_range);
+            std::atomic<gl::count_t> remaining;
+            std::atomic_flag         is_failed;
+            std::exception_ptr       exception;
+        };
+        struct task
+        {
+            job*            owner;
+            gl::index_range range;
+        };
+        struct queue
+        {
+            std::mutex       mutex;
+            std::deque<task> tasks;
+        };
+
+        auto take_   (gl::index_t thread) -> std::optional<task>
+        {
+            {
+                auto const lock = std::scoped_lock{ queues_[thread]->mutex };
+                if (!queues_[thread]->tasks.empty())
+                {
+                    auto const result = queues_[thread]->tasks.back();
+                    queues_[thread]->tasks.pop_back();
+                    return result;
+                }
+            }
+            for (auto offset = gl::index_t{ 1u }; offset < queues_.size(); ++offset)
+            {
+                auto&      victim = *queues_[(thread + offset) % queues_.size()];
+                auto const lock   = std::scoped_lock{ victim.mutex };
+                if (victim.tasks.empty()) continue;
+
+                auto const result = victim.tasks.front();
+                victim.tasks.pop_front();
+                return result;
+            }
+
+            return std::nullopt;
+        }
+        auto try_run_(gl::index_t thread) -> gl::bool_t
+        {
+            auto const current = take_(thread);
+            if (!current) return gl::false_;
+
+            //The exception is published to the caller by the release on remaining
+            auto& owner = *current->owner;
+            pending_.fetch_sub(1u, std::memory_order_relaxed);
+            if (!owner.is_failed.test(std::memory_order_relaxed))
+            {
+                try
+                {
+                    owner.invoke(owner.context, current->range);
+                }
+                catch (...)
+                {
+                    if (!owner.is_failed.test_and_set(std::memory_order_relaxed)) owner.exception = std::current_exception();
+                }
+            }
+            owner.remaining.fetch_sub(1u, std::memory_order_acq_rel);
+
+            return gl::true_;
+        }
+        void work_   (std::stop_token stop_token, gl::index_t thread)
+        {
+            while (!stop_token.stop_requested())
+            {
+                if (try_run_(thread)) continue;
+
+                auto lock = std::unique_lock{ mutex_ };
+                condition_.wait(lock, stop_token, [this] { return pending_.load(std::memory_order_relaxed) != gl::count_t{ 0u }; });
+            }
+        }
+
+        std::vector<std::unique_ptr<queue>> queues_;
+        std::atomic<gl::count_t>            pending_;
+        std::mutex                          mutex_;
+        std::condition_variable_any         condition_;
+        std::vector<std::jthread>           workers_;
+    };
+}
@@ -0,0 +1,240 @@
+module;
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+    #define TRANSFORM_SSE2
+    #include <emmintrin.h>
+#endif
+
+export module chroma_gl:transform.transform_system;
+
+import std;
+import glm;
+import opengl;
+import :camera;
+import :thread.thread_pool;
+import :transform;
+
+namespace gl
+{
+    auto compose (gl::vector_3f const& position, gl::quaternion_4f const& rotation, gl::vector_3f const& scale) -> gl::matrix_4f
+    {
+        auto const rotation_matrix = glm::mat3_cast(rotation);
+        return gl::matrix_4f
+        {
+            gl::vector_4f{ rotation_matrix[0] * scale.x, 0.0f },
+            gl::vector_4f{ rotation_matrix[1] * scale.y, 0.0f },
+            gl::vector_4f{ rotation_matrix[2] * scale.z, 0.0f },
+            gl::vector_4f{ position                    , 1.0f },
+        };
+    }
+    //Every column of the result is a sum of the four columns of the parent, weighted by the components of the child's column
+    void multiply(gl::matrix_4f const& parent, gl::matrix_4f const& child, gl::matrix_4f& result)
+    {
+#if defined(TRANSFORM_SSE2)
+        auto const columns = std::array{ _mm_loadu_ps(&parent[0][0]), _mm_loadu_ps(&parent[1][0]), _mm_loadu_ps(&parent[2][0]), _mm_loadu_ps(&parent[3][0]) };
+        for (auto column = gl::index_t{ 0u }; column < 4u; ++column)
+        {
+            auto sum = _mm_mul_ps(columns[0], _mm_set1_ps(child[column][0]));
+            sum      = _mm_add_ps(sum, _mm_mul_ps(columns[1], _mm_set1_ps(child[column][1])));
+            sum      = _mm_add_ps(sum, _mm_mul_ps(columns[2], _mm_set1_ps(child[column][2])));
+            sum      = _mm_add_ps(sum, _mm_mul_ps(columns[3], _mm_set1_ps(child[column][3])));
+            _mm_storeu_ps(&result[column][0], sum);
+        }
+#else
+        result = parent * child;
+#endif
+    }
+}
+export namespace gl
+{
+    //Axis aligned box in the local space of a transform, culling tests its bounding sphere first and the box only when the sphere straddles a plane
+    struct bounds
+    {
+        gl::vector_3f center = gl::vector_3f{ 0.0f };
+        gl::vector_3f extent = gl::vector_3f{ 0.5f };
+    };
+
+    //Transforms stored as one array per component, world matrices are only recomposed when a transform or one of its ancestors changed
+    //Parents have to be created before their children, every level of the hierarchy is then composed in parallel after the level above it
+    class transform_system
+    {
+    public:
+        using id_t = gl::uint32_t;
+
+        static auto constexpr no_parent = std::numeric_limits<id_t>::max();
+
+        explicit
+        transform_system(gl::count_t capacity = 0u)
+            : positions_{}, rotations_{}, scales_{}, centers_{}, extents_{}, parents_{}, depths_{}, is_dirty_{}, is_changed_{}, worlds_{}, levels_{}
+        {
+            positions_ .reserve(capacity);
+            rotations_ .reserve(capacity);
+            scales_    .reserve(capacity);
+            centers_   .reserve(capacity);
+            extents_   .reserve(capacity);
+            parents_   .reserve(capacity);
+            depths_    .reserve(capacity);
+            is_dirty_  .reserve(capacity);
+            is_changed_.reserve(capacity);
+            worlds_    .reserve(capacity);
+        }
+
+        auto create(gl::transform const& transform = {}, gl::bounds const& bounds = {}, id_t parent = no_parent) -> id_t
+        {
+            if (parent != no_parent && parent >= count()) throw std::out_of_range{ "parent does not exist" };
+
+            auto const id    = static_cast<id_t>(count());
+            auto const depth = parent == no_parent ? gl::uint32_t{ 0u } : depths_[parent] + 1u;
+
+            positions_ .emplace_back(gl::vector_3f{ transform.position });
+            rotations_ .emplace_back(transform.rotation);
+            scales_    .emplace_back(gl::vector_3f{ transform.scale    });
+            centers_   .emplace_back(bounds.center);
+            extents_   .emplace_back(bounds.extent);
+            parents_   .emplace_back(parent);
+            depths_    .emplace_back(depth);
+            is_dirty_  .emplace_back(gl::true_ );
+            is_changed_.emplace_back(gl::false_);
+            worlds_    .emplace_back(1.0f);
+
+            if (depth >= levels_.size()) levels_.resize(depth + 1u);
+            levels_[depth].emplace_back(id);
+
+            return id;
+        }
+
+        void set_position(id_t id, gl::vector_3f     const& position)
+        {
+            positions_.at(id) = position;
+            is_dirty_    [id] = gl::true_;
+        }
+        void set_rotation(id_t id, gl::quaternion_4f const& rotation)
+        {
+            rotations_.at(id) = rotation;
+            is_dirty_    [id] = gl::true_;
+        }
+        void set_scale   (id_t id, gl::vector_3f     const& scale   )
+        {
+            scales_   .at(id) = scale;
+            is_dirty_    [id] = gl::true_;
+        }
+        void set_bounds  (id_t id, gl::bounds        const& bounds  )
+        {
+            centers_  .at(id) = bounds.center;
+            extents_     [id] = bounds.extent;
+        }
+
+        //Composes the world matrices of changed transforms, static transforms are skipped after their first update
+        void update(gl::thread_pool& thread_pool, gl::count_t grain_size = 4096u)
+        {
+            for (auto const& level : levels_)
+            {
+                thread_pool.parallel_for(level.size(), grain_size, [&](gl::index_range range)
+                    {
+                        for (auto index = range.index; index < range.index + range.count; ++index)
+                        {
+                            auto const id         = level[index];
+                            auto const parent     = parents_[id];
+                            auto const is_changed = is_dirty_[id] || (parent != no_parent && is_changed_[parent]);
+                            is_changed_[id]       = is_changed;
+                            if (!is_changed) continue;
+
+                            is_dirty_[id]         = gl::false_;
+                            auto const local      = gl::compose(positions_[id], rotations_[id], scales_[id]);
+                            if   (parent == no_parent) worlds_[id] = local;
+                            else gl::multiply(worlds_[parent], local, worlds_[id]);
+                        }
+                    });
+            }
+        }
+        //Writes the world matrices of the transforms inside the frustum to the instances and returns how many were written
+        //Meant for the mapped range of a stream buffer, chunks claim their output with one atomic add so the order differs between calls
+        auto cull  (gl::frustum const& frustum, std::span<gl::matrix_4f> instances, gl::thread_pool& thread_pool, gl::count_t grain_size = 4096u) const -> gl::count_t
+        {
+            auto written = std::atomic<gl::count_t>{ 0u };
+            thread_pool.parallel_for(count(), grain_size, [&](gl::index_range range)
+                {
+                    auto       visible       = std::array<id_t, 256u>{};
+                    auto       visible_count = gl::count_t{ 0u };
+                    auto const flush         = [&]
+                        {
+                            auto const offset = written.fetch_add(visible_count, std::memory_order_relaxed);
+                            for (auto index = gl::index_t{ 0u }; index < visible_count && offset + index < instances.size(); ++index) instances[offset + index] = worlds_[visible[index]];
+                            visible_count = 0u;
+                        };
+
+                    for (auto id = static_cast<id_t>(range.index); id < range.index + range.count; ++id)
+                    {
+                        if (!is_visible_(frustum, id)) continue;
+
+                        visible[visible_count++] = id;
+                        if (visible_count == visible.size()) flush();
+                    }
+                    if (visible_count != 0u) flush();
+                });
+
+            return std::min(written.load(std::memory_order_relaxed), instances.size());
+        }
+
+        auto position    (id_t id) const -> gl::vector_3f     const&
+        {
+            return positions_.at(id);
+        }
+        auto rotation    (id_t id) const -> gl::quaternion_4f const&
+        {
+            return rotations_.at(id);
+        }
+        auto scale       (id_t id) const -> gl::vector_3f     const&
+        {
+            return scales_.at(id);
+        }
+        auto parent      (id_t id) const -> id_t
+        {
+            return parents_.at(id);
+        }
+        auto world_matrix(id_t id) const -> gl::matrix_4f     const&
+        {
+            return worlds_.at(id);
+        }
+        auto count       ()        const -> gl::count_t
+        {
+            return positions_.size();
+        }
+
+    private:
+        auto is_visible_(gl::frustum const& frustum, id_t id) const -> gl::bool_t
+        {
+            auto const& world     = worlds_[id];
+            auto const  axes      = std::array{ gl::vector_3f{ world[0] }, gl::vector_3f{ world[1] }, gl::vector_3f{ world[2] } };
+            auto const  center    = gl::vector_3f{ world * gl::vector_4f{ centers_[id], 1.0f } };
+            auto const  scale     = std::max({ glm::length(axes[0]), glm::length(axes[1]), glm::length(axes[2]) });
+            auto const  radius    = glm::length(extents_[id]) * scale;
+            auto        is_inside = gl::true_;
+            for (auto const& plane : frustum.planes)
+            {
+                auto const distance = glm::dot(gl::vector_3f{ plane }, center) + plane.w;
+                if (distance < -radius) return gl::false_;
+                if (distance <  radius) is_inside = gl::false_;
+            }
+            if (is_inside) return gl::true_;
+
+            auto const extent = glm::abs(axes[0]) * extents_[id].x + glm::abs(axes[1]) * extents_[id].y + glm::abs(axes[2]) * extents_[id].z;
+            return std::ranges::none_of(frustum.planes, [&](gl::vector_4f const& plane)
+                {
+                    return glm::dot(gl::vector_3f{ plane }, center) + plane.w + glm::dot(glm::abs(gl::vector_3f{ plane }), extent) < 0.0f;
+                });
+        }
+
+        std::vector<gl::vector_3f>             positions_;
+        std::vector<gl::quaternion_4f>         rotations_;
+        std::vector<gl::vector_3f>             scales_;
+        std::vector<gl::vector_3f>             centers_;
+        std::vector<gl::vector_3f>             extents_;
+        std::vector<id_t>                      parents_;
+        std::vector<gl::uint32_t>              depths_;
+        std::vector<gl::uint8_t>               is_dirty_;
+        std::vector<gl::uint8_t>               is_changed_;
+        std::vector<gl::matrix_4f>             worlds_;
+        std::vector<std::vector<id_t>>         levels_;
+    };
+}
@@ -4,9 +4,13 @@ set "ROOT=%~dp0"
 set "PREMAKE=%ROOT%tools\premake5\premake5.exe"
 set "PREMAKE_FILE=%ROOT%premake5.lua"
 set "SANDBOX_FLAG="
+set "BENCHMARKS_FLAG="
+set "TRACE_FLAG="
 
-if /i "%~1"=="-s" (
-    set "SANDBOX_FLAG=--sandbox"
+for %%A in (%*) do (
+    if /i "%%~A"=="-s" set "SANDBOX_FLAG=--sandbox"
+    if /i "%%~A"=="-b" set "BENCHMARKS_FLAG=--benchmarks"
+    if /i "%%~A"=="-t" set "TRACE_FLAG=--trace"
 )
 
 if not exist "%PREMAKE%" (
@@ -15,5 +19,5 @@ if not exist "%PREMAKE%" (
     exit /b 1
 )
 
-call "%PREMAKE%" --file="%PREMAKE_FILE%" %SANDBOX_FLAG% vs2026
+call "%PREMAKE%" --file="%PREMAKE_FILE%" %SANDBOX_FLAG% %BENCHMARKS_FLAG% %TRACE_FLAG% vs2026
 exit /b %ERRORLEVEL%
\ No newline at end of file
@@ -2,6 +2,14 @@ newoption {
     trigger     = "sandbox",
     description = "Build the sandbox project"
 }
+newoption {
+    trigger     = "benchmarks",
+    description = "Build the headless benchmarks project"
+}
+newoption {
+    trigger     = "trace",
+    description = "Enable the call tracing and counting layer of the opengl module"
+}
 
 workspace "chroma-gl"
     architecture   "x86_64"
@@ -36,6 +44,9 @@ include "chroma-gl"
 if _OPTIONS["sandbox"] then
     include "sandbox"
 end
+if _OPTIONS["benchmarks"] then
+    include "benchmarks"
+end
 
 if not premake._moduleOutputOverrideApplied then
     premake._moduleOutputOverrideApplied = true
@@ -0,0 +1,65 @@
+#pragma once
+
+import std;
+import chroma_gl;
+import rgfw;
+
+static inline void atlas()
+{
+    //Hidden window, the atlas only needs a context
+    auto const window_dimensions      = rgfw::vector_2u{ 1u, 1u };
+    auto       window                 = rgfw::window{ "atlas", window_dimensions, rgfw::window::flags_e::none, rgfw::window::display_mode_e::windowed, rgfw::false_ };
+
+    //Four levels place images on an 8 texel grid with an 8 texel gutter at the base level, one texel on the smallest
+    auto       texture_atlas          = gl::texture_atlas{ gl::texture_2d_array::format_e::rgba_uint8_n, gl::vector_2u{ 1024u, 1024u }, 1u, 4u, 4u, 1u };
+    auto       random                 = std::mt19937{ 42u };
+    auto       size_distribution      = std::uniform_int_distribution<gl::uint32_t>{ 8u, 96u };
+    auto const create_image           = [&](gl::uint32_t seed)
+        {
+            auto const dimensions = gl::vector_2u{ size_distribution(random), size_distribution(random) };
+            auto       memory     = std::vector<gl::byte_t>(static_cast<gl::size_t>(dimensions.x) * dimensions.y * 4u);
+            for (auto index = gl::size_t{ 0u }; index < memory.size(); ++index) memory[index] = static_cast<gl::byte_t>((index / 4u + seed) * (index % 4u + 1u));
+
+            return gl::image{ gl::image::format_e::rgba_uint8, dimensions, std::move(memory) };
+        };
+
+    //Every frame inserts a few images and uses a sliding window of the most recent ones, older images fall out of use and get evicted
+    auto const frame_count            = gl::count_t{ 600u };
+    auto const working_set            = gl::count_t{ 256u };
+    auto       ids                    = std::deque<gl::texture_atlas::id_t>{};
+    auto       rejected               = gl::count_t{ 0u };
+    auto       insert_time            = std::chrono::duration<gl::float64_t, std::milli>{};
+    for (auto frame = gl::uint32_t{ 0u }; frame < frame_count; ++frame)
+    {
+        for (auto index = gl::uint32_t{ 0u }; index < 4u; ++index)
+        {
+            auto const image      = create_image(frame * 4u + index);
+            auto const start_time = std::chrono::steady_clock::now();
+            auto const id         = texture_atlas.insert(image);
+            insert_time          += std::chrono::steady_clock::now() - start_time;
+
+            if   (id) ids.emplace_back(*id);
+            else      ++rejected;
+        }
+        while (ids.size() > working_set) ids.pop_front();
+
+        //The regions would be written into the instance data of one draw that binds the atlas once
+        for (auto const id : ids)
+        {
+            if (!texture_atlas.contains(id)) continue;
+
+            texture_atlas.touch(id);
+            auto const region = texture_atlas.region(id);
+            static_cast<void>(region);
+        }
+        texture_atlas.advance();
+
+        if ((frame + 1u) % 100u == 0u)
+        {
+            auto const statistics = texture_atlas.statistics();
+            std::println("frame {:>3} | layers {} | images {:>4} | evicted {:>4} | grown {} | rejected {} | occupancy {:5.1f}% | fragmentation {:5.1f}% | insert {:.3f} ms",
+                frame + 1u, statistics.layer_count, statistics.image_count, statistics.evicted_count, statistics.growth_count, rejected,
+                statistics.occupancy * 100.0f, statistics.fragmentation * 100.0f, insert_time.count() / static_cast<gl::float64_t>((frame + 1u) * 4u));
+        }
+    }
+}
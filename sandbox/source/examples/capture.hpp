@@ -0,0 +1,53 @@
+#pragma once
+
+import std;
+import chroma_gl;
+import rgfw;
+
+static inline void capture()
+{
+    //Window creation
+    auto const window_dimensions      = rgfw::vector_2u{ 1280u, 720u };
+    auto const window_flags           = rgfw::window::flags_e::center | rgfw::window::flags_e::scale_to_monitor;
+    auto       window                 = rgfw::window{ "capture", window_dimensions, window_flags };
+
+    //Every frame is read back, every 60th completed frame is written to disk by the encoder thread
+    auto const capture_directory      = std::filesystem::path{ "capture" };
+    auto       readback_queue         = gl::readback_queue{ 128u * 1024u * 1024u, 3u };
+    auto       render_thread_time     = std::chrono::duration<gl::float64_t, std::milli>{};
+    auto       frame                  = gl::uint64_t{ 0u };
+    std::filesystem::create_directories(capture_directory);
+
+    //Render loop
+    while (window)
+    {
+        window.process_events();
+
+        auto const time       = static_cast<gl::float32_t>(frame) / 60.0f;
+        auto const dimensions = window.dimensions();
+        gl::viewport   (dimensions);
+        gl::clear_color(gl::vector_4f{ 0.5f + 0.5f * std::sin(time), 0.5f + 0.5f * std::sin(time + 2.0f), 0.5f + 0.5f * std::sin(time + 4.0f), 1.0f });
+        gl::clear      (gl::buffer_mask_e::all);
+
+        //Neither call waits for the GPU, the time spent here is what the capture costs the render thread
+        auto const start_time = std::chrono::steady_clock::now();
+        readback_queue.read_pixels(gl::rectangle{ gl::vector_2u{ dimensions.x, dimensions.y } });
+        readback_queue.poll([&](gl::readback const& readback)
+            {
+                if (readback.id % 60u == 0u) readback_queue.encode(readback, capture_directory / std::format("frame_{:06}.png", readback.id));
+            });
+        readback_queue.advance();
+        render_thread_time   += std::chrono::steady_clock::now() - start_time;
+
+        if (++frame % 120u == 0u)
+        {
+            auto const statistics = readback_queue.statistics();
+            std::println("in flight {} | encoding {} | completed {} | dropped {} | latency {:.2f} frames, {:.2f} ms average, {:.2f} ms maximum | render thread {:.3f} ms/frame",
+                statistics.in_flight, statistics.encoding, statistics.completed, statistics.dropped, statistics.average_frame_latency,
+                std::chrono::duration<gl::float64_t, std::milli>{ statistics.average_latency }.count(), std::chrono::duration<gl::float64_t, std::milli>{ statistics.maximum_latency }.count(),
+                render_thread_time.count() / static_cast<gl::float64_t>(frame));
+        }
+
+        window.swap_buffers();
+    }
+}
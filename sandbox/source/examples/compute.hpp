@@ -32,7 +32,7 @@ static inline void compute()
     //Bindings and data upload
     pipeline     .bind ();
     input_buffer .bind (gl::binding_t{ 0u });
-    output_buffer.bind (gl::binding_t{ 1u });
+    output_buffer.bind (gl::binding_t{ 1u }, gl::image_access_e::write_only);
     input_buffer .upload(input_data);
     
     //Dispatch and CPU synchronization
@@ -0,0 +1,68 @@
+#pragma once
+
+import std;
+import chroma_gl;
+import rgfw;
+
+static inline void trace()
+{
+    if constexpr (!gl::trace::is_enabled) std::println("tracing is disabled, generate the solution with -t to record counters");
+
+    //Window creation, the trace layer wraps the functions glad loaded for this context
+    auto const window_dimensions      = rgfw::vector_2u{ 1280u, 720u };
+    auto const window_flags           = rgfw::window::flags_e::center | rgfw::window::flags_e::scale_to_monitor;
+    auto       window                 = rgfw::window{ "trace", window_dimensions, window_flags };
+    gl::trace::install();
+
+    //Vertex data
+    auto const vertex_data            = std::vector<gl::vector_3f>{ gl::vertex::triangle::positions.begin(), gl::vertex::triangle::positions.end() };
+    auto const index_data             = gl::vertex::triangle::indices;
+    auto       vertex_array           = gl::vertex_array{};
+    auto       vertex_buffer          = gl::vertex_buffer<gl::vector_3f>{ vertex_data };
+    auto       index_buffer           = gl::index_buffer                { index_data  };
+    vertex_array.attach<gl::separate_layout<gl::vertex_attribute<gl::vector_3f>>>(vertex_buffer);
+    vertex_array.attach                                                          (index_buffer );
+
+    //Shader setup
+    auto pipeline                     = gl::create_pipeline_from_files(
+        { 
+            { gl::shader::type_e::vertex  , "assets/shaders/compiled/triangle.vert.spv" }, 
+            { gl::shader::type_e::fragment, "assets/shaders/compiled/triangle.frag.spv" }, 
+        });
+
+
+
+    //Render loop, the counters of every 120th frame are printed and frame 60 is captured
+    auto capture                      = std::vector<gl::byte_t>{};
+    for (auto frame = gl::uint32_t{ 0u }; window; ++frame)
+    {
+        window.process_events();
+        if (frame == 60u) gl::trace::begin_capture();
+
+        gl::viewport   (window.dimensions()    );
+        gl::clear_color(gl::color::white * 0.1f);
+        gl::clear      (gl::buffer_mask_e::all );
+        
+        pipeline    .bind();
+        vertex_array.bind();
+        gl::draw_elements(gl::draw_mode_e::triangles, gl::draw_type_e::uint32, vertex_array.index_count(), gl::index_t{ 0u });
+
+        window.swap_buffers();
+        gl::trace::advance();
+
+        if (frame == 60u       ) capture = gl::trace::end_capture();
+        if (frame % 120u == 0u) std::println("frame {}: {}", frame, gl::trace::to_json(gl::trace::last_frame()));
+    }
+    std::println("total: {}", gl::trace::to_json(gl::trace::total()));
+
+    //Replaying the captured frame against the null backend measures the cost of decoding the capture and of the trace hooks
+    //The opengl functions are not part of a replay, "benchmarks --backend null" measures their cost without the driver
+    if (capture.empty()) return;
+
+    gl::trace::load_null_backend();
+    auto const replay_count           = gl::count_t{ 10000u };
+    auto const start_time             = std::chrono::steady_clock::now();
+    for (auto index = gl::index_t{ 0u }; index < replay_count; ++index) gl::trace::replay(capture);
+    auto const replay_time            = std::chrono::duration<gl::float64_t, std::micro>{ std::chrono::steady_clock::now() - start_time };
+    std::println("replayed a {} byte capture in {:.3f} us per frame, excluding the opengl functions", capture.size(), replay_time.count() / static_cast<gl::float64_t>(replay_count));
+}
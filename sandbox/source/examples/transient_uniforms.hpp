@@ -0,0 +1,112 @@
+#pragma once
+
+import std;
+import chroma_gl;
+import rgfw;
+import glm;
+
+static inline void transient_uniforms()
+{
+    //Window creation
+    auto const window_dimensions      = rgfw::vector_2u{ 1280u, 720u };
+    auto const window_flags           = rgfw::window::flags_e::center | rgfw::window::flags_e::scale_to_monitor;
+    auto       window                 = rgfw::window{ "transient_uniforms", window_dimensions, window_flags };
+    auto       input                  = window.input_handler();
+
+    //Vertex data
+    auto const vertex_data            = std::vector<gl::float32_t>
+    {
+        -0.05f, -0.05f, 0.00f,
+         0.05f, -0.05f, 0.00f,
+         0.00f,  0.05f, 0.00f,
+    };
+
+    //Buffers and layouts
+    auto       vertex_array           = gl::vertex_array{};
+    auto       vertex_buffer          = gl::vertex_buffer<gl::float32_t>{ vertex_data };
+    using      position_attribute     = gl::vertex_attribute<gl::vector_3f>;
+    using      triangle_layout        = gl::vertex_layout<position_attribute>;
+    vertex_array.attach<triangle_layout>(vertex_buffer);
+
+    //Uniform data
+    struct mvp
+    {
+        gl::matrix_4f model;
+        gl::matrix_4f view;
+        gl::matrix_4f projection;
+    };
+    auto const draw_count             = 10000u;
+    auto const aspect_ratio           = static_cast<gl::float32_t>(window_dimensions.x) / window_dimensions.y;
+    auto const view                   = glm::lookAt(gl::vector_3f{ 0.0f, 0.0f, 10.0f }, gl::vector_3f{ 0.0f }, gl::vector_3f{ 0.0f, 1.0f, 0.0f });
+    auto const projection             = gl::projection::perspective(glm::radians(45.0f), aspect_ratio, 0.1f, 100.0f);
+
+    //One uniform buffer per draw is mapped and unmapped on every upload, the transient buffer bump-allocates from persistently mapped memory
+    auto       uniform_buffers        = std::vector<gl::uniform_buffer<mvp>>{};
+    auto       transient_buffer       = gl::transient_buffer{ draw_count * gl::align_up(sizeof(mvp), gl::size_t{ 256u }) };
+    uniform_buffers.reserve(draw_count);
+    for (auto index = 0u; index < draw_count; ++index) uniform_buffers.emplace_back(gl::count_t{ 1u });
+
+    //Shader setup
+    auto       pipeline               = gl::create_pipeline_from_files(
+        {
+            { gl::shader::type_e::vertex  , "assets/shaders/compiled/cube.vert.spv" },
+            { gl::shader::type_e::fragment, "assets/shaders/compiled/cube.frag.spv" },
+        });
+
+    //Timing
+    auto       use_transient          = gl::true_;
+    auto       frame_count            = 0u;
+    auto       frame_time             = std::chrono::duration<gl::float64_t, std::milli>{};
+
+
+
+    //Render loop
+    while (window)
+    {
+        window.process_events();
+        if (input->key_active(rgfw::key_e::t))
+        {
+            use_transient = !use_transient;
+            frame_count   = 0u;
+            frame_time    = {};
+        }
+
+        gl::viewport   (window.dimensions()    );
+        gl::clear_color(gl::color::white * 0.1f);
+        gl::clear      (gl::buffer_mask_e::all );
+
+        pipeline    .bind();
+        vertex_array.bind();
+
+        auto const time_before = std::chrono::steady_clock::now();
+        for (auto index = 0u; index < draw_count; ++index)
+        {
+            auto const position = gl::vector_3f{ static_cast<gl::float32_t>(index % 100u) / 10.0f - 5.0f, static_cast<gl::float32_t>(index / 100u) / 25.0f - 2.0f, 0.0f };
+            auto const matrices = mvp{ glm::translate(gl::matrix_4f{ 1.0f }, position), view, projection };
+
+            if (use_transient)
+            {
+                auto const range = transient_buffer.push(gl::buffer_base_target_e::uniform_buffer, matrices);
+                transient_buffer.bind(gl::buffer_base_target_e::uniform_buffer, gl::binding_t{ 0u }, range);
+            }
+            else
+            {
+                uniform_buffers[index].upload(matrices);
+                uniform_buffers[index].bind  (gl::binding_t{ 0u });
+            }
+
+            gl::draw_arrays(gl::draw_mode_e::triangles, gl::index_range{ 3u });
+        }
+        if (use_transient) transient_buffer.next_frame();
+        frame_time += std::chrono::steady_clock::now() - time_before;
+
+        if (++frame_count == 100u)
+        {
+            std::println("{}: {:.3f} ms per frame", use_transient ? "transient_buffer" : "uniform_buffer", frame_time.count() / frame_count);
+            frame_count = 0u;
+            frame_time  = {};
+        }
+
+        window.swap_buffers();
+    }
+}
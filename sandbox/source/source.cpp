@@ -1,12 +1,16 @@
 import std;
 import chroma_gl;
 
+#include "examples/atlas.hpp"
+#include "examples/capture.hpp"
 #include "examples/compute.hpp"
 #include "examples/cube.hpp"
 #include "examples/frame_buffer.hpp"
 #include "examples/instance_id.hpp"
 #include "examples/instanced.hpp"
 #include "examples/texture.hpp"
+#include "examples/trace.hpp"
+#include "examples/transient_uniforms.hpp"
 #include "examples/triangle.hpp"
 
 auto main() -> int